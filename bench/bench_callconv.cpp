@@ -0,0 +1,645 @@
+#include "shared_bench_lib.hpp"
+#include <cassert>
+#include <string>
+#include <string_view>
+#include <type_traits>
+#include <utility>
+
+// Systematic benchmark for the thunks generated by asbind20.
+// Every calling convention is measured with the native registration and the generic wrapper,
+// sweeping the arity from 0 to 8 and the kind of arguments.
+//
+// Benchmarks are named as "callconv/<convention>/<native|generic>/<kind>/<arity>".
+// Use the "compare.py" script in this directory to compare the results with a baseline.
+
+namespace bench_callconv
+{
+// Calls per iteration. The loop is in script for reducing the overhead of preparing context.
+static constexpr int calls_per_iteration = 64;
+
+static constexpr std::size_t max_arity = 8;
+
+struct bench_val
+{
+    int value;
+};
+
+struct bench_ref
+{
+    int value = 1;
+};
+
+// Arguments
+
+struct kind_prim
+{
+    static constexpr std::string_view name = "prim";
+    static constexpr std::string_view decl = "int";
+    static constexpr std::string_view arg = "i";
+    static constexpr std::size_t width = 1;
+
+    template <std::size_t>
+    using param_type = int;
+
+    static int get(int val) noexcept
+    {
+        return val;
+    }
+};
+
+struct kind_ref
+{
+    static constexpr std::string_view name = "ref";
+    static constexpr std::string_view decl = "const int&in";
+    static constexpr std::string_view arg = "i";
+    static constexpr std::size_t width = 1;
+
+    template <std::size_t>
+    using param_type = const int&;
+
+    static int get(const int& val) noexcept
+    {
+        return val;
+    }
+};
+
+struct kind_value
+{
+    static constexpr std::string_view name = "value";
+    static constexpr std::string_view decl = "const bench_val&in";
+    static constexpr std::string_view arg = "v";
+    static constexpr std::size_t width = 1;
+
+    template <std::size_t>
+    using param_type = const bench_val&;
+
+    static int get(const bench_val& val) noexcept
+    {
+        return val.value;
+    }
+};
+
+struct kind_handle
+{
+    static constexpr std::string_view name = "handle";
+    static constexpr std::string_view decl = "bench_ref@";
+    static constexpr std::string_view arg = "g_ref";
+    static constexpr std::size_t width = 1;
+
+    template <std::size_t>
+    using param_type = bench_ref*;
+
+    static int get(bench_ref* val) noexcept
+    {
+        return val->value;
+    }
+};
+
+// A variable type argument (?) is received by a pair of void* and int in C++
+struct kind_var
+{
+    static constexpr std::string_view name = "var";
+    static constexpr std::string_view decl = "const ?&in";
+    static constexpr std::string_view arg = "i";
+    static constexpr std::size_t width = 2;
+
+    template <std::size_t I>
+    using param_type = std::conditional_t<I % 2 == 0, void*, int>;
+
+    static int get(void* ref) noexcept
+    {
+        return *static_cast<const int*>(ref);
+    }
+
+    static int get(int type_id) noexcept
+    {
+        return type_id == AS_NAMESPACE_QUALIFIER asTYPEID_INT32 ? 0 : 1;
+    }
+};
+
+// Callees
+
+template <typename Kind, std::size_t... Is>
+static int global_fn(typename Kind::template param_type<Is>... args)
+{
+    return (0 + ... + Kind::get(args));
+}
+
+class bench_comp
+{
+public:
+    int value = 1;
+
+    template <typename Kind, std::size_t... Is>
+    int call(typename Kind::template param_type<Is>... args)
+    {
+        return value + (0 + ... + Kind::get(args));
+    }
+};
+
+class bench_obj
+{
+public:
+    int value = 1;
+
+    bench_comp comp;
+    bench_comp* const indirect = &comp;
+
+    template <typename Kind, std::size_t... Is>
+    int call(typename Kind::template param_type<Is>... args)
+    {
+        return value + (0 + ... + Kind::get(args));
+    }
+};
+
+template <typename Kind, std::size_t... Is>
+static int objfirst_fn(bench_obj& this_, typename Kind::template param_type<Is>... args)
+{
+    return this_.value + (0 + ... + Kind::get(args));
+}
+
+template <typename Kind, std::size_t... Is>
+static int objlast_fn(typename Kind::template param_type<Is>... args, bench_obj& this_)
+{
+    return this_.value + (0 + ... + Kind::get(args));
+}
+
+class bench_aux
+{
+public:
+    int value = 1;
+
+    template <typename Kind, std::size_t... Is>
+    int global_call(typename Kind::template param_type<Is>... args)
+    {
+        return value + (0 + ... + Kind::get(args));
+    }
+
+    template <typename Kind, std::size_t... Is>
+    int objfirst_call(bench_obj& this_, typename Kind::template param_type<Is>... args)
+    {
+        return value + this_.value + (0 + ... + Kind::get(args));
+    }
+
+    template <typename Kind, std::size_t... Is>
+    int objlast_call(typename Kind::template param_type<Is>... args, bench_obj& this_)
+    {
+        return value + this_.value + (0 + ... + Kind::get(args));
+    }
+};
+
+static bench_obj g_obj;
+static bench_ref g_ref;
+static bench_aux g_aux;
+
+// Calling conventions
+//
+// The setup() registers a function or method named "f" by the declaration.
+// Generic wrappers are generated by the same utility used by the binding generators,
+// so the overhead of binding generators themselves is excluded.
+
+using asbind20::var_type_t;
+
+template <typename Kind, std::size_t... Is>
+using var_for = std::conditional_t<
+    std::is_same_v<Kind, kind_var>,
+    var_type_t<Is...>,
+    var_type_t<>>;
+
+struct conv_cdecl
+{
+    static constexpr std::string_view name = "cdecl";
+    static constexpr bool is_method = false;
+
+    template <bool UseGeneric, typename Kind, std::size_t... Is, std::size_t... Vs>
+    static void setup(
+        AS_NAMESPACE_QUALIFIER asIScriptEngine* engine,
+        const char* decl,
+        std::index_sequence<Is...>,
+        var_type_t<Vs...> vt
+    )
+    {
+        using namespace asbind20;
+
+        constexpr auto fn = &global_fn<Kind, Is...>;
+        if constexpr(UseGeneric)
+        {
+            global(engine).function(
+                decl,
+                detail::to_asGENFUNC_t(fp<fn>, detail::cc<AS_NAMESPACE_QUALIFIER asCALL_CDECL>, vt)
+            );
+        }
+        else
+            global(engine).function(decl, fp<fn>);
+    }
+};
+
+struct conv_thiscall
+{
+    static constexpr std::string_view name = "thiscall";
+    static constexpr bool is_method = true;
+
+    template <bool UseGeneric, typename Kind, std::size_t... Is, std::size_t... Vs>
+    static void setup(
+        AS_NAMESPACE_QUALIFIER asIScriptEngine* engine,
+        const char* decl,
+        std::index_sequence<Is...>,
+        var_type_t<Vs...> vt
+    )
+    {
+        using namespace asbind20;
+
+        constexpr auto fn = &bench_obj::template call<Kind, Is...>;
+        ref_class<bench_obj> c(appending, engine, "bench_obj");
+        if constexpr(UseGeneric)
+        {
+            c.method(
+                decl,
+                detail::to_asGENFUNC_t(fp<fn>, detail::cc<AS_NAMESPACE_QUALIFIER asCALL_THISCALL>, vt)
+            );
+        }
+        else
+            c.method(decl, fp<fn>);
+    }
+};
+
+struct conv_objfirst
+{
+    static constexpr std::string_view name = "objfirst";
+    static constexpr bool is_method = true;
+
+    template <bool UseGeneric, typename Kind, std::size_t... Is, std::size_t... Vs>
+    static void setup(
+        AS_NAMESPACE_QUALIFIER asIScriptEngine* engine,
+        const char* decl,
+        std::index_sequence<Is...>,
+        var_type_t<Vs...> vt
+    )
+    {
+        using namespace asbind20;
+
+        constexpr auto fn = &objfirst_fn<Kind, Is...>;
+        ref_class<bench_obj> c(appending, engine, "bench_obj");
+        if constexpr(UseGeneric)
+        {
+            c.method(
+                decl,
+                detail::to_asGENFUNC_t(fp<fn>, detail::cc<AS_NAMESPACE_QUALIFIER asCALL_CDECL_OBJFIRST>, vt)
+            );
+        }
+        else
+            c.method(decl, fn, objfirst);
+    }
+};
+
+struct conv_objlast
+{
+    static constexpr std::string_view name = "objlast";
+    static constexpr bool is_method = true;
+
+    template <bool UseGeneric, typename Kind, std::size_t... Is, std::size_t... Vs>
+    static void setup(
+        AS_NAMESPACE_QUALIFIER asIScriptEngine* engine,
+        const char* decl,
+        std::index_sequence<Is...>,
+        var_type_t<Vs...> vt
+    )
+    {
+        using namespace asbind20;
+
+        constexpr auto fn = &objlast_fn<Kind, Is...>;
+        ref_class<bench_obj> c(appending, engine, "bench_obj");
+        if constexpr(UseGeneric)
+        {
+            c.method(
+                decl,
+                detail::to_asGENFUNC_t(fp<fn>, detail::cc<AS_NAMESPACE_QUALIFIER asCALL_CDECL_OBJLAST>, vt)
+            );
+        }
+        else
+            c.method(decl, fn, objlast);
+    }
+};
+
+struct conv_composite
+{
+    static constexpr std::string_view name = "composite";
+    static constexpr bool is_method = true;
+
+    template <bool UseGeneric, typename Kind, std::size_t... Is, std::size_t... Vs>
+    static void setup(
+        AS_NAMESPACE_QUALIFIER asIScriptEngine* engine,
+        const char* decl,
+        std::index_sequence<Is...>,
+        var_type_t<Vs...> vt
+    )
+    {
+        using namespace asbind20;
+
+        constexpr auto fn = &bench_comp::template call<Kind, Is...>;
+        ref_class<bench_obj> c(appending, engine, "bench_obj");
+        if constexpr(UseGeneric)
+        {
+            c.method(
+                decl,
+                detail::to_asGENFUNC_t(
+                    fp<fn>,
+                    detail::cc<AS_NAMESPACE_QUALIFIER asCALL_THISCALL>,
+                    composite<&bench_obj::indirect>(),
+                    vt
+                )
+            );
+        }
+        else
+            c.method(decl, fn, composite(&bench_obj::indirect));
+    }
+};
+
+struct conv_thiscall_asglobal
+{
+    static constexpr std::string_view name = "thiscall_asglobal";
+    static constexpr bool is_method = false;
+
+    template <bool UseGeneric, typename Kind, std::size_t... Is, std::size_t... Vs>
+    static void setup(
+        AS_NAMESPACE_QUALIFIER asIScriptEngine* engine,
+        const char* decl,
+        std::index_sequence<Is...>,
+        var_type_t<Vs...> vt
+    )
+    {
+        using namespace asbind20;
+
+        constexpr auto fn = &bench_aux::template global_call<Kind, Is...>;
+        if constexpr(UseGeneric)
+        {
+            global(engine).function(
+                decl,
+                detail::to_asGENFUNC_t(fp<fn>, detail::cc<AS_NAMESPACE_QUALIFIER asCALL_THISCALL_ASGLOBAL>, vt),
+                auxiliary(g_aux)
+            );
+        }
+        else
+            global(engine).function(decl, fp<fn>, auxiliary(g_aux));
+    }
+};
+
+struct conv_thiscall_objfirst
+{
+    static constexpr std::string_view name = "thiscall_objfirst";
+    static constexpr bool is_method = true;
+
+    template <bool UseGeneric, typename Kind, std::size_t... Is, std::size_t... Vs>
+    static void setup(
+        AS_NAMESPACE_QUALIFIER asIScriptEngine* engine,
+        const char* decl,
+        std::index_sequence<Is...>,
+        var_type_t<Vs...> vt
+    )
+    {
+        using namespace asbind20;
+
+        constexpr auto fn = &bench_aux::template objfirst_call<Kind, Is...>;
+        ref_class<bench_obj> c(appending, engine, "bench_obj");
+        if constexpr(UseGeneric)
+        {
+            c.method(
+                decl,
+                detail::to_asGENFUNC_t(fp<fn>, detail::cc<AS_NAMESPACE_QUALIFIER asCALL_THISCALL_OBJFIRST>, vt),
+                auxiliary(g_aux)
+            );
+        }
+        else
+            c.method(decl, fp<fn>, auxiliary(g_aux), objfirst);
+    }
+};
+
+struct conv_thiscall_objlast
+{
+    static constexpr std::string_view name = "thiscall_objlast";
+    static constexpr bool is_method = true;
+
+    template <bool UseGeneric, typename Kind, std::size_t... Is, std::size_t... Vs>
+    static void setup(
+        AS_NAMESPACE_QUALIFIER asIScriptEngine* engine,
+        const char* decl,
+        std::index_sequence<Is...>,
+        var_type_t<Vs...> vt
+    )
+    {
+        using namespace asbind20;
+
+        constexpr auto fn = &bench_aux::template objlast_call<Kind, Is...>;
+        ref_class<bench_obj> c(appending, engine, "bench_obj");
+        if constexpr(UseGeneric)
+        {
+            c.method(
+                decl,
+                detail::to_asGENFUNC_t(fp<fn>, detail::cc<AS_NAMESPACE_QUALIFIER asCALL_THISCALL_OBJLAST>, vt),
+                auxiliary(g_aux)
+            );
+        }
+        else
+            c.method(decl, fp<fn>, auxiliary(g_aux), objlast);
+    }
+};
+
+// Environment
+
+static void register_env(AS_NAMESPACE_QUALIFIER asIScriptEngine* engine)
+{
+    using namespace asbind20;
+
+    value_class<bench_val>(
+        engine,
+        "bench_val",
+        AS_NAMESPACE_QUALIFIER asOBJ_POD | AS_NAMESPACE_QUALIFIER asOBJ_APP_CLASS_ALLINTS
+    )
+        .property("int value", &bench_val::value);
+
+    ref_class<bench_ref>(engine, "bench_ref", AS_NAMESPACE_QUALIFIER asOBJ_NOCOUNT);
+    ref_class<bench_obj>(engine, "bench_obj", AS_NAMESPACE_QUALIFIER asOBJ_NOCOUNT);
+
+    global(engine)
+        .property("bench_ref g_ref", g_ref)
+        .property("bench_obj g_obj", g_obj);
+}
+
+template <typename Kind>
+static std::string make_decl(std::size_t arity)
+{
+    std::string result = "int f(";
+    for(std::size_t i = 0; i < arity; ++i)
+    {
+        if(i != 0)
+            result += ", ";
+        result += Kind::decl;
+    }
+    result += ')';
+
+    return result;
+}
+
+template <typename Kind>
+static std::string make_script(bool is_method, std::size_t arity)
+{
+    std::string result =
+        "int run()\n"
+        "{\n"
+        "    bench_val v;\n"
+        "    v.value = 1;\n"
+        "    int sum = 0;\n"
+        "    for(int i = 0; i < ";
+    result += std::to_string(calls_per_iteration);
+    result += "; ++i)\n        sum += ";
+    result += is_method ? "g_obj.f(" : "f(";
+    for(std::size_t i = 0; i < arity; ++i)
+    {
+        if(i != 0)
+            result += ", ";
+        result += Kind::arg;
+    }
+    result +=
+        ");\n"
+        "    return sum;\n"
+        "}";
+
+    return result;
+}
+
+using setup_function = void (*)(AS_NAMESPACE_QUALIFIER asIScriptEngine*, const char*);
+
+static void run_case(
+    benchmark::State& state,
+    setup_function setup,
+    const std::string& decl,
+    const std::string& script
+)
+{
+    using namespace asbind20;
+
+    auto engine = make_script_engine();
+    register_env(engine);
+    setup(engine, decl.c_str());
+
+    auto* m = engine->GetModule(
+        "bench_callconv", AS_NAMESPACE_QUALIFIER asGM_ALWAYS_CREATE
+    );
+    m->AddScriptSection("bench_callconv", script.c_str());
+
+    if(m->Build() < 0)
+    {
+        state.SkipWithError("failed to build script for \"" + decl + '"');
+        return;
+    }
+
+    script_function<int()> run(m->GetFunctionByName("run"));
+    assert(run);
+
+    request_context ctx(engine);
+    for(auto&& _ : state)
+    {
+        auto result = run(ctx);
+        assert(result.has_value());
+        benchmark::DoNotOptimize(result.value());
+    }
+
+    // Average time of a single call
+    state.counters["per_call"] = benchmark::Counter(
+        static_cast<double>(state.iterations()) * calls_per_iteration,
+        benchmark::Counter::kIsRate | benchmark::Counter::kInvert
+    );
+}
+
+template <typename Conv, bool UseGeneric, typename Kind, std::size_t Arity>
+static void register_case()
+{
+    std::string name = "callconv/";
+    name += Conv::name;
+    name += UseGeneric ? "/generic/" : "/native/";
+    name += Kind::name;
+    name += '/';
+    name += std::to_string(Arity);
+
+    benchmark::RegisterBenchmark(
+        name,
+        [](benchmark::State& state)
+        {
+            setup_function setup = [](AS_NAMESPACE_QUALIFIER asIScriptEngine* engine, const char* decl)
+            {
+                Conv::template setup<UseGeneric, Kind>(
+                    engine,
+                    decl,
+                    std::make_index_sequence<Arity * Kind::width>{},
+                    []<std::size_t... Vs>(std::index_sequence<Vs...>)
+                    {
+                        return var_for<Kind, Vs...>{};
+                    }(std::make_index_sequence<Arity>{})
+                );
+            };
+
+            run_case(
+                state,
+                setup,
+                make_decl<Kind>(Arity),
+                make_script<Kind>(Conv::is_method, Arity)
+            );
+        }
+    );
+}
+
+template <typename Conv, bool UseGeneric, typename Kind>
+static void register_arity_sweep()
+{
+    []<std::size_t... Arities>(std::index_sequence<Arities...>)
+    {
+        (register_case<Conv, UseGeneric, Kind, Arities>(), ...);
+    }(std::make_index_sequence<max_arity + 1>{});
+}
+
+template <typename Conv, bool UseGeneric>
+static void register_kinds()
+{
+    register_arity_sweep<Conv, UseGeneric, kind_prim>();
+    register_arity_sweep<Conv, UseGeneric, kind_ref>();
+    register_arity_sweep<Conv, UseGeneric, kind_value>();
+    register_arity_sweep<Conv, UseGeneric, kind_handle>();
+    register_arity_sweep<Conv, UseGeneric, kind_var>();
+}
+
+template <typename Conv>
+static void register_conv(bool native)
+{
+    if(native)
+        register_kinds<Conv, false>();
+    register_kinds<Conv, true>();
+}
+} // namespace bench_callconv
+
+int main(int argc, char** argv)
+{
+    using namespace bench_callconv;
+
+#ifdef ASBIND_BENCH_NO_NATIVE
+    const bool native = false;
+#else
+    const bool native = !asbind20::has_max_portability();
+#endif
+
+    register_conv<conv_cdecl>(native);
+    register_conv<conv_thiscall>(native);
+    register_conv<conv_objfirst>(native);
+    register_conv<conv_objlast>(native);
+    register_conv<conv_composite>(native);
+    register_conv<conv_thiscall_asglobal>(native);
+    register_conv<conv_thiscall_objfirst>(native);
+    register_conv<conv_thiscall_objlast>(native);
+
+    benchmark::Initialize(&argc, argv);
+    if(benchmark::ReportUnrecognizedArguments(argc, argv))
+        return 1;
+    benchmark::RunSpecifiedBenchmarks();
+    benchmark::Shutdown();
+
+    return 0;
+}
@@ -1,6 +1,7 @@
 #include "shared_bench_lib.hpp"
 #include <sstream>
 #include <asbind20/io/stream.hpp>
+#include <asbind20/io/compression.hpp>
 
 namespace bench_io
 {
@@ -83,8 +84,43 @@ static void save_byte_code_output_it_stripped(benchmark::State& state)
     }
 }
 
+static void save_byte_code_sstream_unbuffered(benchmark::State& state)
+{
+    using namespace asbind20;
+
+    auto engine = make_script_engine();
+    auto* m = bench_io::prepare_module(engine);
+
+    for(auto&& _ : state)
+    {
+        std::stringstream ss;
+        io::ostream_wrapper wrapper(ss);
+        [[maybe_unused]]
+        int r = m->SaveByteCode(&wrapper);
+        assert(r >= 0);
+    }
+}
+
+static void save_byte_code_sstream_compressed(benchmark::State& state)
+{
+    using namespace asbind20;
+
+    auto engine = make_script_engine();
+    auto* m = bench_io::prepare_module(engine);
+
+    for(auto&& _ : state)
+    {
+        std::stringstream ss;
+        [[maybe_unused]]
+        int r = save_byte_code_compressed(ss, m);
+        assert(r >= 0);
+    }
+}
+
 BENCHMARK(save_byte_code_sstream);
 BENCHMARK(save_byte_code_sstream_stripped);
+BENCHMARK(save_byte_code_sstream_unbuffered);
+BENCHMARK(save_byte_code_sstream_compressed);
 BENCHMARK(save_byte_code_output_it);
 BENCHMARK(save_byte_code_output_it_stripped);
 
@@ -195,8 +231,67 @@ static void load_byte_code_mem_stripped(benchmark::State& state)
     }
 }
 
+static void load_byte_code_sstream_buffered(benchmark::State& state)
+{
+    using namespace asbind20;
+
+    const std::string s = []()
+    {
+        std::stringstream buf;
+        bench_io::prepare_byte_code(buf);
+        return std::move(buf).str();
+    }();
+
+    auto engine = make_script_engine();
+
+    for(auto&& _ : state)
+    {
+        auto* m = engine->GetModule(
+            "test", AS_NAMESPACE_QUALIFIER asGM_ALWAYS_CREATE
+        );
+        std::stringstream ss(s);
+        io::buffered_istream_wrapper wrapper(ss);
+        [[maybe_unused]]
+        int r = m->LoadByteCode(&wrapper);
+        assert(r >= 0);
+    }
+}
+
+static void load_byte_code_sstream_compressed(benchmark::State& state)
+{
+    using namespace asbind20;
+
+    const std::string s = []()
+    {
+        // temp engine
+        auto engine = asbind20::make_script_engine();
+        auto* m = bench_io::prepare_module(engine);
+
+        std::stringstream buf;
+        [[maybe_unused]]
+        int r = save_byte_code_compressed(buf, m);
+        assert(r >= 0);
+        return std::move(buf).str();
+    }();
+
+    auto engine = make_script_engine();
+
+    for(auto&& _ : state)
+    {
+        auto* m = engine->GetModule(
+            "test", AS_NAMESPACE_QUALIFIER asGM_ALWAYS_CREATE
+        );
+        std::stringstream ss(s);
+        [[maybe_unused]]
+        auto result = load_byte_code_compressed(ss, m);
+        assert(result);
+    }
+}
+
 BENCHMARK(load_byte_code_sstream);
 BENCHMARK(load_byte_code_sstream_stripped);
+BENCHMARK(load_byte_code_sstream_buffered);
+BENCHMARK(load_byte_code_sstream_compressed);
 BENCHMARK(load_byte_code_mem);
 BENCHMARK(load_byte_code_mem_stripped);
 
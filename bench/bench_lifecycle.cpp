@@ -0,0 +1,357 @@
+#include "shared_bench_lib.hpp"
+#include <cassert>
+#include <initializer_list>
+#include <span>
+#include <string>
+
+// Benchmark for the lifecycle of registered objects:
+// a. Constructors and behaviours of value types registered by behaviours_by_traits()
+// b. Factories of reference types, with or without notifying the GC
+// c. List factories under each initialization list policy
+// d. AddRef/Release of handles using asbind20::atomic_counter or a plain counter
+//
+// Benchmarks are named as "lifecycle/<case>/<native|generic>".
+
+namespace bench_lifecycle
+{
+// Objects per iteration. The loop is in script for reducing the overhead of preparing context.
+static constexpr int objects_per_iteration = 64;
+
+class bench_val
+{
+public:
+    bench_val()
+        : value(0) {}
+
+    bench_val(int val)
+        : value(val) {}
+
+    bench_val(const bench_val& other)
+        : value(other.value) {}
+
+    ~bench_val() {}
+
+    bench_val& operator=(const bench_val& rhs)
+    {
+        value = rhs.value;
+        return *this;
+    }
+
+    int value;
+};
+
+class bench_ref
+{
+public:
+    bench_ref() = default;
+
+    bench_ref(int val)
+        : value(val) {}
+
+    void addref()
+    {
+        ++m_counter;
+    }
+
+    void release()
+    {
+        m_counter.dec_and_try_delete(this);
+    }
+
+    int value = 0;
+
+private:
+    asbind20::atomic_counter m_counter;
+};
+
+// Same as bench_ref but using a non-atomic counter, as the reference for measuring the atomic_counter
+class bench_plain_ref
+{
+public:
+    void addref()
+    {
+        ++m_counter;
+    }
+
+    void release()
+    {
+        if(--m_counter == 0)
+            delete this;
+    }
+
+    int value = 0;
+
+private:
+    int m_counter = 1;
+};
+
+class bench_gc_ref
+{
+public:
+    void addref()
+    {
+        m_gc_flag = false;
+        ++m_counter;
+    }
+
+    void release()
+    {
+        m_gc_flag = false;
+        m_counter.dec_and_try_delete(this);
+    }
+
+    int get_refcount() const
+    {
+        return m_counter;
+    }
+
+    void set_gc_flag()
+    {
+        m_gc_flag = true;
+    }
+
+    bool get_gc_flag() const
+    {
+        return m_gc_flag;
+    }
+
+    // This type holds no reference
+    void enum_refs(AS_NAMESPACE_QUALIFIER asIScriptEngine*) {}
+
+    void release_refs(AS_NAMESPACE_QUALIFIER asIScriptEngine*) {}
+
+private:
+    asbind20::atomic_counter m_counter;
+    bool m_gc_flag = false;
+};
+
+// Constructed from the initialization list by different policies
+class bench_list_ref
+{
+public:
+    // as_span
+    bench_list_ref(std::span<const int> sp)
+    {
+        for(int i : sp)
+            sum += i;
+    }
+
+    // as_iterators
+    bench_list_ref(const int* start, const int* stop)
+    {
+        for(; start != stop; ++start)
+            sum += *start;
+    }
+
+    // pointer_and_size
+    bench_list_ref(const int* ptr, std::size_t size)
+        : bench_list_ref(ptr, ptr + size) {}
+
+    // as_initializer_list
+    bench_list_ref(std::initializer_list<int> il)
+    {
+        for(int i : il)
+            sum += i;
+    }
+
+    // repeat_list_proxy
+    bench_list_ref(asbind20::script_init_list_repeat list)
+    {
+        const int* start = static_cast<const int*>(list.data());
+        for(AS_NAMESPACE_QUALIFIER asUINT i = 0; i < list.size(); ++i)
+            sum += start[i];
+    }
+
+    void addref()
+    {
+        ++m_counter;
+    }
+
+    void release()
+    {
+        m_counter.dec_and_try_delete(this);
+    }
+
+    int sum = 0;
+
+private:
+    asbind20::atomic_counter m_counter;
+};
+
+template <bool UseGeneric, typename IListPolicy>
+static void register_list_ref(AS_NAMESPACE_QUALIFIER asIScriptEngine* engine, const char* name)
+{
+    using namespace asbind20;
+
+    ref_class<bench_list_ref, UseGeneric>(engine, name)
+        .template list_factory<int>("repeat int", use_policy<IListPolicy>)
+        .addref(fp<&bench_list_ref::addref>)
+        .release(fp<&bench_list_ref::release>);
+}
+
+template <bool UseGeneric>
+static void register_env(AS_NAMESPACE_QUALIFIER asIScriptEngine* engine)
+{
+    using namespace asbind20;
+
+    value_class<bench_val, UseGeneric>(engine, "bench_val")
+        .behaviours_by_traits()
+        .template constructor<int>("int");
+
+    ref_class<bench_ref, UseGeneric>(engine, "bench_ref")
+        .default_factory()
+        .template factory<int>("int")
+        .addref(fp<&bench_ref::addref>)
+        .release(fp<&bench_ref::release>);
+
+    ref_class<bench_plain_ref, UseGeneric>(engine, "bench_plain_ref")
+        .default_factory()
+        .addref(fp<&bench_plain_ref::addref>)
+        .release(fp<&bench_plain_ref::release>);
+
+    ref_class<bench_gc_ref, UseGeneric>(engine, "bench_gc_ref", AS_NAMESPACE_QUALIFIER asOBJ_GC)
+        .default_factory(use_policy<policies::notify_gc>)
+        .addref(fp<&bench_gc_ref::addref>)
+        .release(fp<&bench_gc_ref::release>)
+        .get_refcount(fp<&bench_gc_ref::get_refcount>)
+        .set_gc_flag(fp<&bench_gc_ref::set_gc_flag>)
+        .get_gc_flag(fp<&bench_gc_ref::get_gc_flag>)
+        .enum_refs(fp<&bench_gc_ref::enum_refs>)
+        .release_refs(fp<&bench_gc_ref::release_refs>);
+
+    register_list_ref<UseGeneric, policies::as_span>(engine, "list_span");
+    register_list_ref<UseGeneric, policies::as_iterators>(engine, "list_iterators");
+    register_list_ref<UseGeneric, policies::pointer_and_size>(engine, "list_pointer_and_size");
+    register_list_ref<UseGeneric, policies::repeat_list_proxy>(engine, "list_proxy");
+#ifdef ASBIND20_HAS_AS_INITIALIZER_LIST
+    register_list_ref<UseGeneric, policies::as_initializer_list>(engine, "list_initializer_list");
+#endif
+}
+
+using setup_function = void (*)(AS_NAMESPACE_QUALIFIER asIScriptEngine*);
+
+static void run_case(
+    benchmark::State& state,
+    setup_function setup,
+    const std::string& script
+)
+{
+    using namespace asbind20;
+
+    auto engine = make_script_engine();
+    setup(engine);
+
+    auto* m = engine->GetModule(
+        "bench_lifecycle", AS_NAMESPACE_QUALIFIER asGM_ALWAYS_CREATE
+    );
+    m->AddScriptSection("bench_lifecycle", script.c_str());
+
+    if(m->Build() < 0)
+    {
+        state.SkipWithError("failed to build script");
+        return;
+    }
+
+    script_function<void()> run(m->GetFunctionByName("run"));
+    assert(run);
+
+    request_context ctx(engine);
+    for(auto&& _ : state)
+    {
+        BENCHMARK_UNUSED
+        auto result = run(ctx);
+        assert(result.has_value());
+    }
+
+    // Average time of a single object
+    state.counters["per_object"] = benchmark::Counter(
+        static_cast<double>(state.iterations()) * objects_per_iteration,
+        benchmark::Counter::kIsRate | benchmark::Counter::kInvert
+    );
+}
+
+/**
+ * @param name Name of the case
+ * @param prologue Statements before the loop
+ * @param body Statements executed once for every object
+ */
+template <bool UseGeneric>
+static void register_case(std::string_view name, std::string_view prologue, std::string_view body)
+{
+    std::string bench_name = "lifecycle/";
+    bench_name += name;
+    bench_name += UseGeneric ? "/generic" : "/native";
+
+    std::string script = "void run()\n{\n";
+    script += prologue;
+    script += "\n    for(int i = 0; i < ";
+    script += std::to_string(objects_per_iteration);
+    script += "; ++i)\n    {\n";
+    script += body;
+    script += "\n    }\n}";
+
+    benchmark::RegisterBenchmark(
+        bench_name,
+        [script = std::move(script)](benchmark::State& state)
+        {
+            run_case(state, &register_env<UseGeneric>, script);
+        }
+    );
+}
+
+template <bool UseGeneric>
+static void register_cases()
+{
+    // Value types
+    register_case<UseGeneric>("value_default", "", "bench_val v;");
+    register_case<UseGeneric>("value_from_int", "", "bench_val v(i);");
+    register_case<UseGeneric>("value_copy", "bench_val src(1);", "bench_val v(src);");
+    register_case<UseGeneric>("value_assign", "bench_val src(1); bench_val dst;", "dst = src;");
+
+    // Factories
+    register_case<UseGeneric>("ref_factory", "", "bench_ref@ r = bench_ref();");
+    register_case<UseGeneric>("ref_factory_from_int", "", "bench_ref@ r = bench_ref(i);");
+    register_case<UseGeneric>("ref_factory_notify_gc", "", "bench_gc_ref@ r = bench_gc_ref();");
+
+    // List factories
+    static constexpr char list_body[] = " r = {1, 2, 3, 4, 5, 6, 7, 8};";
+    register_case<UseGeneric>("list_factory_as_span", "", std::string("list_span@") + list_body);
+    register_case<UseGeneric>("list_factory_as_iterators", "", std::string("list_iterators@") + list_body);
+    register_case<UseGeneric>("list_factory_pointer_and_size", "", std::string("list_pointer_and_size@") + list_body);
+    register_case<UseGeneric>("list_factory_repeat_list_proxy", "", std::string("list_proxy@") + list_body);
+#ifdef ASBIND20_HAS_AS_INITIALIZER_LIST
+    register_case<UseGeneric>("list_factory_as_initializer_list", "", std::string("list_initializer_list@") + list_body);
+#endif
+
+    // AddRef/Release
+    register_case<UseGeneric>(
+        "addref_release_atomic_counter",
+        "bench_ref@ r = bench_ref(); bench_ref@ h;",
+        "@h = @r; @h = null;"
+    );
+    register_case<UseGeneric>(
+        "addref_release_plain_counter",
+        "bench_plain_ref@ r = bench_plain_ref(); bench_plain_ref@ h;",
+        "@h = @r; @h = null;"
+    );
+}
+} // namespace bench_lifecycle
+
+int main(int argc, char** argv)
+{
+    using namespace bench_lifecycle;
+
+#ifndef ASBIND_BENCH_NO_NATIVE
+    if(!asbind20::has_max_portability())
+        register_cases<false>();
+#endif
+    register_cases<true>();
+
+    benchmark::Initialize(&argc, argv);
+    if(benchmark::ReportUnrecognizedArguments(argc, argv))
+        return 1;
+    benchmark::RunSpecifiedBenchmarks();
+    benchmark::Shutdown();
+
+    return 0;
+}
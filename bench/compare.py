@@ -0,0 +1,146 @@
+#!/usr/bin/env python3
+"""
+Compare results of Google Benchmark with a baseline.
+
+Both files should be generated by the "--benchmark_out=<file> --benchmark_out_format=json" options.
+If the benchmarks are repeated, the median of repetitions is compared.
+
+Example:
+    ./bench_callconv --benchmark_out=result.json --benchmark_out_format=json --benchmark_repetitions=5
+    python compare.py baselines/bench_callconv.json result.json --threshold 10
+
+The exit code is 1 if any benchmark regresses more than the threshold.
+"""
+
+import argparse
+import json
+import re
+import sys
+from statistics import median
+
+# Multipliers for converting time units into nanoseconds
+TIME_UNITS = {
+    "ns": 1.0,
+    "us": 1e3,
+    "ms": 1e6,
+    "s": 1e9,
+}
+
+
+def load_results(path, metric):
+    """
+    Load benchmark results as a dictionary from name to time in nanoseconds.
+    """
+
+    with open(path, "r", encoding="utf-8") as f:
+        data = json.load(f)
+
+    runs = {}
+    medians = {}
+    for bm in data.get("benchmarks", []):
+        if bm.get("error_occurred", False):
+            continue
+
+        name = bm.get("run_name", bm["name"])
+        value = float(bm[metric]) * TIME_UNITS[bm.get("time_unit", "ns")]
+
+        if bm.get("run_type") == "aggregate":
+            if bm.get("aggregate_name") == "median":
+                medians[name] = value
+        else:
+            runs.setdefault(name, []).append(value)
+
+    result = {name: median(values) for name, values in runs.items()}
+    # Prefer the aggregate computed by Google Benchmark
+    result.update(medians)
+    return result
+
+
+def format_time(ns):
+    if ns >= 1e6:
+        return f"{ns / 1e6:.3f} ms"
+    if ns >= 1e3:
+        return f"{ns / 1e3:.3f} us"
+    return f"{ns:.1f} ns"
+
+
+def main():
+    parser = argparse.ArgumentParser(description="Compare results of Google Benchmark with a baseline.")
+    parser.add_argument("baseline", help="JSON output of the baseline")
+    parser.add_argument("current", help="JSON output to be compared")
+    parser.add_argument(
+        "--threshold",
+        type=float,
+        default=10.0,
+        help="Maximum allowed slowdown in percent (default: 10)"
+    )
+    parser.add_argument(
+        "--metric",
+        choices=["real_time", "cpu_time"],
+        default="cpu_time",
+        help="Time to be compared (default: cpu_time)"
+    )
+    parser.add_argument(
+        "--filter",
+        default=None,
+        help="Regular expression for selecting benchmarks by name"
+    )
+    parser.add_argument(
+        "--all",
+        action="store_true",
+        help="Print all benchmarks instead of the changed ones only"
+    )
+    args = parser.parse_args()
+
+    baseline = load_results(args.baseline, args.metric)
+    current = load_results(args.current, args.metric)
+
+    pattern = re.compile(args.filter) if args.filter else None
+
+    def selected(name):
+        return pattern is None or pattern.search(name) is not None
+
+    regressions = []
+    rows = []
+    for name in sorted(baseline.keys() & current.keys()):
+        if not selected(name):
+            continue
+
+        old = baseline[name]
+        new = current[name]
+        change = (new - old) / old * 100.0 if old > 0 else 0.0
+
+        if change > args.threshold:
+            regressions.append(name)
+            status = "REGRESSION"
+        elif change < -args.threshold:
+            status = "improved"
+        else:
+            status = ""
+
+        if args.all or status:
+            rows.append((name, format_time(old), format_time(new), f"{change:+.1f}%", status))
+
+    if rows:
+        header = ("Benchmark", "Baseline", "Current", "Change", "")
+        widths = [max(len(r[i]) for r in rows + [header]) for i in range(len(header))]
+        for r in [header] + rows:
+            print("  ".join(col.ljust(w) for col, w in zip(r, widths)).rstrip())
+
+    missing = sorted(n for n in baseline.keys() - current.keys() if selected(n))
+    added = sorted(n for n in current.keys() - baseline.keys() if selected(n))
+    for name in missing:
+        print(f"Missing from current results: {name}")
+    for name in added:
+        print(f"Not in baseline: {name}")
+
+    if regressions:
+        print(f"{len(regressions)} benchmark(s) regressed more than {args.threshold}%")
+        return 1
+
+    print("No regression")
+    return 0
+
+
+if __name__ == "__main__":
+    sys.exit(main())
@@ -3,8 +3,19 @@ set -euo pipefail
 
 # NOTE: This script should be called from the build output directory of benchmarks
 
+SCRIPT_DIR="$(cd "$(dirname "${BASH_SOURCE[0]}")" && pwd)"
+
 # For Emscripten outputs
 USE_NODE_JS=false
+# Directory for saving results as JSON
+JSON_DIR=""
+# Directory of baselines. Results without a baseline are recorded as the new baseline.
+BASELINE_DIR=""
+# Exit with 1 if any benchmark regresses
+STRICT=false
+THRESHOLD=10
+
+REGRESSED=false
 
 parse_arguments() {
     while [[ $# -gt 0 ]]; do
@@ -13,6 +24,22 @@ parse_arguments() {
                 USE_NODE_JS=true
                 shift
                 ;;
+            --json-dir)
+                JSON_DIR="$2"
+                shift 2
+                ;;
+            --baseline-dir)
+                BASELINE_DIR="$2"
+                shift 2
+                ;;
+            --threshold)
+                THRESHOLD="$2"
+                shift 2
+                ;;
+            --strict)
+                STRICT=true
+                shift
+                ;;
             *)
                 echo "Unknown option: $1"
                 exit 1
@@ -21,12 +48,37 @@ parse_arguments() {
     done
 }
 
+# Compare the result with the baseline, or record it as the baseline if there isn't one
+compare_with_baseline() {
+    local name="$1"
+    local result="$2"
+    local baseline="$BASELINE_DIR/$name.json"
+
+    if [ ! -f "$baseline" ]; then
+        echo "Recording baseline: $baseline"
+        cp "$result" "$baseline"
+        return
+    fi
+
+    if ! python3 "$SCRIPT_DIR/../bench/compare.py" "$baseline" "$result" --threshold "$THRESHOLD"; then
+        REGRESSED=true
+    fi
+}
+
 # Run all executables start with "bench_"
 run_executable_benchmarks() {
     for exe in bench_*; do
         if [ -x "$exe" ]; then
             echo "Running benchmark: $exe"
-            ./$exe
+            if [ -n "$JSON_DIR" ]; then
+                local result="$JSON_DIR/$exe.json"
+                ./$exe --benchmark_out="$result" --benchmark_out_format=json --benchmark_repetitions=5
+                if [ -n "$BASELINE_DIR" ]; then
+                    compare_with_baseline "$exe" "$result"
+                fi
+            else
+                ./$exe
+            fi
         fi
     done
 }
@@ -43,8 +95,26 @@ run_nodejs_benchmarks() {
 
 parse_arguments "$@"
 
+if [ -n "$BASELINE_DIR" ] && [ -z "$JSON_DIR" ]; then
+    echo "--baseline-dir requires --json-dir"
+    exit 1
+fi
+if [ -n "$JSON_DIR" ]; then
+    mkdir -p "$JSON_DIR"
+fi
+if [ -n "$BASELINE_DIR" ]; then
+    mkdir -p "$BASELINE_DIR"
+fi
+
 if [ "$USE_NODE_JS" = true ]; then
     run_nodejs_benchmarks
 else
     run_executable_benchmarks
 fi
+
+if [ "$REGRESSED" = true ]; then
+    echo "Performance regression detected"
+    if [ "$STRICT" = true ]; then
+        exit 1
+    fi
+fi
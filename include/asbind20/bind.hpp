@@ -221,6 +221,14 @@ public:
             m_name.c_str(),
             decl.c_str()
         );
+        this->record(
+            {
+                .kind = registration_kind::interface_method,
+                .object = m_name.c_str(),
+                .decl = decl.c_str(),
+            },
+            r
+        );
         listener_type_traits::on_method(
             this->get_listener(), *this, r
         );
@@ -234,6 +242,13 @@ public:
         );
 
         int r = this->get_engine()->RegisterFuncdef(full_decl.c_str());
+        this->record(
+            {
+                .kind = registration_kind::funcdef,
+                .decl = full_decl.c_str(),
+            },
+            r
+        );
         listener_type_traits::on_funcdef(
             this->get_listener(), *this, r
         );
@@ -253,6 +268,13 @@ private:
     void do_register()
     {
         int r = this->get_engine()->RegisterInterface(m_name.c_str());
+        this->record(
+            {
+                .kind = registration_kind::interface_,
+                .object = m_name.c_str(),
+            },
+            r
+        );
         listener_type_traits::on_interface(
             this->get_listener(), *this, r
         );
@@ -11,11 +11,13 @@
 
 #include <memory>
 #include <concepts>
+#include <span>
 #include "common.hpp"
 #include "genfunc.hpp"
 #include "../policies.hpp"
 #include "behaviour.hpp"
 #include "function_tools.hpp"
+#include "method_table.hpp"
 
 namespace asbind20
 {
@@ -89,16 +91,11 @@ namespace detail
 
         static void impl_generic(generic_pointer gen)
         {
-            using args_tuple = std::tuple<Args...>;
-
             [gen]<std::size_t... Is>(std::index_sequence<Is...>)
             {
+                gen_arg_reader<Args...> args(gen);
                 void* mem = gen->GetObject();
-                new(mem) Class(
-                    get_generic_arg<std::tuple_element_t<Is, args_tuple>>(
-                        gen, static_cast<gen_idx_t>(Is)
-                    )...
-                );
+                new(mem) Class(args.template get<Is>()...);
 
                 ex_guard::destroy_if_ex(static_cast<Class*>(mem));
             }(std::index_sequence_for<Args...>());
@@ -133,14 +130,12 @@ namespace detail
         {
             [gen]<std::size_t... Is>(std::index_sequence<Is...>)
             {
-                using args_tuple = std::tuple<Args...>;
-
+                // The hidden type information is the first argument
+                gen_arg_reader<AS_NAMESPACE_QUALIFIER asITypeInfo*, Args...> args(gen);
                 void* mem = gen->GetObject();
                 new(mem) Class(
-                    get_generic_typeinfo(gen),
-                    get_generic_arg<std::tuple_element_t<Is, args_tuple>>(
-                        gen, static_cast<gen_idx_t>(Is) + 1
-                    )...
+                    args.template get<0>(),
+                    args.template get<Is + 1>()...
                 );
 
                 ex_guard::destroy_if_ex(static_cast<Class*>(mem));
@@ -497,16 +492,15 @@ namespace detail
     {
         static void impl_generic(generic_pointer gen)
         {
-            using args_tuple = std::tuple<Args...>;
             if constexpr(Template)
             {
                 [gen]<std::size_t... Is>(std::index_sequence<Is...>)
                 {
+                    // The hidden type information is the first argument
+                    gen_arg_reader<AS_NAMESPACE_QUALIFIER asITypeInfo*, Args...> args(gen);
                     auto* ptr = new Class(
-                        get_generic_typeinfo(gen),
-                        get_generic_arg<std::tuple_element_t<Is, args_tuple>>(
-                            gen, static_cast<gen_idx_t>(Is) + 1
-                        )...
+                        args.template get<0>(),
+                        args.template get<Is + 1>()...
                     );
                     gen->SetReturnAddress(ptr);
                 }(std::index_sequence_for<Args...>());
@@ -515,11 +509,8 @@ namespace detail
             {
                 [gen]<std::size_t... Is>(std::index_sequence<Is...>)
                 {
-                    auto* ptr = new Class(
-                        get_generic_arg<std::tuple_element_t<Is, args_tuple>>(
-                            gen, static_cast<gen_idx_t>(Is)
-                        )...
-                    );
+                    gen_arg_reader<Args...> args(gen);
+                    auto* ptr = new Class(args.template get<Is>()...);
                     gen->SetReturnAddress(ptr);
                 }(std::index_sequence_for<Args...>());
             }
@@ -562,16 +553,11 @@ namespace detail
 
         static void impl_generic(generic_pointer gen)
         {
-            using args_tuple = std::tuple<Args...>;
-
             [gen]<std::size_t... Is>(std::index_sequence<Is...>)
             {
+                gen_arg_reader<Args...> args(gen);
                 auto* ti = (AS_NAMESPACE_QUALIFIER asITypeInfo*)gen->GetAuxiliary();
-                auto* ptr = new Class(
-                    get_generic_arg<std::tuple_element_t<Is, args_tuple>>(
-                        gen, static_cast<gen_idx_t>(Is)
-                    )...
-                );
+                auto* ptr = new Class(args.template get<Is>()...);
                 ASBIND20_ASSERT(ti->GetEngine() == gen->GetEngine());
                 if(has_script_exception()) [[unlikely]]
                 {
@@ -619,16 +605,14 @@ namespace detail
 
         static void impl_generic(generic_pointer gen)
         {
-            using args_tuple = std::tuple<Args...>;
-
             [gen]<std::size_t... Is>(std::index_sequence<Is...>)
             {
-                auto* ti = get_generic_typeinfo(gen);
+                // The hidden type information is the first argument
+                gen_arg_reader<AS_NAMESPACE_QUALIFIER asITypeInfo*, Args...> args(gen);
+                auto* ti = args.template get<0>();
                 auto* ptr = new Class(
                     ti,
-                    get_generic_arg<std::tuple_element_t<Is, args_tuple>>(
-                        gen, static_cast<gen_idx_t>(Is) + 1
-                    )...
+                    args.template get<Is + 1>()...
                 );
 
                 if(has_script_exception()) [[unlikely]]
@@ -1134,6 +1118,18 @@ namespace detail
         }
     };
 
+    /**
+     * @brief Generate declaration of conversion operator at compile time
+     */
+    template <has_static_name To, bool Implicit>
+    consteval auto fixed_decl_opConv()
+    {
+        if constexpr(Implicit)
+            return name_of<To>() + util::fixed_string(" opImplConv() const");
+        else
+            return name_of<To>() + util::fixed_string(" opConv() const");
+    }
+
     template <typename Class, typename To>
     class opConv
     {
@@ -1221,6 +1217,15 @@ protected:
             size,
             flags
         );
+        this->record(
+            {
+                .kind = registration_kind::object_type,
+                .object = m_name.c_str(),
+                .flags = flags,
+                .value = size,
+            },
+            r
+        );
         if(r > 0) [[likely]]
             m_this_type_id = r;
         return r;
@@ -1258,15 +1263,39 @@ protected:
         void* aux = nullptr
     )
     {
-        return get_engine()->RegisterObjectMethod(
-            m_name.c_str(),
-            decl.c_str(),
+        if constexpr(listener_traits<Listener>::template can_wrap_generic<class_binding_generator_base, Fn>)
+        {
+            if(conv == AS_NAMESPACE_QUALIFIER asCALL_GENERIC)
+            {
+                AS_NAMESPACE_QUALIFIER asGENFUNC_t gfn = fn;
+                listener_traits<Listener>::wrap_generic(this->get_listener(), *this, gfn, aux);
+                return register_method_impl(
+                    decl,
+                    detail::to_asSFuncPtr(gfn),
+                    conv,
+                    aux
+                );
+            }
+        }
+
+        return register_method_impl(
+            decl,
             detail::to_asSFuncPtr(fn),
             conv,
             aux
         );
     }
 
+    [[nodiscard]]
+    int register_method_ptr(
+        cstring_ref decl,
+        const AS_NAMESPACE_QUALIFIER asSFuncPtr& fptr,
+        AS_NAMESPACE_QUALIFIER asECallConvTypes conv
+    )
+    {
+        return register_method_impl(decl, fptr, conv, nullptr);
+    }
+
     template <typename Fn>
     int register_comp_method(
         cstring_ref decl,
@@ -1276,15 +1305,30 @@ protected:
         void* aux = nullptr
     )
     {
-        return get_engine()->RegisterObjectMethod(
+        const auto fptr = detail::to_asSFuncPtr(fn);
+        int r = get_engine()->RegisterObjectMethod(
             m_name.c_str(),
             decl.c_str(),
-            detail::to_asSFuncPtr(fn),
+            fptr,
             conv,
             aux,
             static_cast<int>(comp.get_offset()),
             true
         );
+        this->record(
+            {
+                .kind = registration_kind::object_method,
+                .object = m_name.c_str(),
+                .decl = decl.c_str(),
+                .func = fptr,
+                .call_conv = static_cast<AS_NAMESPACE_QUALIFIER asDWORD>(conv),
+                .pointer = aux,
+                .comp_offset = static_cast<int>(comp.get_offset()),
+                .comp_indirect = true,
+            },
+            r
+        );
+        return r;
     }
 
     template <typename Fn>
@@ -1296,23 +1340,47 @@ protected:
         void* aux = nullptr
     )
     {
-        return get_engine()->RegisterObjectBehaviour(
+        const auto fptr = detail::to_asSFuncPtr(fn);
+        int r = get_engine()->RegisterObjectBehaviour(
             m_name.c_str(),
             beh,
             decl.c_str(),
-            detail::to_asSFuncPtr(fn),
+            fptr,
             conv,
             aux
         );
+        this->record(
+            {
+                .kind = registration_kind::object_behaviour,
+                .object = m_name.c_str(),
+                .decl = decl.c_str(),
+                .func = fptr,
+                .call_conv = static_cast<AS_NAMESPACE_QUALIFIER asDWORD>(conv),
+                .pointer = aux,
+                .behaviour = beh,
+            },
+            r
+        );
+        return r;
     }
 
     int register_property(cstring_ref decl, std::size_t off)
     {
-        return get_engine()->RegisterObjectProperty(
+        int r = get_engine()->RegisterObjectProperty(
             m_name.c_str(),
             decl.c_str(),
             static_cast<int>(off)
         );
+        this->record(
+            {
+                .kind = registration_kind::object_property,
+                .object = m_name.c_str(),
+                .decl = decl.c_str(),
+                .value = static_cast<int>(off),
+            },
+            r
+        );
+        return r;
     }
 
     template <typename MemberPointer>
@@ -1324,13 +1392,25 @@ protected:
 
     int register_comp_property(cstring_ref decl, std::size_t off, std::size_t comp_off)
     {
-        return get_engine()->RegisterObjectProperty(
+        int r = get_engine()->RegisterObjectProperty(
             m_name.c_str(),
             decl.c_str(),
             static_cast<int>(off),
             static_cast<int>(comp_off),
             true
         );
+        this->record(
+            {
+                .kind = registration_kind::object_property,
+                .object = m_name.c_str(),
+                .decl = decl.c_str(),
+                .value = static_cast<int>(off),
+                .comp_offset = static_cast<int>(comp_off),
+                .comp_indirect = true,
+            },
+            r
+        );
+        return r;
     }
 
     template <typename CompMemberPointer>
@@ -1604,7 +1684,7 @@ protected:
 #undef ASBIND20_IMPL_REGISTER_BINARY_OP_NATIVE
 #undef ASBIND20_IMPL_REGISTER_BINARY_OP
 
-    int register_member_funcdef(std::string_view decl) const
+    int register_member_funcdef(std::string_view decl)
     {
         std::string full_decl = detail::generate_member_funcdef(
             m_name, decl
@@ -1621,11 +1701,11 @@ protected:
     }
 
     template <typename Class, typename To>
-    int opConv_impl_native(std::string_view ret, bool implicit)
+    int opConv_impl_native(cstring_ref decl)
     {
         using gen_t = detail::opConv<std::add_const_t<Class>, To>;
         return register_method(
-            decl_opConv(ret, implicit),
+            decl,
             gen_t::generate(
                 detail::cdecl_last_cc
             ),
@@ -1634,11 +1714,11 @@ protected:
     }
 
     template <typename Class, typename To>
-    int opConv_impl_generic(std::string_view ret, bool implicit)
+    int opConv_impl_generic(cstring_ref decl)
     {
         using gen_t = detail::opConv<std::add_const_t<Class>, To>;
         return register_method(
-            decl_opConv(ret, implicit),
+            decl,
             gen_t::generate(detail::generic_cc),
             detail::generic_cc
         );
@@ -1651,14 +1731,58 @@ protected:
         [[maybe_unused]]
         int r = 0;
         r = get_engine()->RegisterStringFactory(get_name().c_str(), factory);
+        this->record(
+            {
+                .kind = registration_kind::string_factory,
+                .object = get_name().c_str(),
+                .pointer = factory,
+            },
+            r
+        );
         ASBIND20_ASSERT(r >= 0);
     }
 
 private:
+    int register_method_impl(
+        cstring_ref decl,
+        const AS_NAMESPACE_QUALIFIER asSFuncPtr& fptr,
+        AS_NAMESPACE_QUALIFIER asECallConvTypes conv,
+        void* aux
+    )
+    {
+        int r = get_engine()->RegisterObjectMethod(
+            m_name.c_str(),
+            decl.c_str(),
+            fptr,
+            conv,
+            aux
+        );
+        this->record(
+            {
+                .kind = registration_kind::object_method,
+                .object = m_name.c_str(),
+                .decl = decl.c_str(),
+                .func = fptr,
+                .call_conv = static_cast<AS_NAMESPACE_QUALIFIER asDWORD>(conv),
+                .pointer = aux,
+            },
+            r
+        );
+        return r;
+    }
+
     // Internal interface because AS doesn't provide a direct interface to register member funcdef
-    int register_full_funcdef(cstring_ref decl) const
+    int register_full_funcdef(cstring_ref decl)
     {
-        return get_engine()->RegisterFuncdef(decl.c_str());
+        int r = get_engine()->RegisterFuncdef(decl.c_str());
+        this->record(
+            {
+                .kind = registration_kind::funcdef,
+                .decl = decl.c_str(),
+            },
+            r
+        );
+        return r;
     }
 };
 
@@ -1937,6 +2061,9 @@ public:
         fp_wrapper<Method>
     )
     {
+#ifdef ASBIND20_CONFIG_SHARED_GENERIC_WRAPPERS
+        return method(use_shared_generic, decl, fp<Method>);
+#else
         constexpr auto conv = method_callconv<Method>();
         int r = this->register_method(
             decl,
@@ -1945,6 +2072,30 @@ public:
         );
         listener_traits_type::on_method(get_listener(), derived(), r);
         return derived();
+#endif
+    }
+
+    /**
+     * @brief Register a method by the generic wrapper shared by methods of the same signature
+     *
+     * @note The auxiliary pointer is used for passing the method to the shared wrapper.
+     */
+    template <auto Method>
+    Derived& method(
+        use_shared_generic_t,
+        cstring_ref decl,
+        fp_wrapper<Method>
+    )
+    {
+        constexpr auto conv = method_callconv<Method>();
+        int r = this->register_method(
+            decl,
+            detail::to_shared_asGENFUNC_t(fp<Method>, detail::cc<conv>),
+            detail::generic_cc,
+            detail::shared_generic_aux(fp<Method>)
+        );
+        listener_traits_type::on_method(get_listener(), derived(), r);
+        return derived();
     }
 
     template <auto Method>
@@ -2425,6 +2576,55 @@ public:
         return derived();
     }
 
+    /**
+     * @brief Register methods in a table using the generic calling convention
+     *
+     * @note The auxiliary pointer is used for passing the function to the shared generic wrapper.
+     */
+    Derived& methods(
+        use_generic_t,
+        std::span<const method_entry<Class>> table
+    )
+    {
+        for(const method_entry<Class>& entry : table)
+        {
+            int r = this->register_method(
+                entry.decl,
+                entry.generic,
+                detail::generic_cc,
+                const_cast<void*>(entry.target)
+            );
+            listener_traits_type::on_method(get_listener(), derived(), r);
+        }
+        return derived();
+    }
+
+    /**
+     * @brief Register methods in a table
+     *
+     * @sa method_entry
+     */
+    Derived& methods(
+        std::span<const method_entry<Class>> table
+    )
+    {
+        if constexpr(ForceGeneric)
+            this->methods(use_generic, table);
+        else
+        {
+            for(const method_entry<Class>& entry : table)
+            {
+                int r = this->register_method_ptr(
+                    entry.decl,
+                    entry.native(entry.target),
+                    entry.conv
+                );
+                listener_traits_type::on_method(get_listener(), derived(), r);
+            }
+        }
+        return derived();
+    }
+
     Derived& property(cstring_ref decl, std::size_t off)
     {
         this->register_property(decl, off);
@@ -2482,7 +2682,7 @@ public:
     template <typename To>
     Derived& opConv(use_generic_t, std::string_view to_decl)
     {
-        int r = this->template opConv_impl_generic<Class, To>(to_decl, false);
+        int r = this->template opConv_impl_generic<Class, To>(this->decl_opConv(to_decl, false));
         listener_traits_type::on_method(get_listener(), derived(), r);
         return derived();
     }
@@ -2494,7 +2694,7 @@ public:
             opConv<To>(use_generic, to_decl);
         else
         {
-            int r = this->template opConv_impl_native<Class, To>(to_decl, false);
+            int r = this->template opConv_impl_native<Class, To>(this->decl_opConv(to_decl, false));
             listener_traits_type::on_method(get_listener(), derived(), r);
         }
         return derived();
@@ -2503,7 +2703,7 @@ public:
     template <typename To>
     Derived& opImplConv(use_generic_t, std::string_view to_decl)
     {
-        int r = this->template opConv_impl_generic<Class, To>(to_decl, true);
+        int r = this->template opConv_impl_generic<Class, To>(this->decl_opConv(to_decl, true));
         listener_traits_type::on_method(get_listener(), derived(), r);
         return derived();
     }
@@ -2515,7 +2715,7 @@ public:
             opImplConv<To>(use_generic, to_decl);
         else
         {
-            int r = this->template opConv_impl_native<Class, To>(to_decl, true);
+            int r = this->template opConv_impl_native<Class, To>(this->decl_opConv(to_decl, true));
             listener_traits_type::on_method(get_listener(), derived(), r);
         }
         return derived();
@@ -2524,28 +2724,46 @@ public:
     template <has_static_name To>
     Derived& opConv(use_generic_t)
     {
-        opConv<To>(use_generic, name_of<To>());
+        constexpr auto decl = detail::fixed_decl_opConv<To, false>();
+        int r = this->template opConv_impl_generic<Class, To>(decl);
+        listener_traits_type::on_method(get_listener(), derived(), r);
         return derived();
     }
 
     template <has_static_name To>
     Derived& opConv()
     {
-        opConv<To>(name_of<To>());
+        if constexpr(ForceGeneric)
+            opConv<To>(use_generic);
+        else
+        {
+            constexpr auto decl = detail::fixed_decl_opConv<To, false>();
+            int r = this->template opConv_impl_native<Class, To>(decl);
+            listener_traits_type::on_method(get_listener(), derived(), r);
+        }
         return derived();
     }
 
     template <has_static_name To>
     Derived& opImplConv(use_generic_t)
     {
-        opImplConv<To>(use_generic, name_of<To>());
+        constexpr auto decl = detail::fixed_decl_opConv<To, true>();
+        int r = this->template opConv_impl_generic<Class, To>(decl);
+        listener_traits_type::on_method(get_listener(), derived(), r);
         return derived();
     }
 
     template <has_static_name To>
     Derived& opImplConv()
     {
-        opImplConv<To>(name_of<To>());
+        if constexpr(ForceGeneric)
+            opImplConv<To>(use_generic);
+        else
+        {
+            constexpr auto decl = detail::fixed_decl_opConv<To, true>();
+            int r = this->template opConv_impl_native<Class, To>(decl);
+            listener_traits_type::on_method(get_listener(), derived(), r);
+        }
         return derived();
     }
 
@@ -3934,9 +4152,20 @@ private:
             return string_concat("void f(int&in){", pattern, '}');
     }
 
+    // Declaration for the apply_to policy, whose pattern is known at compile time
+    template <typename ListElementType, std::size_t Size>
+    static consteval auto fixed_decl_list_constructor()
+    {
+        constexpr auto pattern = policies::apply_to<Size>::template fixed_pattern<ListElementType>();
+        if constexpr(Template)
+            return util::fixed_string("void f(int&in,int&in)") + pattern;
+        else
+            return util::fixed_string("void f(int&in)") + pattern;
+    }
+
     template <typename Fn>
-    void register_list_ctor_func(
-        std::string_view pattern,
+    void register_list_ctor_decl(
+        cstring_ref decl,
         Fn&& fn,
         AS_NAMESPACE_QUALIFIER asECallConvTypes conv,
         void* aux = nullptr
@@ -3944,6 +4173,22 @@ private:
     {
         this->register_behaviour(
             AS_NAMESPACE_QUALIFIER asBEHAVE_LIST_CONSTRUCT,
+            decl,
+            fn,
+            conv,
+            aux
+        );
+    }
+
+    template <typename Fn>
+    void register_list_ctor_func(
+        std::string_view pattern,
+        Fn&& fn,
+        AS_NAMESPACE_QUALIFIER asECallConvTypes conv,
+        void* aux = nullptr
+    )
+    {
+        register_list_ctor_decl(
             decl_list_constructor(pattern),
             fn,
             conv,
@@ -4077,6 +4322,69 @@ public:
         return *this;
     }
 
+    /**
+     * @brief Register a list constructor using the `apply_to` policy
+     *
+     * The list pattern is generated from the name of element type at compile time, e.g. `{int,int}`.
+     *
+     * @tparam ListElementType Element type
+     * @tparam Size Size of the list
+     */
+    template <has_static_name ListElementType, std::size_t Size>
+    basic_value_class& list_constructor(
+        use_generic_t, use_policy_t<policies::apply_to<Size>>
+    )
+    {
+        using gen_t = detail::list_constructor<
+            Class,
+            Template,
+            ListElementType,
+            policies::apply_to<Size>>;
+        constexpr auto decl = fixed_decl_list_constructor<ListElementType, Size>();
+        this->register_list_ctor_decl(
+            decl,
+            gen_t::generate(detail::generic_cc),
+            detail::generic_cc
+        );
+
+        return *this;
+    }
+
+    /**
+     * @brief Register a list constructor using the `apply_to` policy
+     *
+     * The list pattern is generated from the name of element type at compile time, e.g. `{int,int}`.
+     *
+     * @tparam ListElementType Element type
+     * @tparam Size Size of the list
+     */
+    template <has_static_name ListElementType, std::size_t Size>
+    basic_value_class& list_constructor(
+        use_policy_t<policies::apply_to<Size>>
+    )
+    {
+        if constexpr(ForceGeneric)
+            list_constructor<ListElementType>(use_generic, use_policy<policies::apply_to<Size>>);
+        else
+        {
+            using gen_t = detail::list_constructor<
+                Class,
+                Template,
+                ListElementType,
+                policies::apply_to<Size>>;
+            constexpr auto decl = fixed_decl_list_constructor<ListElementType, Size>();
+            this->register_list_ctor_decl(
+                decl,
+                gen_t::generate(
+                    detail::cdecl_last_cc
+                ),
+                detail::cdecl_last_cc
+            );
+        }
+
+        return *this;
+    }
+
     ASBIND20_BG_INTERFACE_DEFINE_OP(basic_value_class, opNeg)
 
     ASBIND20_BG_INTERFACE_DEFINE_OP(basic_value_class, opPostInc)
@@ -5391,6 +5699,13 @@ public:
         [[maybe_unused]]
         int r = 0;
         r = get_engine()->RegisterDefaultArrayType(get_name().c_str());
+        this->record(
+            {
+                .kind = registration_kind::default_array_type,
+                .object = get_name().c_str(),
+            },
+            r
+        );
         ASBIND20_ASSERT(r >= 0);
 
         return *this;
@@ -32,6 +32,16 @@ struct use_generic_t
 
 constexpr inline use_generic_t use_generic{};
 
+/**
+ * @brief Tag for registering by the generic wrapper shared by functions of the same signature
+ *
+ * The registered function is passed to the shared wrapper by the auxiliary pointer.
+ */
+struct use_shared_generic_t
+{};
+
+constexpr inline use_shared_generic_t use_shared_generic{};
+
 struct use_explicit_t
 {};
 
@@ -404,6 +414,18 @@ public:
         return m_listener;
     }
 
+protected:
+    /**
+     * @brief Report arguments of a registration to the listener
+     *
+     * @param rec Arguments of the registration
+     * @param id Result of the registration
+     */
+    void record(const registration_record& rec, int id)
+    {
+        listener_traits<Listener>::record(m_listener, *this, rec, id);
+    }
+
 private:
     Listener m_listener;
 };
@@ -142,6 +142,16 @@ private:
 #endif
         );
         // clang-format on
+        this->record(
+            {
+                .kind = registration_kind::enum_,
+                .object = name.c_str(),
+#ifdef ASBIND20_HAS_ENUM_UNDERLYING_TYPE
+                .decl = underlying.c_str(),
+#endif
+            },
+            r
+        );
 
         listener_type_traits::on_enum(
             this->get_listener(), *this, r
@@ -175,6 +185,15 @@ private:
             name.c_str(),
             val
         );
+        this->record(
+            {
+                .kind = registration_kind::enum_value,
+                .object = m_name.c_str(),
+                .decl = name.c_str(),
+                .value = val,
+            },
+            r
+        );
         listener_type_traits::on_enum_value(
             this->get_listener(), *this, r
         );
@@ -10,7 +10,9 @@
 #pragma once
 
 #include <cstddef>
+#include <cstring>
 #include <array>
+#include <tuple>
 #include "../detail/calling_convention.hpp"
 #include "../meta.hpp"
 #include "../utility.hpp"
@@ -33,7 +35,7 @@ consteval auto gen_script_arg_idx(var_type_t<Is...> = {})
     static_assert(RawArgCount >= sizeof...(Is), "Invalid argument count");
 
     constexpr std::size_t script_arg_count = RawArgCount - sizeof...(Is);
-    constexpr std::size_t var_type_pos[]{Is...};
+    constexpr std::array<std::size_t, sizeof...(Is)> var_type_pos{Is...};
 
     std::array<std::size_t, RawArgCount> tmp{}; // result
     std::size_t current_arg_pos = 0;
@@ -74,146 +76,307 @@ decltype(auto) var_type_helper(
 template <std::size_t... Is>
 constexpr bool var_type_tag_helper(var_type_t<Is...>, std::size_t raw_idx)
 {
-    // Plus 1 for the position of type id
-    std::size_t arr[]{(Is + 1)...};
+    // Plus 1 for the position of type id.
+    // Every preceding variable type argument also occupies an additional position for its type id.
+    const std::array<std::size_t, sizeof...(Is)> pos{Is...};
 
     // Returns true if the position is for type id
-    return std::find(std::begin(arr), std::end(arr), raw_idx) != std::end(arr);
+    for(std::size_t k = 0; k < sizeof...(Is); ++k)
+    {
+        if(pos[k] + k + 1 == raw_idx)
+            return true;
+    }
+    return false;
 }
 
 template <typename VarType, std::size_t RawIdx>
 using var_type_tag = std::bool_constant<var_type_tag_helper(VarType{}, RawIdx)>;
 
-#define ASBIND20_GENERIC_WRAPPER_IMPL(func)                                  \
-    static void wrapper_thiscall(generic_pointer gen)                        \
-    {                                                                        \
-        [gen]<std::size_t... Is>(std::index_sequence<Is...>)                 \
-        {                                                                    \
-            set_generic_return_by<typename traits::return_type>(             \
-                gen,                                                         \
-                func,                                                        \
-                this_(gen),                                                  \
-                get_generic_arg<typename traits::template arg_type<Is>>(     \
-                    gen, static_cast<gen_idx_t>(Is)                          \
-                )...                                                         \
-            );                                                               \
-        }(std::make_index_sequence<traits::arg_count::value>());             \
-    }                                                                        \
-    static void wrapper_objfirst(generic_pointer gen)                        \
-    {                                                                        \
-        static_assert(traits::arg_count::value >= 1);                        \
-        [gen]<std::size_t... Is>(std::index_sequence<Is...>)                 \
-        {                                                                    \
-            set_generic_return_by<typename traits::return_type>(             \
-                gen,                                                         \
-                func,                                                        \
-                this_(gen),                                                  \
-                get_generic_arg<typename traits::template arg_type<Is + 1>>( \
-                    gen, static_cast<gen_idx_t>(Is)                          \
-                )...                                                         \
-            );                                                               \
-        }(std::make_index_sequence<traits::arg_count::value - 1>());         \
-    }                                                                        \
-    static void wrapper_objlast(generic_pointer gen)                         \
-    {                                                                        \
-        static_assert(traits::arg_count::value >= 1);                        \
-        [gen]<std::size_t... Is>(std::index_sequence<Is...>)                 \
-        {                                                                    \
-            set_generic_return_by<typename traits::return_type>(             \
-                gen,                                                         \
-                func,                                                        \
-                get_generic_arg<typename traits::template arg_type<Is>>(     \
-                    gen, static_cast<gen_idx_t>(Is)                          \
-                )...,                                                        \
-                this_(gen)                                                   \
-            );                                                               \
-        }(std::make_index_sequence<traits::arg_count::value - 1>());         \
-    }                                                                        \
-    static void wrapper_general(generic_pointer gen)                         \
-    {                                                                        \
-        [gen]<std::size_t... Is>(std::index_sequence<Is...>)                 \
-        {                                                                    \
-            set_generic_return_by<typename traits::return_type>(             \
-                gen,                                                         \
-                func,                                                        \
-                get_generic_arg<typename traits::template arg_type<Is>>(     \
-                    gen, static_cast<gen_idx_t>(Is)                          \
-                )...                                                         \
-            );                                                               \
-        }(std::make_index_sequence<traits::arg_count::value>());             \
+// Size of a pointer on the stack of script context in DWORDs
+inline constexpr std::size_t gen_ptr_size =
+    sizeof(void*) / sizeof(AS_NAMESPACE_QUALIFIER asDWORD);
+
+/**
+ * @brief Size of an argument on the stack of script context in DWORDs
+ *
+ * @return 0 if the argument cannot be directly loaded from the stack,
+ *         e.g., types with customized `type_traits`.
+ */
+template <typename T>
+consteval std::size_t gen_stack_size()
+{
+    using type = std::remove_cv_t<T>;
+
+    constexpr bool is_customized = requires(generic_pointer gen, gen_idx_t idx) {
+        type_traits<type>::get_arg(gen, idx);
+    };
+
+    if constexpr(is_customized)
+        return 0;
+    else if constexpr(std::is_reference_v<type>)
+        return gen_stack_size<std::remove_reference_t<type>*>();
+    // Object arguments are passed by pointers
+    else if constexpr(std::is_pointer_v<type> || std::is_class_v<type>)
+        return gen_ptr_size;
+    // Enums with a 64-bit underlying type occupy 2 DWORDs
+    else if constexpr(std::is_enum_v<type>)
+        return gen_stack_size<std::underlying_type_t<type>>();
+    else if constexpr(std::integral<type>)
+    {
+        if constexpr(sizeof(type) <= sizeof(AS_NAMESPACE_QUALIFIER asDWORD))
+            return 1;
+        else if constexpr(sizeof(type) == sizeof(AS_NAMESPACE_QUALIFIER asQWORD))
+            return 2;
+        else
+            return 0;
+    }
+    else if constexpr(std::same_as<type, float>)
+        return 1;
+    else if constexpr(std::same_as<type, double>)
+        return 2;
+    else
+        return 0;
+}
+
+/**
+ * @brief Load an argument from its address on the stack, following the rules of `get_generic_arg`
+ */
+template <typename T>
+T gen_load_arg(const AS_NAMESPACE_QUALIFIER asDWORD* addr)
+{
+    if constexpr(std::is_reference_v<T>)
+    {
+        return *gen_load_arg<std::remove_reference_t<T>*>(addr);
+    }
+    else if constexpr(std::is_pointer_v<T>)
+    {
+        void* ptr;
+        std::memcpy(&ptr, addr, sizeof(void*));
+        return (T)ptr;
+    }
+    else if constexpr(std::is_class_v<T>)
+    {
+        return std::move(*gen_load_arg<T*>(addr));
+    }
+    else if constexpr(std::is_enum_v<T>)
+    {
+        return static_cast<T>(gen_load_arg<std::underlying_type_t<T>>(addr));
+    }
+    else
+    {
+        // Using memcpy because 64-bit values are only aligned to 4 bytes on the stack
+        std::remove_cv_t<T> val;
+        std::memcpy(&val, addr, sizeof(val));
+        return val;
+    }
+}
+
+/**
+ * @brief Argument reader for generated generic wrappers
+ *
+ * If all arguments can be directly loaded, the stack offsets are calculated at compile time from the signature.
+ * The wrapper only needs one call of `GetAddressOfArg` and other arguments are plain loads.
+ * Otherwise, it falls back to the `get_generic_arg`.
+ *
+ * A variable type argument (`?`) is passed by a pair of `void*` and `int` in C++.
+ * Its layout on the stack is the same, i.e., the address followed by the type ID.
+ *
+ * @note Define `ASBIND20_CONFIG_NO_DIRECT_GENERIC_ARGS` to always use the `get_generic_arg`.
+ *
+ * @tparam VarType Positions of variable type arguments in the script parameter list
+ * @tparam Args Arguments in C++
+ */
+template <typename VarType, typename... Args>
+class basic_gen_arg_reader
+{
+    using args_tuple = std::tuple<Args...>;
+
+    static consteval bool first_arg_direct()
+    {
+        if constexpr(sizeof...(Args) == 0)
+            return false;
+        else
+        {
+            // The address of an object passed by value will be dereferenced by the GetAddressOfArg,
+            // so it cannot be used for locating other arguments.
+            using first_t = std::tuple_element_t<0, args_tuple>;
+            return !std::is_class_v<std::remove_cv_t<first_t>>;
+        }
     }
 
-#define ASBIND20_GENERIC_WRAPPER_VAR_TYPE_IMPL(func)                                            \
-    template <typename VarType>                                                                 \
-    static void var_type_wrapper_thiscall(generic_pointer gen)                                  \
-    {                                                                                           \
-        static constexpr auto indices = gen_script_arg_idx<traits::arg_count_v>(VarType{});     \
-        [gen]<std::size_t... Is>(std::index_sequence<Is...>)                                    \
-        {                                                                                       \
-            set_generic_return_by<typename traits::return_type>(                                \
-                gen,                                                                            \
-                func,                                                                           \
-                this_(gen),                                                                     \
-                var_type_helper<typename traits::template arg_type<Is>>(                        \
-                    var_type_tag<VarType, Is>{},                                                \
-                    gen,                                                                        \
-                    indices[Is]                                                                 \
-                )...                                                                            \
-            );                                                                                  \
-        }(std::make_index_sequence<indices.size()>());                                          \
-    }                                                                                           \
-    template <typename VarType>                                                                 \
-    static void var_type_wrapper_objfirst(generic_pointer gen)                                  \
-    {                                                                                           \
-        static constexpr auto indices = gen_script_arg_idx<traits::arg_count_v - 1>(VarType{}); \
-        [gen]<std::size_t... Is>(std::index_sequence<Is...>)                                    \
-        {                                                                                       \
-            set_generic_return_by<typename traits::return_type>(                                \
-                gen,                                                                            \
-                func,                                                                           \
-                this_(gen),                                                                     \
-                var_type_helper<typename traits::template arg_type<Is + 1>>(                    \
-                    var_type_tag<VarType, Is>{},                                                \
-                    gen,                                                                        \
-                    indices[Is]                                                                 \
-                )...                                                                            \
-            );                                                                                  \
-        }(std::make_index_sequence<indices.size()>());                                          \
-    }                                                                                           \
-    template <typename VarType>                                                                 \
-    static void var_type_wrapper_objlast(generic_pointer gen)                                   \
-    {                                                                                           \
-        static constexpr auto indices = gen_script_arg_idx<traits::arg_count_v - 1>(VarType{}); \
-        [gen]<std::size_t... Is>(std::index_sequence<Is...>)                                    \
-        {                                                                                       \
-            set_generic_return_by<typename traits::return_type>(                                \
-                gen,                                                                            \
-                func,                                                                           \
-                var_type_helper<typename traits::template arg_type<Is>>(                        \
-                    var_type_tag<VarType, Is>{},                                                \
-                    gen,                                                                        \
-                    indices[Is]                                                                 \
-                )...,                                                                           \
-                this_(gen)                                                                      \
-            );                                                                                  \
-        }(std::make_index_sequence<indices.size()>());                                          \
-    }                                                                                           \
-    template <typename VarType>                                                                 \
-    static void var_type_wrapper_general(generic_pointer gen)                                   \
-    {                                                                                           \
-        static constexpr auto indices = gen_script_arg_idx<traits::arg_count_v>(VarType{});     \
-        [gen]<std::size_t... Is>(std::index_sequence<Is...>)                                    \
-        {                                                                                       \
-            set_generic_return_by<typename traits::return_type>(                                \
-                gen,                                                                            \
-                func,                                                                           \
-                var_type_helper<typename traits::template arg_type<Is>>(                        \
-                    var_type_tag<VarType, Is>{},                                                \
-                    gen,                                                                        \
-                    static_cast<gen_idx_t>(indices[Is])                                         \
-                )...                                                                            \
-            );                                                                                  \
-        }(std::make_index_sequence<indices.size()>());                                          \
+    // Index of script argument for each C++ argument
+    static constexpr auto script_indices = gen_script_arg_idx<sizeof...(Args)>(VarType{});
+
+    // True if the argument is the type ID of a variable type argument
+    template <std::size_t Idx>
+    using type_id_tag = var_type_tag<VarType, Idx>;
+
+public:
+    static constexpr bool direct =
+#ifndef ASBIND20_CONFIG_NO_DIRECT_GENERIC_ARGS
+        first_arg_direct() && ((gen_stack_size<Args>() != 0) && ...);
+#else
+        false;
+#endif
+
+    static constexpr auto offsets = []()
+    {
+        std::array<std::size_t, sizeof...(Args)> result{};
+        [[maybe_unused]] std::size_t current = 0;
+        [[maybe_unused]] std::size_t i = 0;
+        ((result[i++] = current, current += gen_stack_size<Args>()), ...);
+        return result;
+    }();
+
+    explicit basic_gen_arg_reader(generic_pointer gen)
+        : m_gen(gen)
+    {
+        if constexpr(direct)
+            m_base = static_cast<const AS_NAMESPACE_QUALIFIER asDWORD*>(gen->GetAddressOfArg(0));
+    }
+
+    template <std::size_t Idx>
+    std::tuple_element_t<Idx, args_tuple> get() const
+    {
+        using arg_t = std::tuple_element_t<Idx, args_tuple>;
+
+        if constexpr(direct)
+        {
+            const AS_NAMESPACE_QUALIFIER asDWORD* addr = m_base + offsets[Idx];
+            // The signature doesn't match the declaration if this assertion fails
+            ASBIND20_ASSERT(
+                std::is_class_v<std::remove_cv_t<arg_t>> ||
+                type_id_tag<Idx>::value ||
+                addr == m_gen->GetAddressOfArg(static_cast<gen_idx_t>(script_indices[Idx]))
+            );
+            return gen_load_arg<arg_t>(addr);
+        }
+        else
+        {
+            return var_type_helper<arg_t>(
+                type_id_tag<Idx>{}, m_gen, script_indices[Idx]
+            );
+        }
+    }
+
+private:
+    generic_pointer m_gen;
+    const AS_NAMESPACE_QUALIFIER asDWORD* m_base = nullptr;
+};
+
+template <typename... Args>
+using gen_arg_reader = basic_gen_arg_reader<var_type_t<>, Args...>;
+
+#define ASBIND20_GENERIC_WRAPPER_IMPL(func)                                          \
+    static void wrapper_thiscall(generic_pointer gen)                                \
+    {                                                                                \
+        [gen]<std::size_t... Is>(std::index_sequence<Is...>)                         \
+        {                                                                            \
+            gen_arg_reader<typename traits::template arg_type<Is>...> args(gen);     \
+            set_generic_return_by<typename traits::return_type>(                     \
+                gen,                                                                 \
+                func,                                                                \
+                this_(gen),                                                          \
+                args.template get<Is>()...                                           \
+            );                                                                       \
+        }(std::make_index_sequence<traits::arg_count::value>());                     \
+    }                                                                                \
+    static void wrapper_objfirst(generic_pointer gen)                                \
+    {                                                                                \
+        static_assert(traits::arg_count::value >= 1);                                \
+        [gen]<std::size_t... Is>(std::index_sequence<Is...>)                         \
+        {                                                                            \
+            gen_arg_reader<typename traits::template arg_type<Is + 1>...> args(gen); \
+            set_generic_return_by<typename traits::return_type>(                     \
+                gen,                                                                 \
+                func,                                                                \
+                this_(gen),                                                          \
+                args.template get<Is>()...                                           \
+            );                                                                       \
+        }(std::make_index_sequence<traits::arg_count::value - 1>());                 \
+    }                                                                                \
+    static void wrapper_objlast(generic_pointer gen)                                 \
+    {                                                                                \
+        static_assert(traits::arg_count::value >= 1);                                \
+        [gen]<std::size_t... Is>(std::index_sequence<Is...>)                         \
+        {                                                                            \
+            gen_arg_reader<typename traits::template arg_type<Is>...> args(gen);     \
+            set_generic_return_by<typename traits::return_type>(                     \
+                gen,                                                                 \
+                func,                                                                \
+                args.template get<Is>()...,                                          \
+                this_(gen)                                                           \
+            );                                                                       \
+        }(std::make_index_sequence<traits::arg_count::value - 1>());                 \
+    }                                                                                \
+    static void wrapper_general(generic_pointer gen)                                 \
+    {                                                                                \
+        [gen]<std::size_t... Is>(std::index_sequence<Is...>)                         \
+        {                                                                            \
+            gen_arg_reader<typename traits::template arg_type<Is>...> args(gen);     \
+            set_generic_return_by<typename traits::return_type>(                     \
+                gen,                                                                 \
+                func,                                                                \
+                args.template get<Is>()...                                           \
+            );                                                                       \
+        }(std::make_index_sequence<traits::arg_count::value>());                     \
+    }
+
+#define ASBIND20_GENERIC_WRAPPER_VAR_TYPE_IMPL(func)                                                \
+    template <typename VarType>                                                                     \
+    static void var_type_wrapper_thiscall(generic_pointer gen)                                      \
+    {                                                                                               \
+        [gen]<std::size_t... Is>(std::index_sequence<Is...>)                                        \
+        {                                                                                           \
+            basic_gen_arg_reader<VarType, typename traits::template arg_type<Is>...> args(gen);     \
+            set_generic_return_by<typename traits::return_type>(                                    \
+                gen,                                                                                \
+                func,                                                                               \
+                this_(gen),                                                                         \
+                args.template get<Is>()...                                                          \
+            );                                                                                      \
+        }(std::make_index_sequence<traits::arg_count_v>());                                         \
+    }                                                                                               \
+    template <typename VarType>                                                                     \
+    static void var_type_wrapper_objfirst(generic_pointer gen)                                      \
+    {                                                                                               \
+        [gen]<std::size_t... Is>(std::index_sequence<Is...>)                                        \
+        {                                                                                           \
+            basic_gen_arg_reader<VarType, typename traits::template arg_type<Is + 1>...> args(gen); \
+            set_generic_return_by<typename traits::return_type>(                                    \
+                gen,                                                                                \
+                func,                                                                               \
+                this_(gen),                                                                         \
+                args.template get<Is>()...                                                          \
+            );                                                                                      \
+        }(std::make_index_sequence<traits::arg_count_v - 1>());                                     \
+    }                                                                                               \
+    template <typename VarType>                                                                     \
+    static void var_type_wrapper_objlast(generic_pointer gen)                                       \
+    {                                                                                               \
+        [gen]<std::size_t... Is>(std::index_sequence<Is...>)                                        \
+        {                                                                                           \
+            basic_gen_arg_reader<VarType, typename traits::template arg_type<Is>...> args(gen);     \
+            set_generic_return_by<typename traits::return_type>(                                    \
+                gen,                                                                                \
+                func,                                                                               \
+                args.template get<Is>()...,                                                         \
+                this_(gen)                                                                          \
+            );                                                                                      \
+        }(std::make_index_sequence<traits::arg_count_v - 1>());                                     \
+    }                                                                                               \
+    template <typename VarType>                                                                     \
+    static void var_type_wrapper_general(generic_pointer gen)                                       \
+    {                                                                                               \
+        [gen]<std::size_t... Is>(std::index_sequence<Is...>)                                        \
+        {                                                                                           \
+            basic_gen_arg_reader<VarType, typename traits::template arg_type<Is>...> args(gen);     \
+            set_generic_return_by<typename traits::return_type>(                                    \
+                gen,                                                                                \
+                func,                                                                               \
+                args.template get<Is>()...                                                          \
+            );                                                                                      \
+        }(std::make_index_sequence<traits::arg_count_v>());                                         \
     }
 
 template <
@@ -312,14 +475,13 @@ class generic_wrapper_nontype
         static_assert(traits::arg_count::value >= 1);
         [gen]<std::size_t... Is>(std::index_sequence<Is...>)
         {
+            gen_arg_reader<typename traits::template arg_type<Is + 1>...> args(gen);
             set_generic_return_by<typename traits::return_type>(
                 gen,
                 Function,
                 get_generic_auxiliary<typename traits::class_type*>(gen),
                 this_(gen),
-                get_generic_arg<typename traits::template arg_type<Is + 1>>(
-                    gen, static_cast<gen_idx_t>(Is)
-                )...
+                args.template get<Is>()...
             );
         }(std::make_index_sequence<traits::arg_count::value - 1>());
     }
@@ -329,13 +491,12 @@ class generic_wrapper_nontype
         static_assert(traits::arg_count::value >= 1);
         [gen]<std::size_t... Is>(std::index_sequence<Is...>)
         {
+            gen_arg_reader<typename traits::template arg_type<Is>...> args(gen);
             set_generic_return_by<typename traits::return_type>(
                 gen,
                 Function,
                 get_generic_auxiliary<typename traits::class_type*>(gen),
-                get_generic_arg<typename traits::template arg_type<Is>>(
-                    gen, static_cast<gen_idx_t>(Is)
-                )...,
+                args.template get<Is>()...,
                 this_(gen)
             );
         }(std::make_index_sequence<traits::arg_count::value - 1>());
@@ -344,41 +505,33 @@ class generic_wrapper_nontype
     template <typename VarType>
     static void var_type_wrapper_thiscall_objfirst(generic_pointer gen)
     {
-        static constexpr auto indices = gen_script_arg_idx<traits::arg_count_v - 1>(VarType{});
         [gen]<std::size_t... Is>(std::index_sequence<Is...>)
         {
+            basic_gen_arg_reader<VarType, typename traits::template arg_type<Is + 1>...> args(gen);
             set_generic_return_by<typename traits::return_type>(
                 gen,
                 Function,
                 get_generic_auxiliary<typename traits::class_type*>(gen),
                 this_(gen),
-                var_type_helper<typename traits::template arg_type<Is + 1>>( // Plus 1 to skip the "this_(gen)" argument
-                    var_type_tag<VarType, Is>{},
-                    gen,
-                    static_cast<gen_idx_t>(indices[Is])
-                )...
+                args.template get<Is>()...
             );
-        }(std::make_index_sequence<indices.size()>());
+        }(std::make_index_sequence<traits::arg_count_v - 1>());
     }
 
     template <typename VarType>
     static void var_type_wrapper_thiscall_objlast(generic_pointer gen)
     {
-        static constexpr auto indices = gen_script_arg_idx<traits::arg_count_v - 1>(VarType{});
         [gen]<std::size_t... Is>(std::index_sequence<Is...>)
         {
+            basic_gen_arg_reader<VarType, typename traits::template arg_type<Is>...> args(gen);
             set_generic_return_by<typename traits::return_type>(
                 gen,
                 Function,
                 get_generic_auxiliary<typename traits::class_type*>(gen),
-                var_type_helper<typename traits::template arg_type<Is>>(
-                    var_type_tag<VarType, Is>{},
-                    gen,
-                    indices[Is]
-                )...,
+                args.template get<Is>()...,
                 this_(gen)
             );
-        }(std::make_index_sequence<indices.size()>());
+        }(std::make_index_sequence<traits::arg_count_v - 1>());
     }
 
 public:
@@ -425,6 +578,58 @@ public:
     }
 };
 
+// Storage of function pointers for the generic wrappers shared by functions of the same signature
+template <auto Function>
+inline constexpr std::decay_t<decltype(Function)> shared_wrapper_target = Function;
+
+/**
+ * @brief Generic wrapper shared by all functions of the same signature
+ *
+ * The wrapped function is retrieved from the auxiliary pointer,
+ * which should point to the `shared_wrapper_target`.
+ */
+template <
+    typename FunctionType,
+    AS_NAMESPACE_QUALIFIER asECallConvTypes OriginalConv>
+requires(
+    OriginalConv == AS_NAMESPACE_QUALIFIER asCALL_THISCALL ||
+    OriginalConv == AS_NAMESPACE_QUALIFIER asCALL_CDECL_OBJFIRST ||
+    OriginalConv == AS_NAMESPACE_QUALIFIER asCALL_CDECL_OBJLAST ||
+    OriginalConv == AS_NAMESPACE_QUALIFIER asCALL_CDECL ||
+    OriginalConv == AS_NAMESPACE_QUALIFIER asCALL_STDCALL
+)
+class generic_wrapper_shared
+{
+    using function_type = FunctionType;
+    using traits = function_traits<function_type>;
+
+    static const function_type& target(generic_pointer gen)
+    {
+        return *static_cast<const function_type*>(gen->GetAuxiliary());
+    }
+
+    static decltype(auto) this_(generic_pointer gen)
+    {
+        return get_generic_this<function_type, OriginalConv>(gen);
+    }
+
+    ASBIND20_GENERIC_WRAPPER_IMPL(target(gen))
+
+public:
+    static constexpr auto generate() noexcept
+        -> AS_NAMESPACE_QUALIFIER asGENFUNC_t
+    {
+        if constexpr(OriginalConv == AS_NAMESPACE_QUALIFIER asCALL_THISCALL)
+            return &wrapper_thiscall;
+        else if constexpr(OriginalConv == AS_NAMESPACE_QUALIFIER asCALL_CDECL_OBJFIRST)
+            return &wrapper_objfirst;
+        else if constexpr(OriginalConv == AS_NAMESPACE_QUALIFIER asCALL_CDECL_OBJLAST)
+            return &wrapper_objlast;
+        else // OriginalConv == asCALL_CDECL || OriginalConv == asCALL_STDCALL
+            return &wrapper_general;
+    }
+};
+
 #undef ASBIND20_GENERIC_WRAPPER_IMPL
 #undef ASBIND20_GENERIC_WRAPPER_VAR_TYPE_IMPL
 
@@ -520,13 +725,12 @@ class generic_wrapper_composite<Function, composite_wrapper_nontype<Composite>>
     {
         [gen]<std::size_t... Is>(std::index_sequence<Is...>)
         {
+            gen_arg_reader<typename traits::template arg_type<Is>...> args(gen);
             set_generic_return_by<typename traits::return_type>(
                 gen,
                 Function,
                 this_(gen),
-                get_generic_arg<typename traits::template arg_type<Is>>(
-                    gen, static_cast<gen_idx_t>(Is)
-                )...
+                args.template get<Is>()...
             );
         }(std::make_index_sequence<traits::arg_count::value>());
     }
@@ -534,20 +738,16 @@ class generic_wrapper_composite<Function, composite_wrapper_nontype<Composite>>
     template <typename VarType>
     static void var_type_wrapper_comp(generic_pointer gen)
     {
-        static constexpr auto indices = gen_script_arg_idx<traits::arg_count_v>(VarType{});
         [gen]<std::size_t... Is>(std::index_sequence<Is...>)
         {
+            basic_gen_arg_reader<VarType, typename traits::template arg_type<Is>...> args(gen);
             set_generic_return_by<typename traits::return_type>(
                 gen,
                 Function,
                 this_(gen),
-                var_type_helper<typename traits::template arg_type<Is>>(
-                    var_type_tag<VarType, Is>{},
-                    gen,
-                    static_cast<gen_idx_t>(indices[Is])
-                )...
+                args.template get<Is>()...
             );
-        }(std::make_index_sequence<indices.size()>());
+        }(std::make_index_sequence<traits::arg_count_v>());
     }
 
 public:
@@ -599,6 +799,30 @@ consteval auto to_asGENFUNC_t(fp_wrapper<Function>, call_conv_t<OriginalCallConv
     return fp_to_asGENFUNC_t_impl<Function, OriginalCallConv>();
 }
 
+/**
+ * @brief Get the generic wrapper shared by all functions of the same signature
+ *
+ * The function should be registered with the auxiliary pointer returned by `shared_generic_aux`.
+ */
+template <
+    native_function auto Function,
+    AS_NAMESPACE_QUALIFIER asECallConvTypes OriginalCallConv>
+requires(OriginalCallConv != AS_NAMESPACE_QUALIFIER asCALL_GENERIC)
+consteval auto to_shared_asGENFUNC_t(fp_wrapper<Function>, call_conv_t<OriginalCallConv>)
+    -> AS_NAMESPACE_QUALIFIER asGENFUNC_t
+{
+    return generic_wrapper_shared<std::decay_t<decltype(Function)>, OriginalCallConv>::generate();
+}
+
+/**
+ * @brief Get the auxiliary pointer for the shared generic wrapper
+ */
+template <native_function auto Function>
+constexpr void* shared_generic_aux(fp_wrapper<Function>) noexcept
+{
+    return const_cast<std::decay_t<decltype(Function)>*>(&shared_wrapper_target<Function>);
+}
+
 template <
     noncapturing_native_lambda Lambda,
     AS_NAMESPACE_QUALIFIER asECallConvTypes OriginalCallConv,
@@ -663,66 +887,33 @@ class generic_wrapper_ctor_func
         return static_cast<Class*>(gen->GetObject());
     }
 
+    // Note: The hidden type information of templated classes is the first script argument,
+    // so it is read as an ordinary argument.
+
     static void wrapper_objfirst(generic_pointer gen)
     {
-        if constexpr(Template)
-        {
-            [gen]<std::size_t... Is>(std::index_sequence<Is...>)
-            {
-                std::invoke(
-                    ConstructorFunc,
-                    get_mem(gen),
-                    get_generic_typeinfo(gen),
-                    get_generic_arg<std::tuple_element_t<Is + 2, args_tuple>>(
-                        gen, static_cast<gen_idx_t>(Is) + 1
-                    )...
-                );
-            }(std::make_index_sequence<traits::arg_count_v - 2>());
-        }
-        else
+        [gen]<std::size_t... Is>(std::index_sequence<Is...>)
         {
-            [gen]<std::size_t... Is>(std::index_sequence<Is...>)
-            {
-                std::invoke(
-                    ConstructorFunc,
-                    get_mem(gen),
-                    get_generic_arg<std::tuple_element_t<Is + 1, args_tuple>>(
-                        gen, static_cast<gen_idx_t>(Is)
-                    )...
-                );
-            }(std::make_index_sequence<traits::arg_count_v - 1>());
-        }
+            gen_arg_reader<std::tuple_element_t<Is + 1, args_tuple>...> args(gen);
+            std::invoke(
+                ConstructorFunc,
+                get_mem(gen),
+                args.template get<Is>()...
+            );
+        }(std::make_index_sequence<traits::arg_count_v - 1>());
     }
 
     static void wrapper_objlast(generic_pointer gen)
     {
-        if constexpr(Template)
-        {
-            [gen]<std::size_t... Is>(std::index_sequence<Is...>)
-            {
-                std::invoke(
-                    ConstructorFunc,
-                    get_generic_typeinfo(gen),
-                    get_generic_arg<std::tuple_element_t<Is + 1, args_tuple>>(
-                        gen, static_cast<gen_idx_t>(Is) + 1
-                    )...,
-                    get_mem(gen)
-                );
-            }(std::make_index_sequence<traits::arg_count_v - 2>());
-        }
-        else
+        [gen]<std::size_t... Is>(std::index_sequence<Is...>)
         {
-            [gen]<std::size_t... Is>(std::index_sequence<Is...>)
-            {
-                std::invoke(
-                    ConstructorFunc,
-                    get_generic_arg<std::tuple_element_t<Is, args_tuple>>(
-                        gen, static_cast<gen_idx_t>(Is)
-                    )...,
-                    get_mem(gen)
-                );
-            }(std::make_index_sequence<traits::arg_count_v - 1>());
-        }
+            gen_arg_reader<std::tuple_element_t<Is, args_tuple>...> args(gen);
+            std::invoke(
+                ConstructorFunc,
+                args.template get<Is>()...,
+                get_mem(gen)
+            );
+        }(std::make_index_sequence<traits::arg_count_v - 1>());
     }
 
 public:
@@ -752,66 +943,33 @@ class generic_wrapper_ctor_lambda
         return static_cast<Class*>(gen->GetObject());
     }
 
+    // Note: The hidden type information of templated classes is the first script argument,
+    // so it is read as an ordinary argument.
+
     static void wrapper_objfirst(generic_pointer gen)
     {
-        if constexpr(Template)
-        {
-            [gen]<std::size_t... Is>(std::index_sequence<Is...>)
-            {
-                std::invoke(
-                    ConstructorLambda{},
-                    get_mem(gen),
-                    get_generic_typeinfo(gen),
-                    get_generic_arg<std::tuple_element_t<Is + 2, args_tuple>>(
-                        gen, static_cast<gen_idx_t>(Is) + 1
-                    )...
-                );
-            }(std::make_index_sequence<traits::arg_count_v - 2>());
-        }
-        else
+        [gen]<std::size_t... Is>(std::index_sequence<Is...>)
         {
-            [gen]<std::size_t... Is>(std::index_sequence<Is...>)
-            {
-                std::invoke(
-                    ConstructorLambda{},
-                    get_mem(gen),
-                    get_generic_arg<std::tuple_element_t<Is + 1, args_tuple>>(
-                        gen, static_cast<gen_idx_t>(Is)
-                    )...
-                );
-            }(std::make_index_sequence<traits::arg_count_v - 1>());
-        }
+            gen_arg_reader<std::tuple_element_t<Is + 1, args_tuple>...> args(gen);
+            std::invoke(
+                ConstructorLambda{},
+                get_mem(gen),
+                args.template get<Is>()...
+            );
+        }(std::make_index_sequence<traits::arg_count_v - 1>());
     }
 
     static void wrapper_objlast(generic_pointer gen)
     {
-        if constexpr(Template)
-        {
-            [gen]<std::size_t... Is>(std::index_sequence<Is...>)
-            {
-                std::invoke(
-                    ConstructorLambda{},
-                    get_generic_typeinfo(gen),
-                    get_generic_arg<std::tuple_element_t<Is + 1, args_tuple>>(
-                        gen, static_cast<gen_idx_t>(Is) + 1
-                    )...,
-                    get_mem(gen)
-                );
-            }(std::make_index_sequence<traits::arg_count_v - 2>());
-        }
-        else
+        [gen]<std::size_t... Is>(std::index_sequence<Is...>)
         {
-            [gen]<std::size_t... Is>(std::index_sequence<Is...>)
-            {
-                std::invoke(
-                    ConstructorLambda{},
-                    get_generic_arg<std::tuple_element_t<Is, args_tuple>>(
-                        gen, static_cast<gen_idx_t>(Is)
-                    )...,
-                    get_mem(gen)
-                );
-            }(std::make_index_sequence<traits::arg_count_v - 1>());
-        }
+            gen_arg_reader<std::tuple_element_t<Is, args_tuple>...> args(gen);
+            std::invoke(
+                ConstructorLambda{},
+                args.template get<Is>()...,
+                get_mem(gen)
+            );
+        }(std::make_index_sequence<traits::arg_count_v - 1>());
     }
 
 public:
@@ -958,60 +1116,12 @@ class generic_wrapper_factory_aux
         typename traits::first_arg_type,
         typename traits::last_arg_type>;
 
-    // For templated classes
-    static void* invoke_factory(generic_pointer gen)
-        requires(Template)
-    {
-        // Argument count except the typeinfo and auxiliary object
-        constexpr std::size_t user_arg_v =
-            OriginalCallConv == AS_NAMESPACE_QUALIFIER asCALL_THISCALL_ASGLOBAL ?
-                traits::arg_count_v - 1 :
-                traits::arg_count_v - 2;
-
-        return [gen]<std::size_t... Is>(std::index_sequence<Is...>) -> void*
-        {
-            if constexpr(OriginalCallConv == AS_NAMESPACE_QUALIFIER asCALL_THISCALL_ASGLOBAL)
-            {
-                return std::invoke(
-                    FactoryFunc,
-                    get_generic_auxiliary<typename traits::class_type>(gen),
-                    get_generic_typeinfo(gen),
-                    get_generic_arg<std::tuple_element_t<Is + 1, args_tuple>>(
-                        gen, static_cast<gen_idx_t>(Is) + 1
-                    )...
-                );
-            }
-            else if constexpr(OriginalCallConv == AS_NAMESPACE_QUALIFIER asCALL_CDECL_OBJFIRST)
-            {
-                return std::invoke(
-                    FactoryFunc,
-                    get_generic_auxiliary<auxiliary_type>(gen),
-                    get_generic_typeinfo(gen),
-                    get_generic_arg<std::tuple_element_t<Is + 2, args_tuple>>(
-                        gen, static_cast<gen_idx_t>(Is) + 1
-                    )...
-                );
-            }
-            else // OriginalCallConv == asCALL_CDECL_OBJLAST
-            {
-                return std::invoke(
-                    FactoryFunc,
-                    get_generic_typeinfo(gen),
-                    get_generic_arg<std::tuple_element_t<Is + 1, args_tuple>>(
-                        gen, static_cast<gen_idx_t>(Is) + 1
-                    )...,
-                    get_generic_auxiliary<auxiliary_type>(gen)
-                );
-            }
-        }(std::make_index_sequence<user_arg_v>());
-    }
-
-    // For non-templated classes
+    // Note: The hidden type information of templated classes is the first script argument,
+    // so it is read as an ordinary argument.
     static void* invoke_factory(generic_pointer gen)
-        requires(!Template)
     {
         // Argument count except the auxiliary object
-        constexpr std::size_t user_arg_v =
+        constexpr std::size_t script_arg_v =
             OriginalCallConv == AS_NAMESPACE_QUALIFIER asCALL_THISCALL_ASGLOBAL ?
                 traits::arg_count_v :
                 traits::arg_count_v - 1;
@@ -1020,36 +1130,33 @@ class generic_wrapper_factory_aux
         {
             if constexpr(OriginalCallConv == AS_NAMESPACE_QUALIFIER asCALL_THISCALL_ASGLOBAL)
             {
+                gen_arg_reader<std::tuple_element_t<Is, args_tuple>...> args(gen);
                 return std::invoke(
                     FactoryFunc,
                     get_generic_auxiliary<typename traits::class_type>(gen),
-                    get_generic_arg<std::tuple_element_t<Is, args_tuple>>(
-                        gen, static_cast<gen_idx_t>(Is)
-                    )...
+                    args.template get<Is>()...
                 );
             }
             else if constexpr(OriginalCallConv == AS_NAMESPACE_QUALIFIER asCALL_CDECL_OBJFIRST)
             {
+                // Plus 1 to skip the auxiliary object at the first position
+                gen_arg_reader<std::tuple_element_t<Is + 1, args_tuple>...> args(gen);
                 return std::invoke(
                     FactoryFunc,
                     get_generic_auxiliary<auxiliary_type>(gen),
-                    // Plus 1 to skip the auxiliary object at the first position
-                    get_generic_arg<std::tuple_element_t<Is + 1, args_tuple>>(
-                        gen, static_cast<gen_idx_t>(Is)
-                    )...
+                    args.template get<Is>()...
                 );
             }
             else // OriginalCallConv == asCALL_CDECL_OBJLAST
             {
+                gen_arg_reader<std::tuple_element_t<Is, args_tuple>...> args(gen);
                 return std::invoke(
                     FactoryFunc,
-                    get_generic_arg<std::tuple_element_t<Is, args_tuple>>(
-                        gen, static_cast<gen_idx_t>(Is)
-                    )...,
+                    args.template get<Is>()...,
                     get_generic_auxiliary<auxiliary_type>(gen)
                 );
             }
-        }(std::make_index_sequence<user_arg_v>());
+        }(std::make_index_sequence<script_arg_v>());
     }
 
     static void wrapper_impl(generic_pointer gen)
@@ -1233,11 +1340,10 @@ decltype(auto) apply_generic(Fn&& fn, generic_pointer gen)
 {
     return [&]<std::size_t... Is>(std::index_sequence<Is...>) -> decltype(auto)
     {
+        detail::gen_arg_reader<std::tuple_element_t<Is, ArgsTuple>...> args(gen);
         return std::invoke(
             std::forward<Fn>(fn),
-            get_generic_arg<std::tuple_element_t<Is, ArgsTuple>>(
-                gen, static_cast<detail::gen_idx_t>(Is)
-            )...
+            args.template get<Is>()...
         );
     }(std::make_index_sequence<std::tuple_size_v<ArgsTuple>>{});
 }
@@ -1247,12 +1353,11 @@ decltype(auto) apply_generic(Fn&& fn, Class&& obj, generic_pointer gen)
 {
     return [&]<std::size_t... Is>(std::index_sequence<Is...>) -> decltype(auto)
     {
+        detail::gen_arg_reader<std::tuple_element_t<Is, ArgsTuple>...> args(gen);
         return std::invoke(
             std::forward<Fn>(fn),
             std::forward<Class>(obj),
-            get_generic_arg<std::tuple_element_t<Is, ArgsTuple>>(
-                gen, static_cast<detail::gen_idx_t>(Is)
-            )...
+            args.template get<Is>()...
         );
     }(std::make_index_sequence<std::tuple_size_v<ArgsTuple>>{});
 }
@@ -28,13 +28,44 @@ class global final : public binding_generator_interface<ForceGeneric, Listener>
         AS_NAMESPACE_QUALIFIER asECallConvTypes conv,
         void* auxiliary = nullptr
     )
+    {
+        if constexpr(listener_traits_type::template can_wrap_generic<global, Fn>)
+        {
+            if(conv == AS_NAMESPACE_QUALIFIER asCALL_GENERIC)
+            {
+                AS_NAMESPACE_QUALIFIER asGENFUNC_t gfn = fn;
+                listener_traits_type::wrap_generic(this->get_listener(), *this, gfn, auxiliary);
+                register_function_impl(decl, detail::to_asSFuncPtr(gfn), conv, auxiliary);
+                return;
+            }
+        }
+
+        register_function_impl(decl, detail::to_asSFuncPtr(fn), conv, auxiliary);
+    }
+
+    void register_function_impl(
+        cstring_ref decl,
+        const AS_NAMESPACE_QUALIFIER asSFuncPtr& fptr,
+        AS_NAMESPACE_QUALIFIER asECallConvTypes conv,
+        void* auxiliary
+    )
     {
         int r = get_engine()->RegisterGlobalFunction(
             decl.c_str(),
-            detail::to_asSFuncPtr(fn),
+            fptr,
             conv,
             auxiliary
         );
+        this->record(
+            {
+                .kind = registration_kind::global_function,
+                .decl = decl.c_str(),
+                .func = fptr,
+                .call_conv = static_cast<AS_NAMESPACE_QUALIFIER asDWORD>(conv),
+                .pointer = auxiliary,
+            },
+            r
+        );
         listener_traits_type::on_function(this->get_listener(), *this, r);
     }
 
@@ -97,6 +128,9 @@ public:
         fp_wrapper<Function>
     )
     {
+#ifdef ASBIND20_CONFIG_SHARED_GENERIC_WRAPPERS
+        function(use_shared_generic, decl, fp<Function>);
+#else
         constexpr auto conv =
             detail::deduce_function_callconv<decltype(Function)>();
         this->register_function(
@@ -104,6 +138,32 @@ public:
             detail::to_asGENFUNC_t(fp<Function>, detail::cc<conv>),
             detail::generic_cc
         );
+#endif
+
+        return *this;
+    }
+
+    /**
+     * @brief Register a function by the generic wrapper shared by functions of the same signature
+     *
+     * @note The auxiliary pointer is used for passing the function to the shared wrapper.
+     */
+    template <auto Function>
+    requires(!std::is_member_function_pointer_v<decltype(Function)>)
+    global& function(
+        use_shared_generic_t,
+        cstring_ref decl,
+        fp_wrapper<Function>
+    )
+    {
+        constexpr auto conv =
+            detail::deduce_function_callconv<decltype(Function)>();
+        this->register_function(
+            decl,
+            detail::to_shared_asGENFUNC_t(fp<Function>, detail::cc<conv>),
+            detail::generic_cc,
+            detail::shared_generic_aux(fp<Function>)
+        );
 
         return *this;
     }
@@ -276,6 +336,14 @@ public:
             decl.c_str(),
             (void*)std::addressof(val)
         );
+        this->record(
+            {
+                .kind = registration_kind::global_property,
+                .decl = decl.c_str(),
+                .pointer = (void*)std::addressof(val),
+            },
+            r
+        );
         listener_traits_type::on_global_property(
             this->get_listener(), *this, r
         );
@@ -295,6 +363,13 @@ public:
         int r = get_engine()->RegisterFuncdef(
             decl.c_str()
         );
+        this->record(
+            {
+                .kind = registration_kind::funcdef,
+                .decl = decl.c_str(),
+            },
+            r
+        );
         listener_traits_type::on_funcdef(
             this->get_listener(), *this, r
         );
@@ -316,6 +391,14 @@ public:
             new_name.c_str(),
             type_decl.c_str()
         );
+        this->record(
+            {
+                .kind = registration_kind::typedef_,
+                .object = new_name.c_str(),
+                .decl = type_decl.c_str(),
+            },
+            r
+        );
         listener_traits_type::on_typedef(
             this->get_listener(), *this, r
         );
@@ -0,0 +1,361 @@
+/**
+ * @file bind/instrument.hpp
+ * @author HenryAWE
+ * @brief Call count and latency instrumentation for registered functions
+ */
+
+#ifndef ASBIND20_BIND_INSTRUMENT_HPP
+#define ASBIND20_BIND_INSTRUMENT_HPP
+
+#pragma once
+
+#include <cstdint>
+#include <atomic>
+#include <chrono>
+#include <memory>
+#include <mutex>
+#include <optional>
+#include <string>
+#include <string_view>
+#include <system_error>
+#include <vector>
+#include "../detail/include_as.hpp"
+#include "../detail/err_handler.hpp"
+#include "../detail/user_data.hpp"
+#include "../script_error.hpp"
+
+namespace asbind20
+{
+/**
+ * @brief Snapshot of the statistics of a function
+ */
+struct call_stats
+{
+    std::string declaration;
+    int func_id = 0;
+    std::uint64_t calls = 0;
+    std::uint64_t total_ns = 0;
+    std::uint64_t max_ns = 0;
+
+    [[nodiscard]]
+    double average_ns() const noexcept
+    {
+        if(calls == 0)
+            return 0.0;
+        return static_cast<double>(total_ns) / static_cast<double>(calls);
+    }
+};
+
+namespace detail
+{
+    struct call_counter
+    {
+        std::atomic_uint64_t calls = 0;
+        std::atomic_uint64_t total_ns = 0;
+        std::atomic_uint64_t max_ns = 0;
+
+        void record(std::uint64_t ns) noexcept
+        {
+            calls.fetch_add(1, std::memory_order_relaxed);
+            total_ns.fetch_add(ns, std::memory_order_relaxed);
+
+            std::uint64_t prev = max_ns.load(std::memory_order_relaxed);
+            while(prev < ns && !max_ns.compare_exchange_weak(prev, ns, std::memory_order_relaxed))
+            {}
+        }
+
+        void reset() noexcept
+        {
+            calls.store(0, std::memory_order_relaxed);
+            total_ns.store(0, std::memory_order_relaxed);
+            max_ns.store(0, std::memory_order_relaxed);
+        }
+    };
+
+    struct instrumented_function
+    {
+        AS_NAMESPACE_QUALIFIER asGENFUNC_t func;
+        int func_id = AS_NAMESPACE_QUALIFIER asERROR;
+        std::string declaration;
+        call_counter counter;
+    };
+
+    inline void instrumented_generic_thunk(AS_NAMESPACE_QUALIFIER asIScriptGeneric* gen)
+    {
+        auto* rec = static_cast<instrumented_function*>(gen->GetAuxiliary());
+
+        // Record the time even if the wrapped function throws
+        struct guard_t
+        {
+            instrumented_function* rec;
+            std::chrono::steady_clock::time_point start;
+
+            ~guard_t()
+            {
+                auto dur = std::chrono::steady_clock::now() - start;
+                rec->counter.record(static_cast<std::uint64_t>(
+                    std::chrono::duration_cast<std::chrono::nanoseconds>(dur).count()
+                ));
+            }
+        } guard{rec, std::chrono::steady_clock::now()};
+
+        rec->func(gen);
+    }
+} // namespace detail
+
+/**
+ * @brief Registry of call statistics of an engine
+ *
+ * The registry is stored in the user data of the engine, so it has the same lifetime as the engine.
+ */
+class call_stats_registry
+{
+public:
+    call_stats_registry() = default;
+    call_stats_registry(const call_stats_registry&) = delete;
+
+    call_stats_registry& operator=(const call_stats_registry&) = delete;
+
+    /**
+     * @brief Get the registry of an engine
+     *
+     * @return Null if no function of the engine has been instrumented
+     */
+    [[nodiscard]]
+    static call_stats_registry* get(const AS_NAMESPACE_QUALIFIER asIScriptEngine* engine)
+    {
+        if(!engine) [[unlikely]]
+            return nullptr;
+        return static_cast<call_stats_registry*>(
+            engine->GetUserData(detail::call_stats_user_data)
+        );
+    }
+
+    /**
+     * @brief Get the registry of an engine, creating it if it doesn't exist
+     */
+    static call_stats_registry& get_or_create(AS_NAMESPACE_QUALIFIER asIScriptEngine* engine)
+    {
+        ASBIND20_ASSERT(engine != nullptr);
+
+        if(auto* existing = get(engine))
+            return *existing;
+
+        auto* registry = new call_stats_registry();
+        engine->SetUserData(registry, detail::call_stats_user_data);
+        engine->SetEngineUserDataCleanupCallback(
+            [](AS_NAMESPACE_QUALIFIER asIScriptEngine* engine)
+            {
+                delete get(engine);
+            },
+            detail::call_stats_user_data
+        );
+        return *registry;
+    }
+
+    /**
+     * @brief Find statistics by the declaration reported by the engine
+     *
+     * @param decl Declaration in the format of `asIScriptFunction::GetDeclaration(true, true, false)`,
+     *             e.g., `int add(int, int)` or `float vec2::length() const`.
+     */
+    [[nodiscard]]
+    std::optional<call_stats> find(std::string_view decl) const
+    {
+        std::lock_guard lock(m_mx);
+        for(const auto& rec : m_records)
+        {
+            if(rec->declaration == decl)
+                return make_stats(*rec);
+        }
+
+        return std::nullopt;
+    }
+
+    /**
+     * @brief Find statistics by function ID
+     */
+    [[nodiscard]]
+    std::optional<call_stats> find(int func_id) const
+    {
+        std::lock_guard lock(m_mx);
+        for(const auto& rec : m_records)
+        {
+            if(rec->func_id == func_id)
+                return make_stats(*rec);
+        }
+
+        return std::nullopt;
+    }
+
+    /**
+     * @brief Get statistics of all instrumented functions
+     */
+    [[nodiscard]]
+    std::vector<call_stats> snapshot() const
+    {
+        std::lock_guard lock(m_mx);
+
+        std::vector<call_stats> result;
+        result.reserve(m_records.size());
+        for(const auto& rec : m_records)
+            result.push_back(make_stats(*rec));
+
+        return result;
+    }
+
+    /**
+     * @brief Reset all counters to zero
+     */
+    void reset() noexcept
+    {
+        std::lock_guard lock(m_mx);
+        for(auto& rec : m_records)
+            rec->counter.reset();
+    }
+
+    [[nodiscard]]
+    std::size_t size() const
+    {
+        std::lock_guard lock(m_mx);
+        return m_records.size();
+    }
+
+    /**
+     * @brief Create a record for a generic function to be registered
+     */
+    detail::instrumented_function* add(AS_NAMESPACE_QUALIFIER asGENFUNC_t func)
+    {
+        std::lock_guard lock(m_mx);
+        m_records.push_back(std::make_unique<detail::instrumented_function>());
+        m_records.back()->func = func;
+        return m_records.back().get();
+    }
+
+    /**
+     * @brief Bind a record to the result of registration
+     *
+     * @param rec Record created by `add()`
+     * @param engine Script engine
+     * @param id Result of registration. The record will be removed if it indicates an error.
+     */
+    void commit(
+        detail::instrumented_function* rec,
+        const AS_NAMESPACE_QUALIFIER asIScriptEngine* engine,
+        int id
+    )
+    {
+        std::lock_guard lock(m_mx);
+
+        auto* f = id >= 0 ? engine->GetFunctionById(id) : nullptr;
+        if(!f)
+        {
+            std::erase_if(
+                m_records,
+                [rec](const auto& p)
+                { return p.get() == rec; }
+            );
+            return;
+        }
+
+        rec->func_id = id;
+        rec->declaration = f->GetDeclaration(true, true, false);
+    }
+
+private:
+    mutable std::mutex m_mx;
+    std::vector<std::unique_ptr<detail::instrumented_function>> m_records;
+
+    static call_stats make_stats(const detail::instrumented_function& rec)
+    {
+        return {
+            rec.declaration,
+            rec.func_id,
+            rec.counter.calls.load(std::memory_order_relaxed),
+            rec.counter.total_ns.load(std::memory_order_relaxed),
+            rec.counter.max_ns.load(std::memory_order_relaxed)
+        };
+    }
+};
+
+/**
+ * @brief Listener for instrumenting registered functions
+ *
+ * Generic functions registered by binding generators with this listener are wrapped by a thunk
+ * counting calls and measuring the time spent in them.
+ * The statistics can be queried from `call_stats_registry::get(engine)`.
+ *
+ * @note Only functions using the generic calling convention without an auxiliary object can be instrumented.
+ *       Functions registered with a native calling convention, including native `fp<>` registrations,
+ *       are passed through untouched and won't appear in the statistics.
+ *       Register them with the generic calling convention instead, e.g., by `global<true, instrumenting_listener>`.
+ *
+ * @warning Forcing generic calling convention changes the call being measured.
+ *          The recorded latency includes the overhead of the generic wrapper,
+ *          so it overestimates the cost of the same function registered natively.
+ */
+class instrumenting_listener
+{
+public:
+    template <typename BindingGenerator>
+    void wrap_generic(
+        BindingGenerator& gen,
+        AS_NAMESPACE_QUALIFIER asGENFUNC_t& gfn,
+        void*& aux
+    )
+    {
+        // The wrapped function may need its auxiliary object
+        if(aux != nullptr || gfn == nullptr)
+            return;
+
+        auto& registry = call_stats_registry::get_or_create(gen.get_engine());
+        m_pending = registry.add(gfn);
+        gfn = &detail::instrumented_generic_thunk;
+        aux = m_pending;
+    }
+
+    template <typename BindingGenerator>
+    void on_function(BindingGenerator& gen, int id)
+    {
+        commit_pending(gen.get_engine(), id);
+        report_error(id, "bad function");
+    }
+
+    template <typename BindingGenerator>
+    void on_method(BindingGenerator& gen, int id)
+    {
+        commit_pending(gen.get_engine(), id);
+        report_error(id, "bad method");
+    }
+
+private:
+    detail::instrumented_function* m_pending = nullptr;
+
+    void commit_pending(AS_NAMESPACE_QUALIFIER asIScriptEngine* engine, int id)
+    {
+        if(!m_pending)
+            return;
+
+        call_stats_registry::get_or_create(engine).commit(m_pending, engine, id);
+        m_pending = nullptr;
+    }
+
+    static void report_error(
+        [[maybe_unused]] int id,
+        [[maybe_unused]] const char* what
+    )
+    {
+        if(id >= 0) [[likely]]
+            return;
+
+#ifndef ASBIND20_CONFIG_NO_THROW_ON_BAD_BINDING
+        auto code = static_cast<AS_NAMESPACE_QUALIFIER asERetCodes>(id);
+        ::asbind20::detail::throw_<std::system_error>(
+            make_error_code(code), what
+        );
+#endif
+    }
+};
+} // namespace asbind20
+
+#endif
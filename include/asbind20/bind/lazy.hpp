@@ -0,0 +1,378 @@
+/**
+ * @file bind/lazy.hpp
+ * @author HenryAWE
+ * @brief Registering members of types on demand
+ */
+
+#ifndef ASBIND20_BIND_LAZY_HPP
+#define ASBIND20_BIND_LAZY_HPP
+
+#pragma once
+
+#include <cstddef>
+#include <functional>
+#include <map>
+#include <string>
+#include <string_view>
+#include <initializer_list>
+#include <ranges>
+#include <unordered_map>
+#include <vector>
+#include "../detail/include_as.hpp"
+#include "../detail/err_handler.hpp"
+#include "../detail/user_data.hpp"
+#include "../ranges/tokenize_view.hpp"
+
+namespace asbind20
+{
+class lazy_registry;
+
+namespace detail
+{
+    /**
+     * @brief Entries of lazy registries that have been registered into an engine
+     */
+    class lazy_registry_state
+    {
+    public:
+        [[nodiscard]]
+        static lazy_registry_state* get(const AS_NAMESPACE_QUALIFIER asIScriptEngine* engine)
+        {
+            if(!engine) [[unlikely]]
+                return nullptr;
+            return static_cast<lazy_registry_state*>(
+                engine->GetUserData(lazy_registry_user_data)
+            );
+        }
+
+        static lazy_registry_state& get_or_create(AS_NAMESPACE_QUALIFIER asIScriptEngine* engine)
+        {
+            ASBIND20_ASSERT(engine != nullptr);
+
+            if(auto* existing = get(engine))
+                return *existing;
+
+            auto* state = new lazy_registry_state();
+            engine->SetUserData(state, lazy_registry_user_data);
+            engine->SetEngineUserDataCleanupCallback(
+                [](AS_NAMESPACE_QUALIFIER asIScriptEngine* engine)
+                {
+                    delete get(engine);
+                },
+                lazy_registry_user_data
+            );
+            return *state;
+        }
+
+        [[nodiscard]]
+        bool contains(const lazy_registry* reg, std::size_t idx) const
+        {
+            return get_status(reg, idx) == status::registered;
+        }
+
+        /**
+         * @brief Mark an entry as being registered
+         *
+         * @return False if the entry has been registered or is being registered
+         */
+        bool begin(const lazy_registry* reg, std::size_t idx)
+        {
+            status& s = status_of(reg, idx);
+            if(s != status::none)
+                return false;
+            s = status::in_progress;
+            return true;
+        }
+
+        /**
+         * @brief Finish registering an entry marked by `begin`
+         *
+         * @param success Entry will be marked as registered if succeeded. Otherwise, it can be registered again later.
+         */
+        void end(const lazy_registry* reg, std::size_t idx, bool success)
+        {
+            status& s = status_of(reg, idx);
+            ASBIND20_ASSERT(s == status::in_progress);
+            s = success ? status::registered : status::none;
+        }
+
+    private:
+        enum class status : unsigned char
+        {
+            none = 0,
+            in_progress,
+            registered
+        };
+
+        std::unordered_map<const lazy_registry*, std::vector<status>> m_status;
+
+        [[nodiscard]]
+        status get_status(const lazy_registry* reg, std::size_t idx) const
+        {
+            auto it = m_status.find(reg);
+            if(it == m_status.end() || it->second.size() <= idx)
+                return status::none;
+            return it->second[idx];
+        }
+
+        status& status_of(const lazy_registry* reg, std::size_t idx)
+        {
+            std::vector<status>& flags = m_status[reg];
+            if(flags.size() <= idx)
+                flags.resize(idx + 1, status::none);
+            return flags[idx];
+        }
+    };
+} // namespace detail
+
+/**
+ * @brief Table of registrations deferred until they are needed by scripts
+ *
+ * Declare the types eagerly, then add their members to the registry.
+ * Before building a module, call `prepare` with the script code or `require` with the names needed by the module.
+ * Only the entries of needed names and their dependencies will be registered.
+ *
+ * The registry can be shared by multiple engines. Registered entries are recorded in the user data of each engine.
+ *
+ * @code{.cpp}
+ * // Declaration of the type is registered immediately
+ * value_class<vec3>(engine, "vec3", flags)
+ *     .behaviours_by_traits();
+ *
+ * static lazy_registry reg;
+ * reg.add(
+ *     "vec3",
+ *     [](asIScriptEngine* engine)
+ *     {
+ *         // Append members to the declared type
+ *         value_class<vec3>(appending, engine, "vec3")
+ *             .method("float length() const", fp<&vec3::length>);
+ *     }
+ * );
+ *
+ * reg.prepare(engine, script_code);
+ * // Build the module ...
+ * @endcode
+ *
+ * @note Behaviours checked by the engine when building, e.g., AddRef/Release of reference types,
+ *       should be registered with the declaration instead of being deferred.
+ *
+ * @note The registry must outlive the engines it has been used with.
+ */
+class lazy_registry
+{
+public:
+    using register_function_t = void (*)(AS_NAMESPACE_QUALIFIER asIScriptEngine*);
+
+    lazy_registry() = default;
+
+    // The address of registry is used for identifying its entries in engines
+    lazy_registry(const lazy_registry&) = delete;
+    lazy_registry& operator=(const lazy_registry&) = delete;
+
+    /**
+     * @brief Add deferred registrations
+     *
+     * @param name Name that triggers the registration, usually the name of the type
+     * @param fn Function for registering
+     * @param deps Names needed by the registered members, e.g., types returned by methods.
+     *             They will be registered before this entry.
+     */
+    lazy_registry& add(
+        std::string name,
+        register_function_t fn,
+        std::initializer_list<std::string_view> deps = {}
+    )
+    {
+        ASBIND20_ASSERT(fn != nullptr);
+        ASBIND20_ASSERT(!contains(name));
+
+        entry e;
+        e.fn = fn;
+        e.deps.reserve(deps.size());
+        for(std::string_view d : deps)
+            e.deps.emplace_back(d);
+
+        m_index.emplace(std::move(name), m_entries.size());
+        m_entries.push_back(std::move(e));
+
+        return *this;
+    }
+
+    [[nodiscard]]
+    bool contains(std::string_view name) const
+    {
+        return m_index.find(name) != m_index.end();
+    }
+
+    [[nodiscard]]
+    std::size_t size() const noexcept
+    {
+        return m_entries.size();
+    }
+
+    /**
+     * @brief Check if the entry of a name has been registered into an engine
+     */
+    [[nodiscard]]
+    bool is_registered(const AS_NAMESPACE_QUALIFIER asIScriptEngine* engine, std::string_view name) const
+    {
+        auto it = m_index.find(name);
+        if(it == m_index.end())
+            return false;
+
+        auto* state = detail::lazy_registry_state::get(engine);
+        return state && state->contains(this, it->second);
+    }
+
+    /**
+     * @brief Register the entry of a name and its dependencies if they haven't been registered
+     *
+     * @return Count of newly registered entries, or `asNO_FUNCTION` if the name is unknown
+     */
+    int require(AS_NAMESPACE_QUALIFIER asIScriptEngine* engine, std::string_view name) const
+    {
+        ASBIND20_ASSERT(engine != nullptr);
+
+        auto it = m_index.find(name);
+        if(it == m_index.end()) [[unlikely]]
+            return AS_NAMESPACE_QUALIFIER asNO_FUNCTION;
+
+        return require_entry(
+            engine, detail::lazy_registry_state::get_or_create(engine), it->second
+        );
+    }
+
+    /**
+     * @brief Register the entries needed by a module
+     *
+     * @return Count of newly registered entries, or `asNO_FUNCTION` if any name is unknown.
+     *         Known names are registered even if there is an unknown one.
+     */
+    template <std::ranges::input_range R>
+    requires std::convertible_to<std::ranges::range_reference_t<R>, std::string_view>
+    int require(AS_NAMESPACE_QUALIFIER asIScriptEngine* engine, R&& names) const
+    {
+        int count = 0;
+        bool unknown = false;
+        for(std::string_view name : names)
+        {
+            int r = require(engine, name);
+            if(r < 0)
+                unknown = true;
+            else
+                count += r;
+        }
+
+        return unknown ? AS_NAMESPACE_QUALIFIER asNO_FUNCTION : count;
+    }
+
+    int require(
+        AS_NAMESPACE_QUALIFIER asIScriptEngine* engine,
+        std::initializer_list<std::string_view> names
+    ) const
+    {
+        return require<std::initializer_list<std::string_view>>(engine, std::move(names));
+    }
+
+    /**
+     * @brief Register the entries whose names appear as identifiers in the script code
+     *
+     * @return Count of newly registered entries
+     */
+    int prepare(AS_NAMESPACE_QUALIFIER asIScriptEngine* engine, std::string_view code) const
+    {
+        ASBIND20_ASSERT(engine != nullptr);
+
+        if(m_entries.empty())
+            return 0;
+
+        auto& state = detail::lazy_registry_state::get_or_create(engine);
+
+        int count = 0;
+        for(auto&& [tc, token] : ranges::tokenize_view(engine, code))
+        {
+            if(tc != AS_NAMESPACE_QUALIFIER asTC_IDENTIFIER)
+                continue;
+
+            auto it = m_index.find(token);
+            if(it == m_index.end())
+                continue;
+            count += require_entry(engine, state, it->second);
+        }
+
+        return count;
+    }
+
+    /**
+     * @brief Register all entries, e.g., for generating the documentation of full interface
+     *
+     * @return Count of newly registered entries
+     */
+    int require_all(AS_NAMESPACE_QUALIFIER asIScriptEngine* engine) const
+    {
+        ASBIND20_ASSERT(engine != nullptr);
+
+        auto& state = detail::lazy_registry_state::get_or_create(engine);
+
+        int count = 0;
+        for(std::size_t i = 0; i < m_entries.size(); ++i)
+            count += require_entry(engine, state, i);
+        return count;
+    }
+
+private:
+    struct entry
+    {
+        register_function_t fn;
+        std::vector<std::string> deps;
+    };
+
+    std::vector<entry> m_entries;
+    std::map<std::string, std::size_t, std::less<>> m_index;
+
+    int require_entry(
+        AS_NAMESPACE_QUALIFIER asIScriptEngine* engine,
+        detail::lazy_registry_state& state,
+        std::size_t idx
+    ) const
+    {
+        // The "in progress" mark stops the circular dependencies
+        if(!state.begin(this, idx))
+            return 0;
+
+        // Clear the mark if any registration throws, so the entry can be retried later
+        struct end_guard
+        {
+            const lazy_registry* reg;
+            detail::lazy_registry_state& state;
+            std::size_t idx;
+            bool success = false;
+
+            ~end_guard()
+            {
+                state.end(reg, idx, success);
+            }
+        } guard{this, state, idx};
+
+        const entry& e = m_entries[idx];
+
+        int count = 1;
+        for(const std::string& d : e.deps)
+        {
+            auto it = m_index.find(d);
+            // Dependencies should be added into the same registry
+            ASBIND20_ASSERT(it != m_index.end());
+            if(it == m_index.end()) [[unlikely]]
+                continue;
+            count += require_entry(engine, state, it->second);
+        }
+
+        e.fn(engine);
+        guard.success = true;
+        return count;
+    }
+};
+} // namespace asbind20
+
+#endif
@@ -3,6 +3,8 @@
 
 #pragma once
 
+#include <cstdint>
+#include <concepts>
 #include <utility>
 #include "../detail/err_handler.hpp"
 #include "../detail/include_as.hpp"
@@ -16,6 +18,53 @@ namespace asbind20
 class default_listener
 {};
 
+/**
+ * @brief Kind of registration
+ */
+enum class registration_kind : std::uint8_t
+{
+    object_type,
+    object_method,
+    object_behaviour,
+    object_property,
+    global_function,
+    global_property,
+    funcdef,
+    typedef_,
+    enum_,
+    enum_value,
+    interface_,
+    interface_method,
+    string_factory,
+    default_array_type
+};
+
+/**
+ * @brief Arguments passed to a registration interface of AngelScript
+ *
+ * The meaning of members depends on the kind of registration:
+ * - `object`: Name of the object type, interface or enum. The new name of a typedef.
+ * - `decl`: Declaration. The name of an enum value. The aliased type of a typedef. The underlying type of an enum.
+ * - `pointer`: Auxiliary object of functions. The address of a global property. The string factory.
+ * - `value`: Size of an object type. Offset of an object property. Value of an enum value.
+ *
+ * @note The pointers are only valid during the registration.
+ */
+struct registration_record
+{
+    registration_kind kind;
+    const char* object = nullptr;
+    const char* decl = nullptr;
+    AS_NAMESPACE_QUALIFIER asSFuncPtr func{};
+    AS_NAMESPACE_QUALIFIER asDWORD call_conv = 0;
+    void* pointer = nullptr;
+    AS_NAMESPACE_QUALIFIER asEBehaviours behaviour = AS_NAMESPACE_QUALIFIER asBEHAVE_CONSTRUCT;
+    AS_NAMESPACE_QUALIFIER asQWORD flags = 0;
+    AS_NAMESPACE_QUALIFIER asINT64 value = 0;
+    int comp_offset = 0;
+    bool comp_indirect = false;
+};
+
 template <typename Listener>
 class listener_traits
 {
@@ -49,6 +98,51 @@ public:
 
 #undef ASBIND20_IMPL_LISTENER_GENERAL_FUNC
 
+    /**
+     * @brief Check if the listener can replace generic functions before they are registered
+     */
+    template <typename BindingGenerator, typename Fn>
+    static constexpr bool can_wrap_generic =
+        std::convertible_to<Fn, AS_NAMESPACE_QUALIFIER asGENFUNC_t> &&
+        requires(Listener& listener, BindingGenerator& gen, AS_NAMESPACE_QUALIFIER asGENFUNC_t& gfn, void*& aux) {
+            listener.wrap_generic(gen, gfn, aux);
+        };
+
+    /**
+     * @brief Let the listener replace a generic function and its auxiliary object before registering it
+     */
+    template <typename BindingGenerator>
+    static void wrap_generic(
+        Listener& listener,
+        BindingGenerator& gen,
+        AS_NAMESPACE_QUALIFIER asGENFUNC_t& gfn,
+        void*& aux
+    )
+    {
+        listener.wrap_generic(gen, gfn, aux);
+    }
+
+    /**
+     * @brief Let the listener record arguments of a registration
+     *
+     * @param rec Arguments of the registration
+     * @param id Result of the registration
+     */
+    template <typename BindingGenerator>
+    static void record(
+        Listener& listener,
+        BindingGenerator& gen,
+        const registration_record& rec,
+        int id
+    )
+    {
+        constexpr bool has_func = requires() {
+            listener.record(gen, rec, id);
+        };
+        if constexpr(has_func)
+            listener.record(gen, rec, id);
+    }
+
 private:
     static void default_fallback(
         [[maybe_unused]] int val,
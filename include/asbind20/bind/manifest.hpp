@@ -0,0 +1,343 @@
+/**
+ * @file bind/manifest.hpp
+ * @author HenryAWE
+ * @brief Recording registrations of binding generators for replaying them into other engines
+ */
+
+#ifndef ASBIND20_BIND_MANIFEST_HPP
+#define ASBIND20_BIND_MANIFEST_HPP
+
+#pragma once
+
+#include <cstdint>
+#include <string>
+#include <string_view>
+#include <vector>
+#include "../detail/include_as.hpp"
+#include "../detail/err_handler.hpp"
+#include "../detail/compat.hpp"
+#include "../detail/user_data.hpp"
+#include "listener.hpp"
+
+namespace asbind20
+{
+/**
+ * @brief Compact table of registrations, which can be replayed into other engines
+ *
+ * Replaying a manifest calls the registration interfaces of AngelScript in a loop,
+ * skipping the binding generators and their listeners.
+ * Entries are replayed in the recorded order, so the dependencies between registered types are kept.
+ *
+ * @note Function pointers, auxiliary objects, addresses of global properties, and string factories are recorded as is.
+ *       They will be shared by all engines the manifest is replayed into, so they must outlive those engines.
+ *       For example, the auxiliary objects created by `instrumenting_listener` belong to a single engine,
+ *       thus they cannot be replayed.
+ */
+class interface_manifest
+{
+public:
+    interface_manifest() = default;
+    interface_manifest(const interface_manifest&) = default;
+    interface_manifest(interface_manifest&&) noexcept = default;
+
+    interface_manifest& operator=(const interface_manifest&) = default;
+    interface_manifest& operator=(interface_manifest&&) noexcept = default;
+
+    /**
+     * @brief Get the manifest recorded by `recording_listener` for an engine
+     *
+     * @return Null if nothing has been recorded
+     */
+    [[nodiscard]]
+    static interface_manifest* get(const AS_NAMESPACE_QUALIFIER asIScriptEngine* engine)
+    {
+        if(!engine) [[unlikely]]
+            return nullptr;
+        return static_cast<interface_manifest*>(
+            engine->GetUserData(detail::interface_manifest_user_data)
+        );
+    }
+
+    /**
+     * @brief Get the manifest of an engine, creating it if it doesn't exist
+     */
+    static interface_manifest& get_or_create(AS_NAMESPACE_QUALIFIER asIScriptEngine* engine)
+    {
+        ASBIND20_ASSERT(engine != nullptr);
+
+        if(auto* existing = get(engine))
+            return *existing;
+
+        auto* manifest = new interface_manifest();
+        engine->SetUserData(manifest, detail::interface_manifest_user_data);
+        engine->SetEngineUserDataCleanupCallback(
+            [](AS_NAMESPACE_QUALIFIER asIScriptEngine* engine)
+            {
+                delete get(engine);
+            },
+            detail::interface_manifest_user_data
+        );
+        return *manifest;
+    }
+
+    /**
+     * @brief Add a registration to the end of the manifest
+     *
+     * @param rec Arguments of the registration
+     * @param ns Default namespace of the engine when registering
+     */
+    void add(const registration_record& rec, std::string_view ns)
+    {
+        entry e;
+        e.kind = rec.kind;
+        e.behaviour = rec.behaviour;
+        e.comp_indirect = rec.comp_indirect;
+        e.call_conv = rec.call_conv;
+        e.ns = m_last_ns = store_cached(ns, m_last_ns);
+        // Successive registrations usually share the same object
+        e.object = rec.object ? (m_last_object = store_cached(rec.object, m_last_object)) : npos;
+        e.decl = rec.decl ? store(rec.decl) : npos;
+        e.comp_offset = rec.comp_offset;
+        e.func = rec.func;
+        e.pointer = rec.pointer;
+        e.flags = rec.flags;
+        e.value = rec.value;
+
+        m_entries.push_back(e);
+    }
+
+    /**
+     * @brief Issue all recorded registrations to an engine
+     *
+     * The default namespace of the engine will be restored after replaying.
+     *
+     * @return `asSUCCESS` or the error code of the first failed registration. Replaying stops at the first error.
+     */
+    int replay(AS_NAMESPACE_QUALIFIER asIScriptEngine* engine) const
+    {
+        ASBIND20_ASSERT(engine != nullptr);
+
+        const std::string prev_ns = engine->GetDefaultNamespace();
+
+        int result = AS_NAMESPACE_QUALIFIER asSUCCESS;
+        std::uint32_t current_ns = npos;
+        for(const entry& e : m_entries)
+        {
+            if(e.ns != current_ns)
+            {
+                result = engine->SetDefaultNamespace(str(e.ns));
+                if(result < 0) [[unlikely]]
+                    break;
+                current_ns = e.ns;
+            }
+
+            int r = replay_entry(engine, e);
+            if(r < 0) [[unlikely]]
+            {
+                result = r;
+                break;
+            }
+            result = AS_NAMESPACE_QUALIFIER asSUCCESS;
+        }
+
+        engine->SetDefaultNamespace(prev_ns.c_str());
+        return result;
+    }
+
+    [[nodiscard]]
+    std::size_t size() const noexcept
+    {
+        return m_entries.size();
+    }
+
+    [[nodiscard]]
+    bool empty() const noexcept
+    {
+        return m_entries.empty();
+    }
+
+    /**
+     * @brief Count recorded registrations of a kind
+     */
+    [[nodiscard]]
+    std::size_t count(registration_kind kind) const noexcept
+    {
+        std::size_t n = 0;
+        for(const entry& e : m_entries)
+        {
+            if(e.kind == kind)
+                ++n;
+        }
+        return n;
+    }
+
+    void clear() noexcept
+    {
+        m_entries.clear();
+        m_strings.clear();
+        m_last_ns = npos;
+        m_last_object = npos;
+    }
+
+private:
+    static constexpr std::uint32_t npos = static_cast<std::uint32_t>(-1);
+
+    struct entry
+    {
+        registration_kind kind;
+        AS_NAMESPACE_QUALIFIER asEBehaviours behaviour;
+        bool comp_indirect;
+        AS_NAMESPACE_QUALIFIER asDWORD call_conv;
+        // Offsets in the string buffer
+        std::uint32_t ns;
+        std::uint32_t object;
+        std::uint32_t decl;
+        int comp_offset;
+        AS_NAMESPACE_QUALIFIER asSFuncPtr func;
+        void* pointer;
+        AS_NAMESPACE_QUALIFIER asQWORD flags;
+        AS_NAMESPACE_QUALIFIER asINT64 value;
+    };
+
+    std::vector<entry> m_entries;
+    // Null-terminated strings stored one after another
+    std::string m_strings;
+    std::uint32_t m_last_ns = npos;
+    std::uint32_t m_last_object = npos;
+
+    std::uint32_t store(std::string_view sv)
+    {
+        auto off = static_cast<std::uint32_t>(m_strings.size());
+        m_strings.append(sv);
+        m_strings.push_back('\0');
+        return off;
+    }
+
+    std::uint32_t store_cached(std::string_view sv, std::uint32_t cached)
+    {
+        if(cached != npos && sv == std::string_view(str(cached)))
+            return cached;
+        return store(sv);
+    }
+
+    [[nodiscard]]
+    const char* str(std::uint32_t off) const noexcept
+    {
+        if(off == npos)
+            return nullptr;
+        return m_strings.c_str() + off;
+    }
+
+    int replay_entry(AS_NAMESPACE_QUALIFIER asIScriptEngine* engine, const entry& e) const
+    {
+        switch(e.kind)
+        {
+        case registration_kind::object_type:
+            return engine->RegisterObjectType(
+                str(e.object), static_cast<int>(e.value), e.flags
+            );
+
+        case registration_kind::object_method:
+            return engine->RegisterObjectMethod(
+                str(e.object),
+                str(e.decl),
+                e.func,
+                e.call_conv,
+                e.pointer,
+                e.comp_offset,
+                e.comp_indirect
+            );
+
+        case registration_kind::object_behaviour:
+            return engine->RegisterObjectBehaviour(
+                str(e.object),
+                e.behaviour,
+                str(e.decl),
+                e.func,
+                e.call_conv,
+                e.pointer
+            );
+
+        case registration_kind::object_property:
+            return engine->RegisterObjectProperty(
+                str(e.object),
+                str(e.decl),
+                static_cast<int>(e.value),
+                e.comp_offset,
+                e.comp_indirect
+            );
+
+        case registration_kind::global_function:
+            return engine->RegisterGlobalFunction(
+                str(e.decl), e.func, e.call_conv, e.pointer
+            );
+
+        case registration_kind::global_property:
+            return engine->RegisterGlobalProperty(str(e.decl), e.pointer);
+
+        case registration_kind::funcdef:
+            return engine->RegisterFuncdef(str(e.decl));
+
+        case registration_kind::typedef_:
+            return engine->RegisterTypedef(str(e.object), str(e.decl));
+
+        case registration_kind::enum_:
+#ifdef ASBIND20_HAS_ENUM_UNDERLYING_TYPE
+            return engine->RegisterEnum(str(e.object), str(e.decl));
+#else
+            return engine->RegisterEnum(str(e.object));
+#endif
+
+        case registration_kind::enum_value:
+            return engine->RegisterEnumValue(
+                str(e.object),
+                str(e.decl),
+                static_cast<compat::script_enum_value_type>(e.value)
+            );
+
+        case registration_kind::interface_:
+            return engine->RegisterInterface(str(e.object));
+
+        case registration_kind::interface_method:
+            return engine->RegisterInterfaceMethod(str(e.object), str(e.decl));
+
+        case registration_kind::string_factory:
+            return engine->RegisterStringFactory(
+                str(e.object),
+                static_cast<AS_NAMESPACE_QUALIFIER asIStringFactory*>(e.pointer)
+            );
+
+        case registration_kind::default_array_type:
+            return engine->RegisterDefaultArrayType(str(e.object));
+        }
+
+        return AS_NAMESPACE_QUALIFIER asINVALID_ARG;
+    }
+};
+
+/**
+ * @brief Listener for recording registrations into an `interface_manifest`
+ *
+ * The manifest is stored in the user data of the engine and can be retrieved by `interface_manifest::get(engine)`.
+ * Failed registrations are not recorded.
+ *
+ * @note Registrations issued without binding generators, e.g., by calling the engine directly, are not recorded.
+ */
+class recording_listener
+{
+public:
+    template <typename BindingGenerator>
+    void record(BindingGenerator& gen, const registration_record& rec, int id)
+    {
+        if(id < 0)
+            return;
+
+        AS_NAMESPACE_QUALIFIER asIScriptEngine* engine = gen.get_engine();
+        interface_manifest::get_or_create(engine).add(
+            rec, engine->GetDefaultNamespace()
+        );
+    }
+};
+} // namespace asbind20
+
+#endif
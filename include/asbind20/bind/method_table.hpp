@@ -0,0 +1,88 @@
+/**
+ * @file bind/method_table.hpp
+ * @author HenryAWE
+ * @brief Table of methods for registering them in bulk
+ */
+
+#ifndef ASBIND20_BIND_METHOD_TABLE_HPP
+#define ASBIND20_BIND_METHOD_TABLE_HPP
+
+#pragma once
+
+#include "../detail/include_as.hpp"
+#include "../utility.hpp"
+#include "common.hpp"
+#include "genfunc.hpp"
+
+namespace asbind20
+{
+/**
+ * @brief Entry of a method table
+ *
+ * All information for registering the method is calculated at compile time,
+ * so the table can be declared as a `constexpr` array.
+ * Wrappers are shared by methods of the same signature.
+ *
+ * @tparam Class Registered class
+ *
+ * @code{.cpp}
+ * static constexpr method_entry<my_class> my_methods[]{
+ *     {"int get() const", fp<&my_class::get>},
+ *     {"void set(int val)", fp<&my_class::set>},
+ * };
+ *
+ * value_class<my_class>(engine, "my_class")
+ *     // ...
+ *     .methods(my_methods);
+ * @endcode
+ */
+template <typename Class>
+struct method_entry
+{
+    using native_ptr_fn = AS_NAMESPACE_QUALIFIER asSFuncPtr (*)(const void*);
+
+    /**
+     * @brief Declaration in AngelScript
+     */
+    const char* decl;
+    /**
+     * @brief Address of the function pointer
+     */
+    const void* target;
+    /**
+     * @brief Get the function pointer for the native calling convention
+     */
+    native_ptr_fn native;
+    /**
+     * @brief Native calling convention
+     */
+    AS_NAMESPACE_QUALIFIER asECallConvTypes conv;
+    /**
+     * @brief Generic wrapper, which retrieves the function from the auxiliary pointer
+     */
+    AS_NAMESPACE_QUALIFIER asGENFUNC_t generic;
+
+    template <auto Method>
+    consteval method_entry(const char* decl, fp_wrapper<Method>)
+        : decl(decl),
+          target(detail::shared_generic_aux(fp<Method>)),
+          native(&native_ptr<std::decay_t<decltype(Method)>>),
+          conv(detail::deduce_method_callconv<Class, std::decay_t<decltype(Method)>>()),
+          generic(
+              detail::to_shared_asGENFUNC_t(
+                  fp<Method>,
+                  detail::cc<detail::deduce_method_callconv<Class, std::decay_t<decltype(Method)>>()>
+              )
+          )
+    {}
+
+private:
+    template <typename FunctionType>
+    static AS_NAMESPACE_QUALIFIER asSFuncPtr native_ptr(const void* target)
+    {
+        return detail::to_asSFuncPtr(*static_cast<const FunctionType*>(target));
+    }
+};
+} // namespace asbind20
+
+#endif
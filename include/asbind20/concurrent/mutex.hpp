@@ -8,6 +8,8 @@
 #include <shared_mutex>
 // IWYU pragma: end_exports
 #include "../detail/include_as.hpp"
+#include "../detail/err_handler.hpp"
+#include "../detail/user_data.hpp"
 
 namespace asbind20
 {
@@ -59,6 +61,116 @@ public:
  * @brief Global lock of AngelScript library
  */
 inline constexpr script_lock_t script_lock = {};
+
+/**
+ * @brief Lock of a single script engine
+ *
+ * The lock is stored in the user data of engine,
+ * so operations on independent engines won't contend with each other like using the global `script_lock`.
+ *
+ * @code{.cpp}
+ * {
+ *     std::unique_lock lk(asbind20::engine_local_lock::get(engine));
+ *     // Writing data shared by the engine
+ * }
+ * @endcode
+ */
+class engine_local_lock
+{
+public:
+    engine_local_lock() = default;
+    engine_local_lock(const engine_local_lock&) = delete;
+
+    engine_local_lock& operator=(const engine_local_lock&) = delete;
+
+    /**
+     * @brief Get the lock of an engine, creating it if it doesn't exist
+     *
+     * @note Only the creation is guarded by the global lock, which happens once for each engine.
+     */
+    static engine_local_lock& get(AS_NAMESPACE_QUALIFIER asIScriptEngine* engine)
+    {
+        ASBIND20_ASSERT(engine != nullptr);
+
+        if(auto* existing = find(engine)) [[likely]]
+            return *existing;
+
+        std::lock_guard lk(script_lock);
+
+        // Another thread may have created the lock while this thread was waiting
+        if(auto* existing = find(engine))
+            return *existing;
+
+        auto* created = new engine_local_lock();
+        engine->SetEngineUserDataCleanupCallback(
+            [](AS_NAMESPACE_QUALIFIER asIScriptEngine* engine)
+            {
+                delete find(engine);
+            },
+            detail::engine_local_lock_user_data
+        );
+        engine->SetUserData(created, detail::engine_local_lock_user_data);
+        return *created;
+    }
+
+    /**
+     * @brief Locks the mutex, blocks if the mutex is not available
+     */
+    void lock()
+    {
+        m_mx.lock();
+    }
+
+    /**
+     * @brief Tries to lock the mutex
+     */
+    bool try_lock()
+    {
+        return m_mx.try_lock();
+    }
+
+    /**
+     * @brief Unlocks the mutex
+     */
+    void unlock()
+    {
+        m_mx.unlock();
+    }
+
+    /**
+     * @brief Locks the mutex for shared ownership, blocks if the mutex is not available
+     */
+    void lock_shared()
+    {
+        m_mx.lock_shared();
+    }
+
+    /**
+     * @brief Tries to lock the mutex for shared ownership
+     */
+    bool try_lock_shared()
+    {
+        return m_mx.try_lock_shared();
+    }
+
+    /**
+     * @brief Unlocks the mutex (shared ownership)
+     */
+    void unlock_shared()
+    {
+        m_mx.unlock_shared();
+    }
+
+private:
+    std::shared_mutex m_mx;
+
+    static engine_local_lock* find(const AS_NAMESPACE_QUALIFIER asIScriptEngine* engine)
+    {
+        return static_cast<engine_local_lock*>(
+            engine->GetUserData(detail::engine_local_lock_user_data)
+        );
+    }
+};
 } // namespace asbind20
 
 #endif
@@ -0,0 +1,139 @@
+/**
+ * @file concurrent/template_cache.hpp
+ * @author HenryAWE
+ * @brief Cache of precomputed data for instances of template types
+ */
+
+#ifndef ASBIND20_CONCURRENT_TEMPLATE_CACHE_HPP
+#define ASBIND20_CONCURRENT_TEMPLATE_CACHE_HPP
+
+#pragma once
+
+#include <concepts>
+#include <functional>
+#include <mutex>
+#include <type_traits>
+#include "../detail/include_as.hpp"
+#include "../detail/err_handler.hpp"
+#include "mutex.hpp"
+
+namespace asbind20
+{
+/**
+ * @brief Cache of data attached to instances of template types
+ *
+ * The data, e.g., element size, flags, and comparators of the subtype, is computed once for each template instance
+ * and stored in the user data of the type info.
+ * Looking up the cached data only acquires the shared lock of the engine for reading the user data,
+ * and the initialization is guarded by the `engine_local_lock` instead of the global lock of AngelScript.
+ *
+ * The cached data will be destroyed with the type info.
+ *
+ * @tparam T Type of cached data
+ *
+ * @code{.cpp}
+ * struct array_info
+ * {
+ *     explicit array_info(asITypeInfo* ti);
+ *
+ *     int elem_type_id;
+ *     std::size_t elem_size;
+ * };
+ *
+ * static bool array_template_callback(asITypeInfo* ti, bool& no_gc)
+ * {
+ *     auto& info = template_instance_cache<array_info>::get_or_create(ti);
+ *     // ...
+ * }
+ * @endcode
+ */
+template <typename T>
+class template_instance_cache
+{
+public:
+    using value_type = T;
+
+    template_instance_cache() = delete;
+
+    /**
+     * @brief Type of user data for storing the cached data
+     *
+     * The address of a static variable is used as the type, so different caches won't collide with each other.
+     */
+    [[nodiscard]]
+    static AS_NAMESPACE_QUALIFIER asPWORD user_data_type() noexcept
+    {
+        return reinterpret_cast<AS_NAMESPACE_QUALIFIER asPWORD>(&user_data_tag);
+    }
+
+    /**
+     * @brief Get the cached data of a template instance
+     *
+     * @return Null if the data hasn't been created
+     */
+    [[nodiscard]]
+    static T* get(const AS_NAMESPACE_QUALIFIER asITypeInfo* ti)
+    {
+        if(!ti) [[unlikely]]
+            return nullptr;
+        return static_cast<T*>(ti->GetUserData(user_data_type()));
+    }
+
+    /**
+     * @brief Get the cached data of a template instance, creating it by the initializer if it doesn't exist
+     *
+     * @param init Initializer returning the data, which is invoked at most once for each template instance
+     *
+     * @warning The engine lock is held when invoking the initializer,
+     *          so the initializer must not create cached data of other template instances of the same engine.
+     */
+    template <typename Initializer>
+    requires std::is_invocable_r_v<T, Initializer, AS_NAMESPACE_QUALIFIER asITypeInfo*>
+    static T& get_or_create(AS_NAMESPACE_QUALIFIER asITypeInfo* ti, Initializer&& init)
+    {
+        ASBIND20_ASSERT(ti != nullptr);
+
+        if(T* existing = get(ti)) [[likely]]
+            return *existing;
+
+        std::lock_guard lock(engine_local_lock::get(ti->GetEngine()));
+
+        // Another thread may have created the data while this thread was waiting for the lock
+        if(T* existing = get(ti))
+            return *existing;
+
+        T* data = new T(std::invoke(std::forward<Initializer>(init), ti));
+        ti->GetEngine()->SetTypeInfoUserDataCleanupCallback(
+            &cleanup, user_data_type()
+        );
+        ti->SetUserData(data, user_data_type());
+
+        return *data;
+    }
+
+    /**
+     * @brief Get the cached data of a template instance, constructing it from the type info if it doesn't exist
+     */
+    static T& get_or_create(AS_NAMESPACE_QUALIFIER asITypeInfo* ti)
+    requires std::constructible_from<T, AS_NAMESPACE_QUALIFIER asITypeInfo*>
+    {
+        return get_or_create(
+            ti,
+            [](AS_NAMESPACE_QUALIFIER asITypeInfo* ti)
+            {
+                return T(ti);
+            }
+        );
+    }
+
+private:
+    static inline const char user_data_tag = 0;
+
+    static void cleanup(AS_NAMESPACE_QUALIFIER asITypeInfo* ti)
+    {
+        delete get(ti);
+    }
+};
+} // namespace asbind20
+
+#endif
@@ -0,0 +1,376 @@
+/**
+ * @file debugging/analysis.hpp
+ * @author HenryAWE
+ * @brief Static analysis of byte code
+ */
+
+#ifndef ASBIND20_DEBUGGING_ANALYSIS_HPP
+#define ASBIND20_DEBUGGING_ANALYSIS_HPP
+
+#pragma once
+
+#include <cstddef>
+#include <array>
+#include <algorithm>
+#include <ostream>
+#include <string>
+#include <string_view>
+#include <vector>
+#include "../detail/include_as.hpp"
+#include "../detail/byte_code.hpp"
+#include "../detail/json.hpp"
+#include "../debugging.hpp"
+
+namespace asbind20::debugging
+{
+/**
+ * @brief Count of each instruction, indexed by `asEBCInstr`
+ */
+using opcode_histogram = std::array<std::size_t, 256>;
+
+/**
+ * @brief Loop detected by a backward jump
+ */
+struct loop_info
+{
+    /// Position of the first instruction in the loop, in DWORDs
+    std::size_t begin;
+    /// Position after the backward jump, in DWORDs
+    std::size_t end;
+    /// Count of instructions in the loop body
+    std::size_t instructions;
+    /// Nesting depth. Zero means an outermost loop.
+    std::size_t depth;
+};
+
+/**
+ * @brief Kind of edge in the call graph
+ */
+enum class call_kind
+{
+    script,
+    native,
+    virtual_
+};
+
+struct call_edge
+{
+    AS_NAMESPACE_QUALIFIER asIScriptFunction* callee;
+    call_kind kind;
+    /// Count of call sites in the caller
+    std::size_t count;
+};
+
+/**
+ * @brief Analysis result of a script function
+ */
+struct function_analysis
+{
+    AS_NAMESPACE_QUALIFIER asIScriptFunction* func;
+    std::string declaration;
+    std::string section;
+
+    /// Size of byte code in DWORDs
+    std::size_t length = 0;
+    std::size_t instructions = 0;
+    std::vector<call_edge> calls;
+    std::vector<loop_info> loops;
+
+    /**
+     * @brief Estimated cost of executing the function once
+     *
+     * Every instruction costs one. Each instruction inside loops is multiplied by `loop_weight` for every level of nesting.
+     */
+    double estimated_cost = 0;
+};
+
+/**
+ * @brief Analysis result of a module
+ */
+struct module_analysis
+{
+    opcode_histogram histogram{};
+    std::vector<function_analysis> functions;
+
+    /**
+     * @brief Write the report as JSON
+     */
+    void write_json(std::ostream& os) const
+    {
+        using asbind20::detail::write_json_string;
+
+        os << "{\"opcodes\":{";
+        bool first = true;
+        for(std::size_t i = 0; i < histogram.size(); ++i)
+        {
+            if(histogram[i] == 0)
+                continue;
+            if(!first)
+                os << ',';
+            first = false;
+            write_json_string(os, AS_NAMESPACE_QUALIFIER asBCInfo[i].name);
+            os << ':' << histogram[i];
+        }
+        os << "},\"functions\":[";
+
+        for(std::size_t i = 0; i < functions.size(); ++i)
+        {
+            const auto& f = functions[i];
+            if(i != 0)
+                os << ',';
+
+            os << "{\"declaration\":";
+            write_json_string(os, f.declaration);
+            os << ",\"section\":";
+            write_json_string(os, f.section);
+            os << ",\"length\":" << f.length
+               << ",\"instructions\":" << f.instructions
+               << ",\"estimated_cost\":" << f.estimated_cost
+               << ",\"calls\":[";
+            for(std::size_t j = 0; j < f.calls.size(); ++j)
+            {
+                const auto& c = f.calls[j];
+                if(j != 0)
+                    os << ',';
+                os << "{\"callee\":";
+                write_json_string(os, c.callee->GetDeclaration(true, true, false));
+                os << ",\"kind\":\"" << kind_name(c.kind) << "\",\"count\":" << c.count << '}';
+            }
+            os << "],\"loops\":[";
+            for(std::size_t j = 0; j < f.loops.size(); ++j)
+            {
+                const auto& l = f.loops[j];
+                if(j != 0)
+                    os << ',';
+                os << "{\"begin\":" << l.begin
+                   << ",\"end\":" << l.end
+                   << ",\"instructions\":" << l.instructions
+                   << ",\"depth\":" << l.depth << '}';
+            }
+            os << "]}";
+        }
+
+        os << "]}";
+    }
+
+    /**
+     * @brief Write per-function statistics as CSV
+     */
+    void write_csv(std::ostream& os) const
+    {
+        os << "declaration,section,length,instructions,loops,script_calls,native_calls,virtual_calls,estimated_cost\n";
+        for(const auto& f : functions)
+        {
+            std::size_t counts[3] = {0, 0, 0};
+            for(const auto& c : f.calls)
+                counts[static_cast<std::size_t>(c.kind)] += c.count;
+
+            write_csv_field(os, f.declaration);
+            os << ',';
+            write_csv_field(os, f.section);
+            os << ',' << f.length
+               << ',' << f.instructions
+               << ',' << f.loops.size()
+               << ',' << counts[0]
+               << ',' << counts[1]
+               << ',' << counts[2]
+               << ',' << f.estimated_cost
+               << '\n';
+        }
+    }
+
+    /**
+     * @brief Write the opcode histogram as CSV
+     */
+    void write_histogram_csv(std::ostream& os) const
+    {
+        os << "opcode,count\n";
+        for(std::size_t i = 0; i < histogram.size(); ++i)
+        {
+            if(histogram[i] != 0)
+                os << AS_NAMESPACE_QUALIFIER asBCInfo[i].name << ',' << histogram[i] << '\n';
+        }
+    }
+
+private:
+    static const char* kind_name(call_kind k) noexcept
+    {
+        switch(k)
+        {
+        case call_kind::script:
+            return "script";
+        case call_kind::native:
+            return "native";
+        case call_kind::virtual_:
+            return "virtual";
+        }
+
+        return "unknown";
+    }
+
+    static void write_csv_field(std::ostream& os, std::string_view str)
+    {
+        os.put('"');
+        for(char c : str)
+        {
+            if(c == '"')
+                os.put('"');
+            os.put(c);
+        }
+        os.put('"');
+    }
+};
+
+/**
+ * @brief Analyze the byte code of a script function
+ *
+ * @param func Script function
+ * @param loop_weight Assumed iteration count of loops for estimating cost
+ * @param histogram Opcode histogram to be accumulated. Can be nullptr.
+ */
+inline function_analysis analyze_function(
+    AS_NAMESPACE_QUALIFIER asIScriptFunction* func,
+    double loop_weight = 10.0,
+    opcode_histogram* histogram = nullptr
+)
+{
+    function_analysis result;
+    result.func = func;
+    if(!func) [[unlikely]]
+        return result;
+
+    result.declaration = func->GetDeclaration(true, true, false);
+    if(const char* section = get_function_section_name(func))
+        result.section = section;
+
+    auto* engine = func->GetEngine();
+    auto bc = asbind20::detail::get_byte_code(func);
+    result.length = bc.size();
+
+    // Position of every instruction, for counting instructions in loops
+    std::vector<std::size_t> positions;
+    asbind20::detail::for_each_instruction(
+        bc,
+        [&](const AS_NAMESPACE_QUALIFIER asDWORD* instr, std::size_t pos)
+        {
+            positions.push_back(pos);
+            const auto op = asbind20::detail::bc_op(instr);
+            if(histogram)
+                ++(*histogram)[op];
+
+            std::size_t target;
+            if(asbind20::detail::bc_jump_target(instr, pos, target) && target <= pos)
+            {
+                const std::size_t end = pos + asbind20::detail::bc_size(op);
+                // Multiple backward jumps to the same position (e.g., "continue") belong to the same loop
+                auto it = std::ranges::find(result.loops, target, &loop_info::begin);
+                if(it != result.loops.end())
+                    it->end = std::max(it->end, end);
+                else
+                    result.loops.push_back({target, end, 0, 0});
+            }
+
+            auto* callee = asbind20::detail::bc_referenced_function(engine, instr);
+            if(!callee || op == AS_NAMESPACE_QUALIFIER asBC_FuncPtr)
+                return;
+
+            call_kind kind;
+            switch(callee->GetFuncType())
+            {
+            case AS_NAMESPACE_QUALIFIER asFUNC_SYSTEM:
+                kind = call_kind::native;
+                break;
+            case AS_NAMESPACE_QUALIFIER asFUNC_VIRTUAL:
+            case AS_NAMESPACE_QUALIFIER asFUNC_INTERFACE:
+                kind = call_kind::virtual_;
+                break;
+            default:
+                kind = call_kind::script;
+                break;
+            }
+
+            auto it = std::ranges::find(result.calls, callee, &call_edge::callee);
+            if(it != result.calls.end())
+                ++it->count;
+            else
+                result.calls.push_back({callee, kind, 1});
+        }
+    );
+    result.instructions = positions.size();
+
+    auto count_in = [&](std::size_t begin, std::size_t end)
+    {
+        return static_cast<std::size_t>(
+            std::ranges::lower_bound(positions, end) - std::ranges::lower_bound(positions, begin)
+        );
+    };
+
+    for(auto& l : result.loops)
+    {
+        l.instructions = count_in(l.begin, l.end);
+        l.depth = static_cast<std::size_t>(std::ranges::count_if(
+            result.loops,
+            [&l](const loop_info& outer)
+            {
+                return &outer != &l &&
+                       outer.begin <= l.begin &&
+                       l.end <= outer.end &&
+                       (outer.end - outer.begin) > (l.end - l.begin);
+            }
+        ));
+    }
+
+    // Each instruction is weighted by the loops containing it
+    double cost = 0;
+    for(std::size_t pos : positions)
+    {
+        double weight = 1;
+        for(const auto& l : result.loops)
+        {
+            if(l.begin <= pos && pos < l.end)
+                weight *= loop_weight;
+        }
+        cost += weight;
+    }
+    result.estimated_cost = cost;
+
+    return result;
+}
+
+/**
+ * @brief Analyze all script functions of a module
+ *
+ * Including global functions, methods of script classes, and initializers of global variables.
+ *
+ * @param m Script module
+ * @param loop_weight Assumed iteration count of loops for estimating cost
+ */
+inline module_analysis analyze_module(
+    AS_NAMESPACE_QUALIFIER asIScriptModule* m,
+    double loop_weight = 10.0
+)
+{
+    module_analysis result;
+    if(!m) [[unlikely]]
+        return result;
+
+    auto* engine = m->GetEngine();
+    const int last_id = engine->GetLastFunctionId();
+    for(int id = 0; id <= last_id; ++id)
+    {
+        auto* f = engine->GetFunctionById(id);
+        if(!f || f->GetModule() != m)
+            continue;
+        if(f->GetFuncType() != AS_NAMESPACE_QUALIFIER asFUNC_SCRIPT)
+            continue;
+
+        result.functions.push_back(
+            analyze_function(f, loop_weight, &result.histogram)
+        );
+    }
+
+    return result;
+}
+} // namespace asbind20::debugging
+
+#endif
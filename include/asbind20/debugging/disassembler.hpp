@@ -0,0 +1,916 @@
+/**
+ * @file debugging/disassembler.hpp
+ * @author HenryAWE
+ * @brief Byte code disassembler with symbolic operands
+ */
+
+#ifndef ASBIND20_DEBUGGING_DISASSEMBLER_HPP
+#define ASBIND20_DEBUGGING_DISASSEMBLER_HPP
+
+#pragma once
+
+#include <cstddef>
+#include <cstdint>
+#include <cstring>
+#include <algorithm>
+#include <atomic>
+#include <charconv>
+#include <ostream>
+#include <span>
+#include <string>
+#include <string_view>
+#include <thread>
+#include <vector>
+#include "../detail/include_as.hpp"
+#include "../detail/byte_code.hpp"
+#include "../debugging.hpp"
+
+namespace asbind20::debugging
+{
+namespace detail
+{
+    /**
+     * @brief Writer of a fixed buffer. Output exceeding the buffer will be truncated.
+     */
+    class fixed_writer
+    {
+    public:
+        explicit fixed_writer(std::span<char> buf) noexcept
+            : m_begin(buf.data()), m_cur(buf.data()), m_end(buf.data() + buf.size()) {}
+
+        void put(char c) noexcept
+        {
+            if(m_cur != m_end)
+                *m_cur++ = c;
+        }
+
+        void append(std::string_view str) noexcept
+        {
+            const std::size_t n = std::min(str.size(), static_cast<std::size_t>(m_end - m_cur));
+            std::memcpy(m_cur, str.data(), n);
+            m_cur += n;
+        }
+
+        template <typename T>
+        void append_number(T val) noexcept
+        {
+            auto r = std::to_chars(m_cur, m_end, val);
+            if(r.ec == std::errc())
+                m_cur = r.ptr;
+        }
+
+        void append_hex(std::uint64_t val) noexcept
+        {
+            append("0x");
+            auto r = std::to_chars(m_cur, m_end, val, 16);
+            if(r.ec == std::errc())
+                m_cur = r.ptr;
+        }
+
+        /**
+         * @brief Pad with spaces until the column
+         */
+        void pad_to(std::size_t col) noexcept
+        {
+            while(size() < col && m_cur != m_end)
+                *m_cur++ = ' ';
+        }
+
+        [[nodiscard]]
+        std::size_t size() const noexcept
+        {
+            return static_cast<std::size_t>(m_cur - m_begin);
+        }
+
+    private:
+        char* m_begin;
+        char* m_cur;
+        char* m_end;
+    };
+} // namespace detail
+
+/**
+ * @brief Symbol tables of a script function for disassembling
+ *
+ * All symbols referenced by the byte code are resolved when constructing,
+ * so disassembling instructions won't allocate memory.
+ */
+class function_symbols
+{
+public:
+    explicit function_symbols(AS_NAMESPACE_QUALIFIER asIScriptFunction* func)
+        : m_func(func)
+    {
+        if(!func) [[unlikely]]
+            return;
+
+        m_bc = asbind20::detail::get_byte_code(func);
+        load_variables();
+        load_lines();
+        load_references();
+    }
+
+    /**
+     * @brief A source line and the position of its first instruction
+     */
+    struct line_entry
+    {
+        /// Position in DWORDs
+        std::size_t pos;
+        int row;
+        int col;
+        const char* section;
+    };
+
+    [[nodiscard]]
+    AS_NAMESPACE_QUALIFIER asIScriptFunction* get_function() const noexcept
+    {
+        return m_func;
+    }
+
+    [[nodiscard]]
+    std::span<const AS_NAMESPACE_QUALIFIER asDWORD> byte_code() const noexcept
+    {
+        return m_bc;
+    }
+
+    /**
+     * @brief Source lines sorted by position
+     */
+    [[nodiscard]]
+    std::span<const line_entry> lines() const noexcept
+    {
+        return m_lines;
+    }
+
+    /**
+     * @brief Get the name of the variable at the stack offset
+     *
+     * @return Empty string if the offset is not a named variable, e.g., a temporary variable
+     */
+    [[nodiscard]]
+    std::string_view variable(int offset) const noexcept
+    {
+        return lookup(symbol_kind::variable, static_cast<std::uint64_t>(static_cast<std::int64_t>(offset)));
+    }
+
+    /**
+     * @brief Get the declaration of a function by its ID
+     */
+    [[nodiscard]]
+    std::string_view function(int id) const noexcept
+    {
+        return lookup(symbol_kind::function_id, static_cast<std::uint64_t>(id));
+    }
+
+    /**
+     * @brief Get the declaration of a function by its address
+     */
+    [[nodiscard]]
+    std::string_view function(AS_NAMESPACE_QUALIFIER asPWORD ptr) const noexcept
+    {
+        return lookup(symbol_kind::function_ptr, ptr);
+    }
+
+    /**
+     * @brief Get the name of a type by its ID
+     */
+    [[nodiscard]]
+    std::string_view type(int type_id) const noexcept
+    {
+        return lookup(symbol_kind::type_id, static_cast<std::uint64_t>(type_id));
+    }
+
+    /**
+     * @brief Get the name of a type by the address of its type information
+     */
+    [[nodiscard]]
+    std::string_view type(AS_NAMESPACE_QUALIFIER asPWORD ptr) const noexcept
+    {
+        return lookup(symbol_kind::type_ptr, ptr);
+    }
+
+    /**
+     * @brief Get the declaration of a global variable by its address
+     */
+    [[nodiscard]]
+    std::string_view global(AS_NAMESPACE_QUALIFIER asPWORD ptr) const noexcept
+    {
+        return lookup(symbol_kind::global, ptr);
+    }
+
+private:
+    enum class symbol_kind : std::uint8_t
+    {
+        variable,
+        function_id,
+        function_ptr,
+        type_id,
+        type_ptr,
+        global
+    };
+
+    struct symbol
+    {
+        symbol_kind kind;
+        std::uint64_t key;
+        std::size_t offset;
+        std::size_t length;
+
+        friend bool operator<(const symbol& lhs, const symbol& rhs) noexcept
+        {
+            if(lhs.kind != rhs.kind)
+                return lhs.kind < rhs.kind;
+            return lhs.key < rhs.key;
+        }
+    };
+
+    AS_NAMESPACE_QUALIFIER asIScriptFunction* m_func;
+    std::span<const AS_NAMESPACE_QUALIFIER asDWORD> m_bc;
+    std::vector<line_entry> m_lines;
+    std::vector<symbol> m_symbols;
+    std::string m_pool;
+
+    std::string_view lookup(symbol_kind kind, std::uint64_t key) const noexcept
+    {
+        const symbol probe{kind, key, 0, 0};
+        auto it = std::lower_bound(m_symbols.begin(), m_symbols.end(), probe);
+        if(it == m_symbols.end() || it->kind != kind || it->key != key)
+            return {};
+        return std::string_view(m_pool).substr(it->offset, it->length);
+    }
+
+    bool contains(symbol_kind kind, std::uint64_t key) const noexcept
+    {
+        return std::ranges::any_of(
+            m_symbols,
+            [&](const symbol& s)
+            { return s.kind == kind && s.key == key; }
+        );
+    }
+
+    void add(symbol_kind kind, std::uint64_t key, std::string_view str)
+    {
+        if(str.empty() || contains(kind, key))
+            return;
+
+        m_symbols.push_back({kind, key, m_pool.size(), str.size()});
+        m_pool.append(str);
+    }
+
+    void add(symbol_kind kind, std::uint64_t key, const char* str)
+    {
+        if(str)
+            add(kind, key, std::string_view(str));
+    }
+
+    void load_variables()
+    {
+#if ANGELSCRIPT_VERSION >= 23800
+        const AS_NAMESPACE_QUALIFIER asUINT count = m_func->GetVarCount();
+        for(AS_NAMESPACE_QUALIFIER asUINT i = 0; i < count; ++i)
+        {
+            const char* name = nullptr;
+            int offset = 0;
+            if(m_func->GetVar(i, &name, nullptr, nullptr, nullptr, &offset) < 0)
+                continue;
+            // Variables in different scopes may share the same offset. The first one wins.
+            add(symbol_kind::variable, static_cast<std::uint64_t>(static_cast<std::int64_t>(offset)), name);
+        }
+#endif
+    }
+
+    void load_lines()
+    {
+#if ANGELSCRIPT_VERSION >= 23800
+        const AS_NAMESPACE_QUALIFIER asUINT count = m_func->GetLineEntryCount();
+        m_lines.reserve(count);
+        for(AS_NAMESPACE_QUALIFIER asUINT i = 0; i < count; ++i)
+        {
+            line_entry entry{};
+            const AS_NAMESPACE_QUALIFIER asDWORD* ptr = nullptr;
+            if(m_func->GetLineEntry(i, &entry.row, &entry.col, &entry.section, &ptr) < 0 || !ptr)
+                continue;
+            entry.pos = static_cast<std::size_t>(ptr - m_bc.data());
+            m_lines.push_back(entry);
+        }
+        std::ranges::sort(m_lines, {}, &line_entry::pos);
+#endif
+    }
+
+    void add_global(AS_NAMESPACE_QUALIFIER asIScriptEngine* engine, AS_NAMESPACE_QUALIFIER asPWORD ptr)
+    {
+        if(contains(symbol_kind::global, ptr))
+            return;
+
+        if(auto* m = m_func->GetModule())
+        {
+            const AS_NAMESPACE_QUALIFIER asUINT count = m->GetGlobalVarCount();
+            for(AS_NAMESPACE_QUALIFIER asUINT i = 0; i < count; ++i)
+            {
+                if(reinterpret_cast<AS_NAMESPACE_QUALIFIER asPWORD>(m->GetAddressOfGlobalVar(i)) == ptr)
+                {
+                    add(symbol_kind::global, ptr, m->GetGlobalVarDeclaration(i, true));
+                    return;
+                }
+            }
+        }
+
+        const AS_NAMESPACE_QUALIFIER asUINT count = engine->GetGlobalPropertyCount();
+        for(AS_NAMESPACE_QUALIFIER asUINT i = 0; i < count; ++i)
+        {
+            const char* name = nullptr;
+            const char* ns = nullptr;
+            void* addr = nullptr;
+            engine->GetGlobalPropertyByIndex(i, &name, &ns, nullptr, nullptr, nullptr, &addr);
+            if(reinterpret_cast<AS_NAMESPACE_QUALIFIER asPWORD>(addr) != ptr || !name)
+                continue;
+
+            std::string decl;
+            if(ns && *ns)
+            {
+                decl += ns;
+                decl += "::";
+            }
+            decl += name;
+            add(symbol_kind::global, ptr, decl);
+            return;
+        }
+    }
+
+    void add_type_ptr(AS_NAMESPACE_QUALIFIER asPWORD ptr)
+    {
+        auto* ti = reinterpret_cast<AS_NAMESPACE_QUALIFIER asITypeInfo*>(ptr);
+        if(!ti || contains(symbol_kind::type_ptr, ptr))
+            return;
+        add(symbol_kind::type_ptr, ptr, ti->GetEngine()->GetTypeDeclaration(ti->GetTypeId(), true));
+    }
+
+    void load_references()
+    {
+#ifdef AS_USE_NAMESPACE
+        // Workaround for macros
+        // See: https://github.com/anjo76/angelscript/issues/36
+        using namespace AngelScript;
+#endif
+
+        auto* engine = m_func->GetEngine();
+
+        asbind20::detail::for_each_instruction(
+            m_bc,
+            [&](const AS_NAMESPACE_QUALIFIER asDWORD* instr, std::size_t)
+            {
+                const auto op = asbind20::detail::bc_op(instr);
+                switch(op)
+                {
+                case AS_NAMESPACE_QUALIFIER asBC_CALL:
+                case AS_NAMESPACE_QUALIFIER asBC_CALLINTF:
+                case AS_NAMESPACE_QUALIFIER asBC_CALLSYS:
+                case AS_NAMESPACE_QUALIFIER asBC_Thiscall1:
+                case AS_NAMESPACE_QUALIFIER asBC_ALLOC:
+                    if(auto* f = asbind20::detail::bc_referenced_function(engine, instr))
+                    {
+                        const int id = f->GetId();
+                        if(!contains(symbol_kind::function_id, static_cast<std::uint64_t>(id)))
+                            add(symbol_kind::function_id, static_cast<std::uint64_t>(id), f->GetDeclaration(true, true, false));
+                    }
+                    if(op == AS_NAMESPACE_QUALIFIER asBC_ALLOC)
+                        add_type_ptr(asBC_PTRARG(instr));
+                    break;
+
+                case AS_NAMESPACE_QUALIFIER asBC_FuncPtr:
+                    if(auto* f = asbind20::detail::bc_referenced_function(engine, instr))
+                    {
+                        if(!contains(symbol_kind::function_ptr, asBC_PTRARG(instr)))
+                            add(symbol_kind::function_ptr, asBC_PTRARG(instr), f->GetDeclaration(true, true, false));
+                    }
+                    break;
+
+                case AS_NAMESPACE_QUALIFIER asBC_FREE:
+                case AS_NAMESPACE_QUALIFIER asBC_REFCPY:
+                case AS_NAMESPACE_QUALIFIER asBC_OBJTYPE:
+                case AS_NAMESPACE_QUALIFIER asBC_RefCpyV:
+                    add_type_ptr(asBC_PTRARG(instr));
+                    break;
+
+                case AS_NAMESPACE_QUALIFIER asBC_COPY:
+                case AS_NAMESPACE_QUALIFIER asBC_Cast:
+                case AS_NAMESPACE_QUALIFIER asBC_TYPEID:
+                    {
+                        const int type_id = asBC_INTARG(instr);
+                        if(!contains(symbol_kind::type_id, static_cast<std::uint64_t>(type_id)))
+                            add(symbol_kind::type_id, static_cast<std::uint64_t>(type_id), engine->GetTypeDeclaration(type_id, true));
+                    }
+                    break;
+
+                default:
+                    if(void* addr = asbind20::detail::bc_referenced_global(instr))
+                        add_global(engine, reinterpret_cast<AS_NAMESPACE_QUALIFIER asPWORD>(addr));
+                    break;
+                }
+            }
+        );
+
+        std::sort(m_symbols.begin(), m_symbols.end());
+    }
+};
+
+/**
+ * @brief Options of disassembling
+ */
+struct disasm_options
+{
+    /// Resolve variables, functions, types, and global variables to their names
+    bool symbolic = true;
+    /// Annotate source lines before the first instruction of each line
+    bool lines = true;
+    /// Prefix instructions with their positions in DWORDs
+    bool positions = true;
+};
+
+/**
+ * @brief Disassemble an instruction into a buffer
+ *
+ * This function won't allocate memory.
+ * Output exceeding the buffer will be truncated.
+ * A buffer of 256 characters is enough for most instructions.
+ *
+ * @param buf Output buffer. The result is not null-terminated.
+ * @param syms Symbols of the function containing the instruction
+ * @param pos Position of the instruction in DWORDs
+ * @param opts Options
+ *
+ * @return Count of characters written
+ */
+inline std::size_t disassemble_instruction(
+    std::span<char> buf,
+    const function_symbols& syms,
+    std::size_t pos,
+    const disasm_options& opts = disasm_options()
+)
+{
+    using asbind20::detail::bc_op;
+    using asbind20::detail::bc_ptr_size;
+
+#ifdef AS_USE_NAMESPACE
+    // Workaround for macros
+    // See: https://github.com/anjo76/angelscript/issues/36
+    using namespace AngelScript;
+#endif
+
+    detail::fixed_writer out(buf);
+    const auto bc = syms.byte_code();
+    if(pos >= bc.size()) [[unlikely]]
+        return 0;
+
+    const asDWORD* instr = bc.data() + pos;
+    const auto op = bc_op(instr);
+    const auto& info = asBCInfo[op];
+
+    if(opts.positions)
+    {
+        char num[16];
+        auto r = std::to_chars(num, num + sizeof(num), pos);
+        const std::size_t len = static_cast<std::size_t>(r.ptr - num);
+        for(std::size_t i = len; i < 5; ++i)
+            out.put(' ');
+        out.append(std::string_view(num, len));
+        out.append(": ");
+    }
+
+    const std::size_t name_begin = out.size();
+    out.append(info.name);
+    out.pad_to(name_begin + 10);
+
+    auto var = [&](short offset)
+    {
+        out.put('v');
+        out.append_number(offset);
+        if(opts.symbolic)
+        {
+            auto name = syms.variable(offset);
+            if(!name.empty())
+            {
+                out.put(':');
+                out.append(name);
+            }
+        }
+    };
+    auto sep = [&]()
+    {
+        out.append(", ");
+    };
+    auto symbol_or = [&](std::string_view sym, auto fallback)
+    {
+        if(opts.symbolic && !sym.empty())
+            out.append(sym);
+        else
+            fallback();
+    };
+    auto ptr = [&](asPWORD p)
+    {
+        std::string_view sym;
+        switch(op)
+        {
+        case asBC_FuncPtr:
+            sym = syms.function(p);
+            break;
+        case asBC_ALLOC:
+        case asBC_FREE:
+        case asBC_REFCPY:
+        case asBC_OBJTYPE:
+        case asBC_RefCpyV:
+            sym = syms.type(p);
+            break;
+        default:
+            sym = syms.global(p);
+            break;
+        }
+        symbol_or(sym, [&]()
+                  { out.append_hex(p); });
+    };
+    // DWORD argument whose meaning depends on the instruction
+    auto dword = [&](const asDWORD* arg)
+    {
+        const int val = *reinterpret_cast<const int*>(arg);
+        std::size_t target;
+        switch(op)
+        {
+        case asBC_CALL:
+        case asBC_CALLINTF:
+        case asBC_CALLSYS:
+        case asBC_Thiscall1:
+        case asBC_ALLOC:
+            symbol_or(syms.function(val), [&]()
+                      { out.append("func#"); out.append_number(val); });
+            break;
+
+        case asBC_COPY:
+        case asBC_Cast:
+        case asBC_TYPEID:
+            symbol_or(syms.type(val), [&]()
+                      { out.append("type#"); out.append_number(val); });
+            break;
+
+        case asBC_CMPIf:
+        case asBC_ADDIf:
+        case asBC_SUBIf:
+        case asBC_MULIf:
+            out.append_number(*reinterpret_cast<const float*>(arg));
+            break;
+
+        case asBC_SetV1:
+            out.append_hex(static_cast<asBYTE>(*arg));
+            break;
+        case asBC_SetV2:
+            out.append_hex(static_cast<asWORD>(*arg));
+            break;
+
+        default:
+            if(asbind20::detail::bc_jump_target(instr, pos, target))
+            {
+                out.put('@');
+                out.append_number(target);
+            }
+            else
+                out.append_number(val);
+            break;
+        }
+    };
+    auto qword = [&](const asDWORD* arg)
+    {
+        std::int64_t val;
+        std::memcpy(&val, arg, sizeof(val));
+        out.append_number(val);
+    };
+
+    const asDWORD* after_ptr = instr + 1 + bc_ptr_size;
+    switch(op)
+    {
+    // Instructions with pointer arguments
+    case asBC_REFCPY:
+    case asBC_OBJTYPE:
+    case asBC_FuncPtr:
+    case asBC_PGA:
+    case asBC_PshGPtr:
+    case asBC_LDG:
+    case asBC_PshG4:
+        ptr(asBC_PTRARG(instr));
+        break;
+
+    case asBC_FREE:
+    case asBC_RefCpyV:
+    case asBC_CpyGtoV4:
+    case asBC_LdGRdR4:
+    case asBC_CpyVtoG4:
+        var(asBC_SWORDARG0(instr));
+        sep();
+        ptr(asBC_PTRARG(instr));
+        break;
+
+    case asBC_ALLOC:
+        ptr(asBC_PTRARG(instr));
+        sep();
+        dword(after_ptr);
+        break;
+
+    case asBC_SetG4:
+        ptr(asBC_PTRARG(instr));
+        sep();
+        out.append_number(*reinterpret_cast<const int*>(after_ptr));
+        break;
+
+    default:
+        switch(info.type)
+        {
+        case asBCTYPE_W_ARG:
+            out.append_number(asBC_SWORDARG0(instr));
+            break;
+
+        case asBCTYPE_wW_ARG:
+        case asBCTYPE_rW_ARG:
+            var(asBC_SWORDARG0(instr));
+            break;
+
+        case asBCTYPE_DW_ARG:
+            dword(instr + 1);
+            break;
+
+        case asBCTYPE_rW_DW_ARG:
+        case asBCTYPE_wW_DW_ARG:
+            var(asBC_SWORDARG0(instr));
+            sep();
+            dword(instr + 1);
+            break;
+
+        case asBCTYPE_W_DW_ARG:
+            out.append_number(asBC_SWORDARG0(instr));
+            sep();
+            dword(instr + 1);
+            break;
+
+        case asBCTYPE_QW_ARG:
+            qword(instr + 1);
+            break;
+
+        case asBCTYPE_DW_DW_ARG:
+            dword(instr + 1);
+            sep();
+            out.append_number(*reinterpret_cast<const int*>(instr + 2));
+            break;
+
+        case asBCTYPE_wW_rW_rW_ARG:
+            var(asBC_SWORDARG0(instr));
+            sep();
+            var(asBC_SWORDARG1(instr));
+            sep();
+            var(asBC_SWORDARG2(instr));
+            break;
+
+        case asBCTYPE_wW_QW_ARG:
+        case asBCTYPE_rW_QW_ARG:
+            var(asBC_SWORDARG0(instr));
+            sep();
+            qword(instr + 1);
+            break;
+
+        case asBCTYPE_wW_rW_ARG:
+        case asBCTYPE_rW_rW_ARG:
+            var(asBC_SWORDARG0(instr));
+            sep();
+            var(asBC_SWORDARG1(instr));
+            break;
+
+        case asBCTYPE_wW_W_ARG:
+            var(asBC_SWORDARG0(instr));
+            sep();
+            out.append_number(asBC_SWORDARG1(instr));
+            break;
+
+        case asBCTYPE_wW_rW_DW_ARG:
+            var(asBC_SWORDARG0(instr));
+            sep();
+            var(asBC_SWORDARG1(instr));
+            sep();
+            dword(instr + 2);
+            break;
+
+        case asBCTYPE_rW_W_DW_ARG:
+            var(asBC_SWORDARG0(instr));
+            sep();
+            out.append_number(asBC_SWORDARG1(instr));
+            sep();
+            dword(instr + 2);
+            break;
+
+        case asBCTYPE_QW_DW_ARG:
+            qword(instr + 1);
+            sep();
+            out.append_number(*reinterpret_cast<const int*>(instr + 3));
+            break;
+
+        case asBCTYPE_rW_DW_DW_ARG:
+            var(asBC_SWORDARG0(instr));
+            sep();
+            out.append_number(*reinterpret_cast<const int*>(instr + 1));
+            sep();
+            out.append_number(*reinterpret_cast<const int*>(instr + 2));
+            break;
+
+        case asBCTYPE_INFO:
+        case asBCTYPE_NO_ARG:
+        default:
+            break;
+        }
+        break;
+    }
+
+    // Remove trailing spaces of instructions without arguments
+    std::size_t n = out.size();
+    while(n > 0 && buf[n - 1] == ' ')
+        --n;
+    return n;
+}
+
+/**
+ * @brief Disassemble a script function line by line
+ *
+ * @param syms Symbols of the function
+ * @param fn Callback with signature similar to `void(std::string_view line)`.
+ *           The line is not terminated by a new line character and is only valid during the call.
+ * @param opts Options
+ */
+template <typename Callback>
+void disassemble_function(
+    const function_symbols& syms,
+    Callback&& fn,
+    const disasm_options& opts = disasm_options()
+)
+{
+    char buf[512];
+    const auto lines = syms.lines();
+    std::size_t next_line = 0;
+
+    asbind20::detail::for_each_instruction(
+        syms.byte_code(),
+        [&](const AS_NAMESPACE_QUALIFIER asDWORD*, std::size_t pos)
+        {
+            if(opts.lines)
+            {
+                // Skip entries of the same position, only the last one is shown
+                const function_symbols::line_entry* entry = nullptr;
+                while(next_line < lines.size() && lines[next_line].pos <= pos)
+                    entry = &lines[next_line++];
+
+                if(entry)
+                {
+                    detail::fixed_writer out(buf);
+                    out.append("; ");
+                    if(entry->section)
+                        out.append(entry->section);
+                    out.put(':');
+                    out.append_number(entry->row);
+                    out.put(':');
+                    out.append_number(entry->col);
+                    fn(std::string_view(buf, out.size()));
+                }
+            }
+
+            const std::size_t n = disassemble_instruction(buf, syms, pos, opts);
+            fn(std::string_view(buf, n));
+        }
+    );
+}
+
+/**
+ * @brief Disassemble a script function into a stream
+ *
+ * @param os Output stream
+ * @param func Script function
+ * @param opts Options
+ */
+inline std::ostream& disassemble_function(
+    std::ostream& os,
+    AS_NAMESPACE_QUALIFIER asIScriptFunction* func,
+    const disasm_options& opts = disasm_options()
+)
+{
+    if(!func) [[unlikely]]
+        return os;
+
+    os << "// " << func->GetDeclaration(true, true, true) << '\n';
+    function_symbols syms(func);
+    disassemble_function(
+        syms,
+        [&os](std::string_view line)
+        {
+            os.write(line.data(), static_cast<std::streamsize>(line.size()));
+            os.put('\n');
+        },
+        opts
+    );
+    return os;
+}
+
+/**
+ * @brief Disassemble all script functions of a module
+ *
+ * Functions are disassembled concurrently, and the output is ordered by function ID.
+ *
+ * @param os Output stream
+ * @param m Script module
+ * @param thread_count Count of worker threads. Zero means using `std::thread::hardware_concurrency()`.
+ *                     One means disassembling in the calling thread.
+ * @param opts Options
+ *
+ * @note The engine must not be modified during disassembling.
+ *       Call `concurrent::prepare_multithread()` before creating the engine if `thread_count` is not one.
+ */
+inline std::ostream& disassemble_module(
+    std::ostream& os,
+    AS_NAMESPACE_QUALIFIER asIScriptModule* m,
+    unsigned int thread_count = 0,
+    const disasm_options& opts = disasm_options()
+)
+{
+    if(!m) [[unlikely]]
+        return os;
+
+    auto* engine = m->GetEngine();
+    std::vector<AS_NAMESPACE_QUALIFIER asIScriptFunction*> funcs;
+    const int last_id = engine->GetLastFunctionId();
+    for(int id = 0; id <= last_id; ++id)
+    {
+        auto* f = engine->GetFunctionById(id);
+        if(!f || f->GetModule() != m)
+            continue;
+        if(f->GetFuncType() != AS_NAMESPACE_QUALIFIER asFUNC_SCRIPT)
+            continue;
+        funcs.push_back(f);
+    }
+
+    std::vector<std::string> outputs(funcs.size());
+    std::atomic_size_t next = 0;
+    auto work = [&]()
+    {
+        for(std::size_t i = next.fetch_add(1); i < funcs.size(); i = next.fetch_add(1))
+        {
+            std::string& out = outputs[i];
+            out += "// ";
+            out += funcs[i]->GetDeclaration(true, true, true);
+            out += '\n';
+
+            function_symbols syms(funcs[i]);
+            disassemble_function(
+                syms,
+                [&out](std::string_view line)
+                {
+                    out += line;
+                    out += '\n';
+                },
+                opts
+            );
+        }
+    };
+
+    if(thread_count == 0)
+        thread_count = std::max(1u, std::thread::hardware_concurrency());
+    if(thread_count > funcs.size())
+        thread_count = static_cast<unsigned int>(std::max<std::size_t>(1, funcs.size()));
+
+    if(thread_count == 1)
+        work();
+    else
+    {
+        std::vector<std::thread> workers;
+        workers.reserve(thread_count - 1);
+        for(unsigned int i = 0; i < thread_count - 1; ++i)
+        {
+            workers.emplace_back(
+                [&work]()
+                {
+                    work();
+                    AS_NAMESPACE_QUALIFIER asThreadCleanup();
+                }
+            );
+        }
+
+        // The calling thread also works
+        work();
+
+        for(auto& t : workers)
+            t.join();
+    }
+
+    for(std::size_t i = 0; i < outputs.size(); ++i)
+    {
+        if(i != 0)
+            os.put('\n');
+        os << outputs[i];
+    }
+
+    return os;
+}
+} // namespace asbind20::debugging
+
+#endif
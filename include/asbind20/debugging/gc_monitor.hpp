@@ -0,0 +1,373 @@
+/**
+ * @file debugging/gc_monitor.hpp
+ * @author HenryAWE
+ * @brief Telemetry of the garbage collector
+ */
+
+#ifndef ASBIND20_DEBUGGING_GC_MONITOR_HPP
+#define ASBIND20_DEBUGGING_GC_MONITOR_HPP
+
+#pragma once
+
+#include <cstddef>
+#include <cstdint>
+#include <algorithm>
+#include <bit>
+#include <chrono>
+#include <deque>
+#include <iterator>
+#include <limits>
+#include <unordered_map>
+#include <utility>
+#include <vector>
+#include "../detail/config.hpp"
+#include "../detail/include_as.hpp"
+#include "gc_statistics.hpp"
+
+namespace asbind20::debugging
+{
+/**
+ * @brief Histogram with logarithmic buckets and linear sub-buckets, in the style of HdrHistogram
+ *
+ * Values are grouped by their highest bit, and each group is divided into `2^SubBucketBits` sub-buckets.
+ * The relative error of recorded values is bounded by `2^-SubBucketBits`.
+ *
+ * @tparam SubBucketBits Precision of sub-buckets
+ */
+template <unsigned int SubBucketBits = 4>
+class basic_pause_histogram
+{
+public:
+    using value_type = std::uint64_t;
+
+    static constexpr std::size_t sub_bucket_count = std::size_t(1) << SubBucketBits;
+    static constexpr std::size_t bucket_count =
+        (std::numeric_limits<value_type>::digits - SubBucketBits + 1) * sub_bucket_count;
+
+    basic_pause_histogram() = default;
+
+    void record(value_type val) noexcept
+    {
+        ++m_counts[index_of(val)];
+        ++m_total;
+        m_sum += val;
+        m_min = std::min(m_min, val);
+        m_max = std::max(m_max, val);
+    }
+
+    void clear() noexcept
+    {
+        *this = basic_pause_histogram();
+    }
+
+    [[nodiscard]]
+    std::uint64_t count() const noexcept
+    {
+        return m_total;
+    }
+
+    [[nodiscard]]
+    value_type min() const noexcept
+    {
+        return m_total == 0 ? 0 : m_min;
+    }
+
+    [[nodiscard]]
+    value_type max() const noexcept
+    {
+        return m_max;
+    }
+
+    [[nodiscard]]
+    double mean() const noexcept
+    {
+        if(m_total == 0)
+            return 0.0;
+        return static_cast<double>(m_sum) / static_cast<double>(m_total);
+    }
+
+    /**
+     * @brief Get the value at a percentile
+     *
+     * @param p Percentile in the range of [0, 100]
+     * @return Upper bound of the bucket containing the percentile, clamped to the maximum recorded value
+     */
+    [[nodiscard]]
+    value_type percentile(double p) const noexcept
+    {
+        if(m_total == 0)
+            return 0;
+
+        p = std::clamp(p, 0.0, 100.0);
+        auto target = static_cast<std::uint64_t>(p / 100.0 * static_cast<double>(m_total) + 0.5);
+        target = std::clamp<std::uint64_t>(target, 1, m_total);
+
+        std::uint64_t acc = 0;
+        for(std::size_t i = 0; i < bucket_count; ++i)
+        {
+            acc += m_counts[i];
+            if(acc >= target)
+                return std::min(upper_bound_of(i), m_max);
+        }
+
+        return m_max;
+    }
+
+    /**
+     * @brief Invoke the callback with the range and count of every non-empty bucket
+     *
+     * @param fn Callback with signature similar to `void(value_type lower, value_type upper, std::uint64_t count)`
+     */
+    template <typename Callback>
+    void for_each_bucket(Callback&& fn) const
+    {
+        for(std::size_t i = 0; i < bucket_count; ++i)
+        {
+            if(m_counts[i] != 0)
+                fn(lower_bound_of(i), upper_bound_of(i), m_counts[i]);
+        }
+    }
+
+private:
+    std::uint64_t m_counts[bucket_count] = {};
+    std::uint64_t m_total = 0;
+    value_type m_sum = 0;
+    value_type m_min = std::numeric_limits<value_type>::max();
+    value_type m_max = 0;
+
+    static std::size_t index_of(value_type val) noexcept
+    {
+        if(val < sub_bucket_count)
+            return static_cast<std::size_t>(val);
+
+        const unsigned int msb = std::bit_width(val) - 1;
+        const unsigned int shift = msb - SubBucketBits;
+        const std::size_t group = shift + 1;
+        const std::size_t sub = static_cast<std::size_t>(val >> shift) - sub_bucket_count;
+        return group * sub_bucket_count + sub;
+    }
+
+    static value_type lower_bound_of(std::size_t idx) noexcept
+    {
+        const std::size_t group = idx / sub_bucket_count;
+        const std::size_t sub = idx % sub_bucket_count;
+        if(group == 0)
+            return sub;
+        return static_cast<value_type>(sub_bucket_count + sub) << (group - 1);
+    }
+
+    static value_type upper_bound_of(std::size_t idx) noexcept
+    {
+        const std::size_t group = idx / sub_bucket_count;
+        if(group == 0)
+            return lower_bound_of(idx);
+        return lower_bound_of(idx) + ((value_type(1) << (group - 1)) - 1);
+    }
+};
+
+using pause_histogram = basic_pause_histogram<>;
+
+/**
+ * @brief A point of the GC time series
+ */
+struct gc_sample
+{
+    std::chrono::steady_clock::time_point time;
+    gc_statistics stats;
+
+    /// Duration of the GC call before this sample. Zero if the sample isn't taken by a GC call.
+    std::chrono::nanoseconds pause{0};
+
+    /// Objects added to the GC since the previous sample
+    std::uint64_t births = 0;
+    /// Objects destroyed by the GC since the previous sample
+    std::uint64_t deaths = 0;
+};
+
+/**
+ * @brief Monitor of the garbage collector
+ *
+ * Wrap calls of `asIScriptEngine::GarbageCollect` by `collect()` to record pause durations.
+ * Statistics are recorded into a rolling time series on every call of `collect()` and `sample()`.
+ *
+ * @note This class is not thread-safe.
+ */
+class gc_monitor
+{
+public:
+    using clock_type = std::chrono::steady_clock;
+
+    /**
+     * @param engine Script engine
+     * @param history Maximum count of samples in the time series
+     */
+    explicit gc_monitor(
+        AS_NAMESPACE_QUALIFIER asIScriptEngine* engine,
+        std::size_t history = 600
+    )
+        : m_engine(engine), m_history(std::max<std::size_t>(history, 1))
+    {
+        ASBIND20_ASSERT(engine != nullptr);
+        m_last = get_gc_statistics(m_engine);
+    }
+
+    /**
+     * @brief Invoke the garbage collector and record the pause
+     *
+     * @return Result of `asIScriptEngine::GarbageCollect`
+     */
+    int collect(
+        AS_NAMESPACE_QUALIFIER asDWORD flags = AS_NAMESPACE_QUALIFIER asGC_FULL_CYCLE,
+        AS_NAMESPACE_QUALIFIER asUINT num_iterations = 1
+    )
+    {
+        const auto start = clock_type::now();
+        int r = m_engine->GarbageCollect(flags, num_iterations);
+        const auto pause = clock_type::now() - start;
+
+        m_pauses.record(static_cast<std::uint64_t>(
+            std::chrono::duration_cast<std::chrono::nanoseconds>(pause).count()
+        ));
+        push_sample(std::chrono::duration_cast<std::chrono::nanoseconds>(pause));
+
+        return r;
+    }
+
+    /**
+     * @brief Record current statistics without invoking the garbage collector
+     */
+    const gc_sample& sample()
+    {
+        return push_sample(std::chrono::nanoseconds(0));
+    }
+
+    /**
+     * @brief Histogram of pause durations in nanoseconds
+     */
+    [[nodiscard]]
+    const pause_histogram& pauses() const noexcept
+    {
+        return m_pauses;
+    }
+
+    /**
+     * @brief Rolling time series of samples
+     */
+    [[nodiscard]]
+    const std::deque<gc_sample>& samples() const noexcept
+    {
+        return m_samples;
+    }
+
+    /**
+     * @brief Births per second over the recorded time series
+     */
+    [[nodiscard]]
+    double birth_rate() const noexcept
+    {
+        return rate(&gc_sample::births);
+    }
+
+    /**
+     * @brief Deaths per second over the recorded time series
+     */
+    [[nodiscard]]
+    double death_rate() const noexcept
+    {
+        return rate(&gc_sample::deaths);
+    }
+
+    /**
+     * @brief Count live objects in the GC by their types
+     *
+     * @return Pairs of type and count, sorted by count in descending order
+     */
+    [[nodiscard]]
+    std::vector<std::pair<AS_NAMESPACE_QUALIFIER asITypeInfo*, std::size_t>> live_objects_by_type() const
+    {
+        std::unordered_map<AS_NAMESPACE_QUALIFIER asITypeInfo*, std::size_t> counts;
+        for(AS_NAMESPACE_QUALIFIER asUINT i = 0;; ++i)
+        {
+            AS_NAMESPACE_QUALIFIER asITypeInfo* ti = nullptr;
+            if(m_engine->GetObjectInGC(i, nullptr, nullptr, &ti) < 0)
+                break;
+            ++counts[ti];
+        }
+
+        std::vector<std::pair<AS_NAMESPACE_QUALIFIER asITypeInfo*, std::size_t>> result(
+            counts.begin(), counts.end()
+        );
+        std::ranges::sort(
+            result,
+            [](const auto& lhs, const auto& rhs)
+            { return lhs.second > rhs.second; }
+        );
+
+        return result;
+    }
+
+    /**
+     * @brief Clear the histogram and the time series
+     */
+    void reset()
+    {
+        m_pauses.clear();
+        m_samples.clear();
+        m_last = get_gc_statistics(m_engine);
+    }
+
+    [[nodiscard]]
+    AS_NAMESPACE_QUALIFIER asIScriptEngine* get_engine() const noexcept
+    {
+        return m_engine;
+    }
+
+private:
+    AS_NAMESPACE_QUALIFIER asIScriptEngine* m_engine;
+    std::size_t m_history;
+    pause_histogram m_pauses;
+    std::deque<gc_sample> m_samples;
+    gc_statistics m_last;
+
+    const gc_sample& push_sample(std::chrono::nanoseconds pause)
+    {
+        gc_sample s;
+        s.time = clock_type::now();
+        s.stats = get_gc_statistics(m_engine);
+        s.pause = pause;
+
+        // Every object destroyed by the GC has been added to it, so births = growth + deaths
+        const std::uint64_t deaths = s.stats.total_destroyed - m_last.total_destroyed;
+        const std::int64_t growth =
+            static_cast<std::int64_t>(s.stats.current_size) - static_cast<std::int64_t>(m_last.current_size);
+        s.deaths = deaths;
+        s.births = static_cast<std::uint64_t>(std::max<std::int64_t>(
+            0, growth + static_cast<std::int64_t>(deaths)
+        ));
+        m_last = s.stats;
+
+        if(m_samples.size() >= m_history)
+            m_samples.pop_front();
+        m_samples.push_back(s);
+        return m_samples.back();
+    }
+
+    double rate(std::uint64_t gc_sample::* member) const noexcept
+    {
+        if(m_samples.size() < 2)
+            return 0.0;
+
+        std::uint64_t total = 0;
+        // The first sample is the baseline
+        for(auto it = std::next(m_samples.begin()); it != m_samples.end(); ++it)
+            total += (*it).*member;
+
+        const std::chrono::duration<double> elapsed = m_samples.back().time - m_samples.front().time;
+        if(elapsed.count() <= 0)
+            return 0.0;
+        return static_cast<double>(total) / elapsed.count();
+    }
+};
+} // namespace asbind20::debugging
+
+#endif
@@ -0,0 +1,617 @@
+/**
+ * @file debugging/heap_inspector.hpp
+ * @author HenryAWE
+ * @brief Attribution of memory owned by GC-tracked script objects
+ */
+
+#ifndef ASBIND20_DEBUGGING_HEAP_INSPECTOR_HPP
+#define ASBIND20_DEBUGGING_HEAP_INSPECTOR_HPP
+
+#pragma once
+
+#include <cstddef>
+#include <cstdint>
+#include <algorithm>
+#include <atomic>
+#include <charconv>
+#include <deque>
+#include <istream>
+#include <map>
+#include <memory>
+#include <mutex>
+#include <optional>
+#include <ostream>
+#include <string>
+#include <string_view>
+#include <tuple>
+#include <unordered_map>
+#include <vector>
+#include "../detail/include_as.hpp"
+#include "../debugging.hpp"
+#include "gc_statistics.hpp"
+
+namespace asbind20::debugging
+{
+/**
+ * @brief Source location where objects were allocated
+ */
+struct allocation_site
+{
+    /// Declaration of the function
+    std::string function;
+    std::string section;
+    int line = 0;
+};
+
+/**
+ * @brief Tracker of allocation sites of GC-tracked objects
+ *
+ * The tracker installs a line callback on attached contexts.
+ * Every object added to the GC gets a sequence number, which is also counted by `gc_statistics::new_objects`.
+ * When the counter grows between two line callbacks, the new objects are attributed to the previous line.
+ *
+ * @note Attribution is approximate if multiple contexts are executed concurrently.
+ *       Objects created by the application or before attaching are attributed to no site.
+ *
+ * @warning The line callback of attached contexts will be replaced.
+ */
+class allocation_tracker
+{
+public:
+    allocation_tracker() = default;
+
+    allocation_tracker(const allocation_tracker&) = delete;
+
+    ~allocation_tracker()
+    {
+        std::lock_guard lock(m_mx);
+        for(auto& s : m_contexts)
+            s->ctx->ClearLineCallback();
+        for(auto& s : m_sites)
+            s.func->Release();
+    }
+
+    allocation_tracker& operator=(const allocation_tracker&) = delete;
+
+    /**
+     * @brief Attach to a context by installing the line callback
+     */
+    int attach(AS_NAMESPACE_QUALIFIER asIScriptContext* ctx)
+    {
+        if(!ctx) [[unlikely]]
+            return AS_NAMESPACE_QUALIFIER asINVALID_ARG;
+
+        std::lock_guard lock(m_mx);
+        for(const auto& s : m_contexts)
+        {
+            if(s->ctx == ctx)
+                return AS_NAMESPACE_QUALIFIER asALREADY_REGISTERED;
+        }
+
+        auto state = std::make_unique<context_state>();
+        state->self = this;
+        state->ctx = ctx;
+        int r = ctx->SetLineCallback(
+            AS_NAMESPACE_QUALIFIER asFUNCTION(&line_callback),
+            state.get(),
+            AS_NAMESPACE_QUALIFIER asCALL_CDECL
+        );
+        if(r < 0)
+            return r;
+
+        if(m_contexts.empty())
+            m_last_seq.store(get_gc_statistics(ctx->GetEngine()).new_objects, std::memory_order_relaxed);
+        m_contexts.push_back(std::move(state));
+        return AS_NAMESPACE_QUALIFIER asSUCCESS;
+    }
+
+    /**
+     * @brief Detach from a context and clear its line callback
+     */
+    void detach(AS_NAMESPACE_QUALIFIER asIScriptContext* ctx)
+    {
+        std::lock_guard lock(m_mx);
+        for(auto it = m_contexts.begin(); it != m_contexts.end(); ++it)
+        {
+            if((*it)->ctx == ctx)
+            {
+                ctx->ClearLineCallback();
+                m_contexts.erase(it);
+                return;
+            }
+        }
+    }
+
+    /**
+     * @brief Find the allocation site of an object by its sequence number in the GC
+     *
+     * The site is copied, so the result stays valid after `clear()` from another thread.
+     *
+     * @return Empty if the site is unknown
+     */
+    [[nodiscard]]
+    std::optional<allocation_site> find(AS_NAMESPACE_QUALIFIER asUINT seq) const
+    {
+        std::lock_guard lock(m_mx);
+
+        // Find the last range beginning at or before the sequence number
+        auto it = std::upper_bound(
+            m_ranges.begin(),
+            m_ranges.end(),
+            seq,
+            [](AS_NAMESPACE_QUALIFIER asUINT val, const range& r)
+            { return val < r.begin; }
+        );
+        if(it == m_ranges.begin())
+            return std::nullopt;
+        --it;
+        if(seq >= it->end)
+            return std::nullopt;
+
+        return m_sites[it->site].info;
+    }
+
+    /**
+     * @brief Forget all recorded sites
+     */
+    void clear()
+    {
+        std::lock_guard lock(m_mx);
+        m_ranges.clear();
+        m_site_indices.clear();
+        for(auto& s : m_sites)
+            s.func->Release();
+        m_sites.clear();
+    }
+
+private:
+    struct context_state
+    {
+        allocation_tracker* self;
+        AS_NAMESPACE_QUALIFIER asIScriptContext* ctx;
+        AS_NAMESPACE_QUALIFIER asIScriptFunction* prev_func = nullptr;
+        int prev_line = 0;
+    };
+
+    struct site_entry
+    {
+        AS_NAMESPACE_QUALIFIER asIScriptFunction* func;
+        allocation_site info;
+    };
+
+    // Sequence numbers in [begin, end) are allocated at the site
+    struct range
+    {
+        AS_NAMESPACE_QUALIFIER asUINT begin;
+        AS_NAMESPACE_QUALIFIER asUINT end;
+        std::size_t site;
+    };
+
+    mutable std::mutex m_mx;
+    std::vector<std::unique_ptr<context_state>> m_contexts;
+    // Deque for keeping the addresses of sites stable
+    std::deque<site_entry> m_sites;
+    std::map<std::pair<int, int>, std::size_t> m_site_indices;
+    std::vector<range> m_ranges;
+    std::atomic<AS_NAMESPACE_QUALIFIER asUINT> m_last_seq = 0;
+
+    std::size_t intern_site(AS_NAMESPACE_QUALIFIER asIScriptFunction* f, int line)
+    {
+        auto [it, inserted] = m_site_indices.try_emplace({f->GetId(), line}, m_sites.size());
+        if(inserted)
+        {
+            f->AddRef();
+            site_entry entry{f, {f->GetDeclaration(true, true, false), "", line}};
+            if(const char* section = get_function_section_name(f))
+                entry.info.section = section;
+            m_sites.push_back(std::move(entry));
+        }
+
+        return it->second;
+    }
+
+    void on_line(context_state& state)
+    {
+        auto* ctx = state.ctx;
+        const auto seq = get_gc_statistics(ctx->GetEngine()).new_objects;
+
+        // Only lock when new objects are added
+        if(seq != m_last_seq.load(std::memory_order_relaxed))
+        {
+            std::lock_guard lock(m_mx);
+            const auto last = m_last_seq.load(std::memory_order_relaxed);
+            if(seq > last && state.prev_func)
+            {
+                const std::size_t site = intern_site(state.prev_func, state.prev_line);
+                // Merge with the previous range of the same site
+                if(!m_ranges.empty() && m_ranges.back().site == site && m_ranges.back().end == last)
+                    m_ranges.back().end = seq;
+                else
+                    m_ranges.push_back({last, seq, site});
+            }
+            m_last_seq.store(seq, std::memory_order_relaxed);
+        }
+
+        state.prev_func = ctx->GetFunction(0);
+        state.prev_line = ctx->GetLineNumber(0);
+    }
+
+    static void line_callback(AS_NAMESPACE_QUALIFIER asIScriptContext*, void* param)
+    {
+        auto* state = static_cast<context_state*>(param);
+        state->self->on_line(*state);
+    }
+};
+
+/**
+ * @brief Live objects and bytes attributed to a type, a module, and an allocation site
+ */
+struct heap_entry
+{
+    /// Name of the module declaring the type. Empty for types registered by the application.
+    std::string module;
+    /// Declaration of the type
+    std::string type;
+    /// Allocation site in the format of `section:line function`. Empty if unknown.
+    std::string site;
+
+    std::size_t count = 0;
+    std::size_t bytes = 0;
+
+    [[nodiscard]]
+    auto key() const noexcept
+    {
+        return std::tie(module, type, site);
+    }
+};
+
+/**
+ * @brief Difference of an entry between two snapshots
+ */
+struct heap_diff_entry
+{
+    std::string module;
+    std::string type;
+    std::string site;
+
+    std::ptrdiff_t count = 0;
+    std::ptrdiff_t bytes = 0;
+};
+
+/**
+ * @brief Snapshot of GC-tracked objects
+ *
+ * Entries are sorted by module, type, and site, so the CSV output of two snapshots can also be compared by text tools.
+ */
+class heap_snapshot
+{
+public:
+    heap_snapshot() = default;
+
+    explicit heap_snapshot(std::vector<heap_entry> entries)
+        : m_entries(std::move(entries))
+    {
+        std::ranges::sort(
+            m_entries,
+            [](const heap_entry& lhs, const heap_entry& rhs)
+            { return lhs.key() < rhs.key(); }
+        );
+    }
+
+    [[nodiscard]]
+    const std::vector<heap_entry>& entries() const noexcept
+    {
+        return m_entries;
+    }
+
+    [[nodiscard]]
+    std::size_t total_count() const noexcept
+    {
+        std::size_t result = 0;
+        for(const auto& e : m_entries)
+            result += e.count;
+        return result;
+    }
+
+    [[nodiscard]]
+    std::size_t total_bytes() const noexcept
+    {
+        std::size_t result = 0;
+        for(const auto& e : m_entries)
+            result += e.bytes;
+        return result;
+    }
+
+    /**
+     * @brief Aggregate entries by a member, e.g., `&heap_entry::module`
+     *
+     * @return Entries with only the aggregated member set, sorted by bytes in descending order
+     */
+    [[nodiscard]]
+    std::vector<heap_entry> aggregate(std::string heap_entry::* member) const
+    {
+        std::map<std::string_view, heap_entry> groups;
+        for(const auto& e : m_entries)
+        {
+            auto [it, inserted] = groups.try_emplace(e.*member);
+            if(inserted)
+                it->second.*member = e.*member;
+            it->second.count += e.count;
+            it->second.bytes += e.bytes;
+        }
+
+        std::vector<heap_entry> result;
+        result.reserve(groups.size());
+        for(auto& [k, v] : groups)
+            result.push_back(std::move(v));
+        std::ranges::stable_sort(result, std::ranges::greater{}, &heap_entry::bytes);
+
+        return result;
+    }
+
+    /**
+     * @brief Write the snapshot as CSV
+     */
+    void write_csv(std::ostream& os) const
+    {
+        os << "module,type,site,count,bytes\n";
+        for(const auto& e : m_entries)
+        {
+            write_csv_field(os, e.module);
+            os << ',';
+            write_csv_field(os, e.type);
+            os << ',';
+            write_csv_field(os, e.site);
+            os << ',' << e.count << ',' << e.bytes << '\n';
+        }
+    }
+
+    /**
+     * @brief Read a snapshot written by `write_csv()`
+     *
+     * @return Empty snapshot if the input is malformed
+     */
+    static heap_snapshot read_csv(std::istream& is)
+    {
+        std::string line;
+        if(!std::getline(is, line)) // Header
+            return {};
+
+        std::vector<heap_entry> entries;
+        while(std::getline(is, line))
+        {
+            if(line.empty())
+                continue;
+
+            std::string_view rest = line;
+            heap_entry e;
+            if(!read_csv_field(rest, e.module) ||
+               !read_csv_field(rest, e.type) ||
+               !read_csv_field(rest, e.site))
+                return {};
+
+            std::string count, bytes;
+            if(!read_csv_field(rest, count) || !read_csv_field(rest, bytes))
+                return {};
+            if(!parse_size(count, e.count) || !parse_size(bytes, e.bytes))
+                return {};
+
+            entries.push_back(std::move(e));
+        }
+
+        return heap_snapshot(std::move(entries));
+    }
+
+    /**
+     * @brief Compare two snapshots
+     *
+     * @return Changed entries, sorted by the absolute difference of bytes in descending order
+     */
+    friend std::vector<heap_diff_entry> diff(const heap_snapshot& before, const heap_snapshot& after)
+    {
+        std::vector<heap_diff_entry> result;
+
+        auto add = [&result](const heap_entry& e, std::ptrdiff_t sign)
+        {
+            result.push_back({
+                e.module,
+                e.type,
+                e.site,
+                sign * static_cast<std::ptrdiff_t>(e.count),
+                sign * static_cast<std::ptrdiff_t>(e.bytes)
+            });
+        };
+
+        // Both entries are sorted by key
+        auto lhs = before.m_entries.begin();
+        auto rhs = after.m_entries.begin();
+        while(lhs != before.m_entries.end() || rhs != after.m_entries.end())
+        {
+            if(rhs == after.m_entries.end() ||
+               (lhs != before.m_entries.end() && lhs->key() < rhs->key()))
+            {
+                add(*lhs++, -1);
+            }
+            else if(lhs == before.m_entries.end() || rhs->key() < lhs->key())
+            {
+                add(*rhs++, 1);
+            }
+            else
+            {
+                if(lhs->count != rhs->count || lhs->bytes != rhs->bytes)
+                {
+                    add(*rhs, 1);
+                    result.back().count -= static_cast<std::ptrdiff_t>(lhs->count);
+                    result.back().bytes -= static_cast<std::ptrdiff_t>(lhs->bytes);
+                }
+                ++lhs;
+                ++rhs;
+            }
+        }
+
+        std::ranges::stable_sort(
+            result,
+            std::ranges::greater{},
+            [](const heap_diff_entry& e)
+            { return e.bytes < 0 ? -e.bytes : e.bytes; }
+        );
+
+        return result;
+    }
+
+private:
+    std::vector<heap_entry> m_entries;
+
+    // Returns false if the string is not entirely a decimal number
+    static bool parse_size(std::string_view str, std::size_t& out) noexcept
+    {
+        const char* last = str.data() + str.size();
+        auto [ptr, ec] = std::from_chars(str.data(), last, out);
+        return ec == std::errc() && ptr == last;
+    }
+
+    static void write_csv_field(std::ostream& os, std::string_view str)
+    {
+        os.put('"');
+        for(char c : str)
+        {
+            if(c == '"')
+                os.put('"');
+            os.put(c);
+        }
+        os.put('"');
+    }
+
+    static bool read_csv_field(std::string_view& str, std::string& out)
+    {
+        out.clear();
+        if(str.starts_with('"'))
+        {
+            std::size_t i = 1;
+            for(;; ++i)
+            {
+                if(i >= str.size())
+                    return false;
+                if(str[i] == '"')
+                {
+                    if(i + 1 < str.size() && str[i + 1] == '"')
+                    {
+                        out += '"';
+                        ++i;
+                        continue;
+                    }
+                    break;
+                }
+                out += str[i];
+            }
+            str.remove_prefix(i + 1);
+        }
+        else
+        {
+            const std::size_t end = std::min(str.find(','), str.size());
+            out.assign(str.substr(0, end));
+            str.remove_prefix(end);
+        }
+
+        if(str.starts_with(','))
+            str.remove_prefix(1);
+        return true;
+    }
+};
+
+/**
+ * @brief Estimate the size of an object in bytes
+ *
+ * @param obj Address of the object
+ * @param ti Type of the object
+ */
+using object_sizer_t = std::size_t (*)(void* obj, AS_NAMESPACE_QUALIFIER asITypeInfo* ti);
+
+/**
+ * @brief Take a snapshot of objects tracked by the GC
+ *
+ * Objects are attributed to their types and the modules declaring the types.
+ * The size of an object is reported by `asITypeInfo::GetSize()` unless a custom sizer is provided,
+ * which is useful for registered reference types whose sizes are unknown to the engine.
+ *
+ * @param engine Script engine
+ * @param tracker Allocation tracker for attributing objects to allocation sites. Can be nullptr.
+ * @param sizer Custom sizer. Can be nullptr.
+ *
+ * @note Objects not tracked by the GC, e.g., script classes without handles to other objects, are not counted.
+ */
+inline heap_snapshot take_heap_snapshot(
+    AS_NAMESPACE_QUALIFIER asIScriptEngine* engine,
+    const allocation_tracker* tracker = nullptr,
+    object_sizer_t sizer = nullptr
+)
+{
+    if(!engine) [[unlikely]]
+        return {};
+
+    struct type_names
+    {
+        std::string module;
+        std::string type;
+    };
+
+    std::unordered_map<AS_NAMESPACE_QUALIFIER asITypeInfo*, type_names> names;
+    // Grouped by the type and the formatted site
+    std::map<std::pair<AS_NAMESPACE_QUALIFIER asITypeInfo*, std::string>, heap_entry> groups;
+
+    for(AS_NAMESPACE_QUALIFIER asUINT i = 0;; ++i)
+    {
+        AS_NAMESPACE_QUALIFIER asUINT seq = 0;
+        void* obj = nullptr;
+        AS_NAMESPACE_QUALIFIER asITypeInfo* ti = nullptr;
+        if(engine->GetObjectInGC(i, &seq, &obj, &ti) < 0)
+            break;
+        if(!ti)
+            continue;
+
+        std::string site_str;
+        if(tracker)
+        {
+            if(auto site = tracker->find(seq))
+            {
+                site_str = std::move(site->section);
+                site_str += ':';
+                site_str += std::to_string(site->line);
+                site_str += ' ';
+                site_str += site->function;
+            }
+        }
+
+        auto [it, inserted] = groups.try_emplace({ti, site_str});
+        heap_entry& e = it->second;
+        if(inserted)
+        {
+            auto name_it = names.find(ti);
+            if(name_it == names.end())
+            {
+                type_names n;
+                if(auto* m = ti->GetModule())
+                    n.module = m->GetName();
+                n.type = engine->GetTypeDeclaration(ti->GetTypeId(), true);
+                name_it = names.emplace(ti, std::move(n)).first;
+            }
+
+            e.module = name_it->second.module;
+            e.type = name_it->second.type;
+            e.site = std::move(site_str);
+        }
+
+        ++e.count;
+        e.bytes += sizer ? sizer(obj, ti) : ti->GetSize();
+    }
+
+    std::vector<heap_entry> entries;
+    entries.reserve(groups.size());
+    for(auto& [k, v] : groups)
+        entries.push_back(std::move(v));
+
+    return heap_snapshot(std::move(entries));
+}
+} // namespace asbind20::debugging
+
+#endif
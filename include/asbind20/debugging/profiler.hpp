@@ -0,0 +1,461 @@
+/**
+ * @file debugging/profiler.hpp
+ * @author HenryAWE
+ * @brief Sampling profiler for scripts
+ */
+
+#ifndef ASBIND20_DEBUGGING_PROFILER_HPP
+#define ASBIND20_DEBUGGING_PROFILER_HPP
+
+#pragma once
+
+#include <cstddef>
+#include <cstdint>
+#include <algorithm>
+#include <atomic>
+#include <chrono>
+#include <condition_variable>
+#include <map>
+#include <memory>
+#include <mutex>
+#include <ostream>
+#include <string>
+#include <thread>
+#include <tuple>
+#include <unordered_set>
+#include <utility>
+#include <vector>
+#include "../detail/include_as.hpp"
+#include "../detail/json.hpp"
+#include "../debugging.hpp"
+
+namespace asbind20::debugging
+{
+/**
+ * @brief Sampling profiler for script contexts
+ *
+ * The profiler installs a line callback on attached contexts.
+ * A sample is taken in the line callback when it is requested,
+ * so the call stack is always read from the thread executing the context.
+ * Samples can be requested in two ways:
+ *
+ * 1. By the timer thread started by `start()`, which requests a sample from every attached context periodically.
+ * 2. By counting lines if the `line_period` is not zero, which requests a sample every `line_period` lines.
+ *
+ * Stacks are aggregated into a prefix tree, so each sample only costs a few lookups.
+ *
+ * @warning The line callback of attached contexts will be replaced.
+ */
+class sampling_profiler
+{
+public:
+    using clock_type = std::chrono::steady_clock;
+
+    /**
+     * @param line_period Request a sample every `line_period` lines. Zero means only the timer requests samples.
+     * @param record_timeline Record the timestamp of each sample for exporting Chrome trace
+     */
+    explicit sampling_profiler(
+        unsigned int line_period = 0,
+        bool record_timeline = true
+    )
+        : m_line_period(line_period),
+          m_record_timeline(record_timeline),
+          m_start_time(clock_type::now())
+    {
+        // Root of the stack tree
+        m_nodes.push_back({nullptr, 0, 0, 0});
+    }
+
+    sampling_profiler(const sampling_profiler&) = delete;
+
+    ~sampling_profiler()
+    {
+        stop();
+
+        std::lock_guard lock(m_mx);
+        for(auto& s : m_contexts)
+            s->ctx->ClearLineCallback();
+        release_functions();
+    }
+
+    sampling_profiler& operator=(const sampling_profiler&) = delete;
+
+    /**
+     * @brief Attach to a context by installing the line callback
+     */
+    int attach(AS_NAMESPACE_QUALIFIER asIScriptContext* ctx)
+    {
+        if(!ctx) [[unlikely]]
+            return AS_NAMESPACE_QUALIFIER asINVALID_ARG;
+
+        std::lock_guard lock(m_mx);
+        for(const auto& s : m_contexts)
+        {
+            if(s->ctx == ctx)
+                return AS_NAMESPACE_QUALIFIER asALREADY_REGISTERED;
+        }
+
+        auto state = std::make_unique<context_state>();
+        state->self = this;
+        state->ctx = ctx;
+        state->thread_id = m_next_thread_id++;
+        int r = ctx->SetLineCallback(
+            AS_NAMESPACE_QUALIFIER asFUNCTION(&line_callback),
+            state.get(),
+            AS_NAMESPACE_QUALIFIER asCALL_CDECL
+        );
+        if(r < 0)
+            return r;
+
+        m_contexts.push_back(std::move(state));
+        return AS_NAMESPACE_QUALIFIER asSUCCESS;
+    }
+
+    /**
+     * @brief Detach from a context and clear its line callback
+     */
+    void detach(AS_NAMESPACE_QUALIFIER asIScriptContext* ctx)
+    {
+        std::lock_guard lock(m_mx);
+        for(auto it = m_contexts.begin(); it != m_contexts.end(); ++it)
+        {
+            if((*it)->ctx == ctx)
+            {
+                ctx->ClearLineCallback();
+                m_contexts.erase(it);
+                return;
+            }
+        }
+    }
+
+    /**
+     * @brief Start the timer thread
+     *
+     * @param interval Sampling interval
+     */
+    void start(std::chrono::microseconds interval = std::chrono::milliseconds(1))
+    {
+        stop();
+
+        m_interval = interval;
+        m_stop_requested = false;
+        m_timer = std::thread(
+            [this, interval]()
+            {
+                std::unique_lock lock(m_timer_mx);
+                while(!m_timer_cv.wait_for(
+                    lock, interval, [this]()
+                    { return m_stop_requested; }
+                ))
+                {
+                    request_samples();
+                }
+            }
+        );
+    }
+
+    /**
+     * @brief Stop the timer thread
+     */
+    void stop()
+    {
+        if(!m_timer.joinable())
+            return;
+
+        {
+            std::lock_guard lock(m_timer_mx);
+            m_stop_requested = true;
+        }
+        m_timer_cv.notify_all();
+        m_timer.join();
+    }
+
+    /**
+     * @brief Request a sample from every attached context
+     */
+    void request_samples()
+    {
+        std::lock_guard lock(m_mx);
+        for(auto& s : m_contexts)
+            s->requested.store(true, std::memory_order_relaxed);
+    }
+
+    /**
+     * @brief Record the current call stack of a context
+     *
+     * @warning This function must be called in the thread executing the context.
+     */
+    void sample(AS_NAMESPACE_QUALIFIER asIScriptContext* ctx, std::uint32_t thread_id = 0)
+    {
+        const auto now = clock_type::now();
+
+        // Collect frames from the bottom to the top
+        const AS_NAMESPACE_QUALIFIER asUINT depth = ctx->GetCallstackSize();
+        std::lock_guard lock(m_mx);
+        auto& frames = m_frames_buf;
+        frames.clear();
+        for(AS_NAMESPACE_QUALIFIER asUINT i = depth; i-- > 0;)
+        {
+            auto* f = ctx->GetFunction(i);
+            if(!f)
+                continue;
+            frames.emplace_back(f, ctx->GetLineNumber(i));
+        }
+
+        std::size_t node = 0;
+        for(const auto& [f, line] : frames)
+            node = child_node(node, f, line);
+        ++m_nodes[node].self_count;
+        ++m_total_samples;
+
+        if(m_record_timeline)
+        {
+            m_timeline.push_back(
+                {std::chrono::duration_cast<std::chrono::microseconds>(now - m_start_time).count(),
+                 node,
+                 thread_id}
+            );
+        }
+    }
+
+    /**
+     * @brief Discard all recorded samples
+     */
+    void clear()
+    {
+        std::lock_guard lock(m_mx);
+        m_nodes.resize(1);
+        m_nodes[0].self_count = 0;
+        m_children.clear();
+        m_timeline.clear();
+        m_total_samples = 0;
+        release_functions();
+        m_start_time = clock_type::now();
+    }
+
+    [[nodiscard]]
+    std::size_t total_samples() const
+    {
+        std::lock_guard lock(m_mx);
+        return m_total_samples;
+    }
+
+    /**
+     * @brief Write samples in the folded stack format
+     *
+     * Each line is a call stack separated by semicolons followed by the count of samples,
+     * which can be used by flame graph tools like `flamegraph.pl` or speedscope.
+     *
+     * @param with_lines Append line numbers to frames. Samples with different lines will be separated.
+     */
+    void write_folded(std::ostream& os, bool with_lines = true) const
+    {
+        std::lock_guard lock(m_mx);
+
+        std::map<std::string, std::size_t> folded;
+        std::vector<std::size_t> path;
+        for(std::size_t i = 1; i < m_nodes.size(); ++i)
+        {
+            if(m_nodes[i].self_count == 0)
+                continue;
+
+            path.clear();
+            for(std::size_t n = i; n != 0; n = m_nodes[n].parent)
+                path.push_back(n);
+
+            std::string key;
+            for(auto it = path.rbegin(); it != path.rend(); ++it)
+            {
+                if(!key.empty())
+                    key += ';';
+                key += frame_name(*it, with_lines);
+            }
+
+            folded[std::move(key)] += m_nodes[i].self_count;
+        }
+
+        for(const auto& [stack, count] : folded)
+            os << stack << ' ' << count << '\n';
+    }
+
+    /**
+     * @brief Write recorded timeline as Chrome trace events in JSON
+     *
+     * Consecutive samples sharing the same frames are merged into complete events ("ph": "X").
+     * The result can be opened by `chrome://tracing` or Perfetto UI.
+     */
+    void write_chrome_trace(std::ostream& os) const
+    {
+        std::lock_guard lock(m_mx);
+
+        os << "{\"traceEvents\":[";
+        bool first = true;
+
+        // Frames are open on each thread, stored as (node, start time)
+        std::map<std::uint32_t, std::vector<std::pair<std::size_t, std::int64_t>>> open_frames;
+        std::map<std::uint32_t, std::int64_t> last_time;
+
+        auto emit = [&](std::uint32_t tid, std::size_t node, std::int64_t begin, std::int64_t end)
+        {
+            if(!first)
+                os << ',';
+            first = false;
+
+            os << "{\"name\":";
+            asbind20::detail::write_json_string(os, frame_name(node, false));
+            os << ",\"cat\":\"script\",\"ph\":\"X\",\"pid\":0,\"tid\":" << tid
+               << ",\"ts\":" << begin
+               << ",\"dur\":" << (end - begin)
+               << ",\"args\":{\"line\":" << m_nodes[node].line << "}}";
+        };
+
+        std::vector<std::size_t> path;
+        for(const auto& s : m_timeline)
+        {
+            path.clear();
+            for(std::size_t n = s.node; n != 0; n = m_nodes[n].parent)
+                path.push_back(n);
+
+            auto& stack = open_frames[s.thread_id];
+            std::size_t common = 0;
+            while(common < stack.size() &&
+                  common < path.size() &&
+                  stack[common].first == path[path.size() - 1 - common])
+                ++common;
+
+            while(stack.size() > common)
+            {
+                emit(s.thread_id, stack.back().first, stack.back().second, s.timestamp);
+                stack.pop_back();
+            }
+            for(std::size_t i = common; i < path.size(); ++i)
+                stack.emplace_back(path[path.size() - 1 - i], s.timestamp);
+
+            last_time[s.thread_id] = s.timestamp;
+        }
+
+        const std::int64_t tail = std::max<std::int64_t>(
+            1, std::chrono::duration_cast<std::chrono::microseconds>(m_interval).count()
+        );
+        for(auto& [tid, stack] : open_frames)
+        {
+            std::int64_t end = last_time[tid] + tail;
+            while(!stack.empty())
+            {
+                emit(tid, stack.back().first, stack.back().second, end);
+                stack.pop_back();
+            }
+        }
+
+        os << "],\"displayTimeUnit\":\"ms\"}";
+    }
+
+private:
+    struct context_state
+    {
+        sampling_profiler* self;
+        AS_NAMESPACE_QUALIFIER asIScriptContext* ctx;
+        std::uint32_t thread_id;
+        unsigned int line_counter = 0;
+        std::atomic_bool requested = false;
+    };
+
+    struct node
+    {
+        AS_NAMESPACE_QUALIFIER asIScriptFunction* func;
+        int line;
+        std::size_t parent;
+        std::size_t self_count;
+    };
+
+    struct timeline_entry
+    {
+        std::int64_t timestamp;
+        std::size_t node;
+        std::uint32_t thread_id;
+    };
+
+    using node_key = std::tuple<std::size_t, AS_NAMESPACE_QUALIFIER asIScriptFunction*, int>;
+
+    unsigned int m_line_period;
+    bool m_record_timeline;
+    clock_type::time_point m_start_time;
+    std::chrono::microseconds m_interval = std::chrono::milliseconds(1);
+
+    mutable std::mutex m_mx;
+    std::vector<std::unique_ptr<context_state>> m_contexts;
+    std::uint32_t m_next_thread_id = 0;
+    std::vector<node> m_nodes;
+    std::map<node_key, std::size_t> m_children;
+    std::unordered_set<AS_NAMESPACE_QUALIFIER asIScriptFunction*> m_functions;
+    std::vector<timeline_entry> m_timeline;
+    std::vector<std::pair<AS_NAMESPACE_QUALIFIER asIScriptFunction*, int>> m_frames_buf;
+    std::size_t m_total_samples = 0;
+
+    std::thread m_timer;
+    std::mutex m_timer_mx;
+    std::condition_variable m_timer_cv;
+    bool m_stop_requested = false;
+
+    static void line_callback(AS_NAMESPACE_QUALIFIER asIScriptContext* ctx, void* param)
+    {
+        auto* state = static_cast<context_state*>(param);
+
+        bool take = state->requested.exchange(false, std::memory_order_relaxed);
+        const unsigned int period = state->self->m_line_period;
+        if(period != 0 && ++state->line_counter >= period)
+        {
+            state->line_counter = 0;
+            take = true;
+        }
+
+        if(take)
+            state->self->sample(ctx, state->thread_id);
+    }
+
+    std::size_t child_node(std::size_t parent, AS_NAMESPACE_QUALIFIER asIScriptFunction* f, int line)
+    {
+        auto [it, inserted] = m_children.try_emplace(node_key(parent, f, line), m_nodes.size());
+        if(inserted)
+        {
+            // Keep the function alive until exporting
+            if(m_functions.insert(f).second)
+                f->AddRef();
+            m_nodes.push_back({f, line, parent, 0});
+        }
+
+        return it->second;
+    }
+
+    void release_functions()
+    {
+        for(auto* f : m_functions)
+            f->Release();
+        m_functions.clear();
+    }
+
+    std::string frame_name(std::size_t idx, bool with_line) const
+    {
+        const node& n = m_nodes[idx];
+
+        std::string result;
+        const char* section = get_function_section_name(n.func);
+        if(section && *section)
+        {
+            result += section;
+            result += ':';
+        }
+        result += n.func->GetDeclaration(true, true, false);
+        if(with_line)
+        {
+            result += ':';
+            result += std::to_string(n.line);
+        }
+
+        return result;
+    }
+};
+} // namespace asbind20::debugging
+
+#endif
@@ -0,0 +1,914 @@
+/**
+ * @file debugging/trace_recorder.hpp
+ * @author HenryAWE
+ * @brief Low-overhead execution tracing of script contexts
+ */
+
+#ifndef ASBIND20_DEBUGGING_TRACE_RECORDER_HPP
+#define ASBIND20_DEBUGGING_TRACE_RECORDER_HPP
+
+#pragma once
+
+#include <cstddef>
+#include <cstdint>
+#include <atomic>
+#include <chrono>
+#include <condition_variable>
+#include <memory>
+#include <mutex>
+#include <ostream>
+#include <span>
+#include <string>
+#include <system_error>
+#include <thread>
+#include <unordered_map>
+#include <vector>
+#include "../detail/include_as.hpp"
+#include "../detail/config.hpp"
+#include "../detail/err_handler.hpp"
+#include "../detail/json.hpp"
+#include "../detail/user_data.hpp"
+#include "../script_error.hpp"
+
+#if !defined(ASBIND20_TRACE_NO_TSC) && (defined(__x86_64__) || defined(_M_X64) || defined(__i386__) || defined(_M_IX86))
+#    define ASBIND20_TRACE_HAS_TSC
+#    ifdef _MSC_VER
+#        include <intrin.h>
+#    else
+#        include <x86intrin.h>
+#    endif
+#endif
+
+namespace asbind20::debugging
+{
+/**
+ * @brief Kind of trace events
+ */
+enum class trace_event_kind : std::uint8_t
+{
+    script_enter,
+    script_exit,
+    native_enter,
+    native_exit,
+    exception,
+    suspend
+};
+
+/**
+ * @brief Compact binary record of a trace event
+ */
+struct trace_record
+{
+    /// Raw timestamp. It is the TSC on x86, or nanoseconds of the steady clock on other platforms.
+    std::uint64_t ticks;
+    /// Function ID for calls, or string ID for exceptions
+    std::int32_t id;
+    /// Line number for script functions
+    std::int32_t line;
+    trace_event_kind kind;
+};
+
+/**
+ * @brief Decoded trace event
+ */
+struct trace_event
+{
+    trace_event_kind kind;
+    /// Nanoseconds since the creation of the recorder
+    std::uint64_t timestamp_ns;
+    /// Index of the recording thread, starting from 1
+    std::uint32_t tid;
+    std::int32_t id;
+    std::int32_t line;
+};
+
+class trace_recorder;
+
+namespace detail
+{
+    struct traced_function
+    {
+        AS_NAMESPACE_QUALIFIER asGENFUNC_t func;
+        trace_recorder* recorder;
+        int func_id = AS_NAMESPACE_QUALIFIER asERROR;
+    };
+
+    /**
+     * @brief Single-producer single-consumer ring buffer of trace records
+     *
+     * Records are dropped if the buffer is full.
+     */
+    class trace_buffer
+    {
+    public:
+        trace_buffer(std::size_t capacity, std::uint32_t tid)
+            : m_tid(tid)
+        {
+            std::size_t cap = 16;
+            while(cap < capacity)
+                cap <<= 1;
+            m_data = std::make_unique<trace_record[]>(cap);
+            m_mask = cap - 1;
+        }
+
+        bool push(const trace_record& rec) noexcept
+        {
+            const std::size_t head = m_head.load(std::memory_order_relaxed);
+            const std::size_t tail = m_tail.load(std::memory_order_acquire);
+            if(head - tail > m_mask) [[unlikely]]
+            {
+                m_dropped.fetch_add(1, std::memory_order_relaxed);
+                return false;
+            }
+
+            m_data[head & m_mask] = rec;
+            m_head.store(head + 1, std::memory_order_release);
+            return true;
+        }
+
+        template <typename Callback>
+        std::size_t consume(Callback&& fn)
+        {
+            std::size_t tail = m_tail.load(std::memory_order_relaxed);
+            const std::size_t head = m_head.load(std::memory_order_acquire);
+            const std::size_t count = head - tail;
+            for(; tail != head; ++tail)
+                fn(m_data[tail & m_mask]);
+            m_tail.store(tail, std::memory_order_release);
+
+            return count;
+        }
+
+        [[nodiscard]]
+        std::uint64_t dropped() const noexcept
+        {
+            return m_dropped.load(std::memory_order_relaxed);
+        }
+
+        [[nodiscard]]
+        std::uint32_t tid() const noexcept
+        {
+            return m_tid;
+        }
+
+    private:
+        std::unique_ptr<trace_record[]> m_data;
+        std::size_t m_mask;
+        std::uint32_t m_tid;
+
+        alignas(64) std::atomic_size_t m_head = 0;
+        alignas(64) std::atomic_size_t m_tail = 0;
+        std::atomic_uint64_t m_dropped = 0;
+    };
+
+    inline std::uint64_t trace_ticks() noexcept
+    {
+#ifdef ASBIND20_TRACE_HAS_TSC
+        return __rdtsc();
+#else
+        return static_cast<std::uint64_t>(
+            std::chrono::duration_cast<std::chrono::nanoseconds>(
+                std::chrono::steady_clock::now().time_since_epoch()
+            )
+                .count()
+        );
+#endif
+    }
+} // namespace detail
+
+/**
+ * @brief Recorder of execution traces
+ *
+ * Events are written into per-thread lock-free ring buffers as compact binary records.
+ * Function names are only resolved when the records are drained, so recording never formats strings.
+ *
+ * Events are recorded from these sources:
+ * 1. The line callback installed by `attach()`, which detects entering and leaving script functions
+ *    by comparing the call stack between lines.
+ * 2. The exception callback installed by `attach()`.
+ * 3. `end_execution()` or `execute()`, which close remaining frames and record suspension.
+ * 4. Native functions registered by binding generators with `tracing_listener`.
+ *
+ * The recorder is stored in the user data of the engine, so it has the same lifetime as the engine.
+ * Contexts should be detached before they are released.
+ * The recorder created by `get_or_create()` won't touch the contexts that are still attached when it's destroyed with the engine.
+ *
+ * @warning The line callback and the exception callback of attached contexts will be replaced.
+ */
+class trace_recorder
+{
+public:
+    /**
+     * @param engine Script engine
+     * @param capacity Capacity of the ring buffer of each thread
+     */
+    explicit trace_recorder(
+        AS_NAMESPACE_QUALIFIER asIScriptEngine* engine,
+        std::size_t capacity = 1 << 16
+    )
+        : m_engine(engine),
+          m_capacity(capacity),
+          m_id(next_recorder_id()),
+          m_start_ticks(detail::trace_ticks()),
+          m_start_time(std::chrono::steady_clock::now())
+    {}
+
+    trace_recorder(const trace_recorder&) = delete;
+
+    ~trace_recorder()
+    {
+        stop();
+
+        // The recorder owned by the engine is destroyed after all contexts,
+        // because every context holds a reference to the engine.
+        // States of contexts that haven't been detached are stale, so they are dropped without calling into them.
+        if(m_engine_owned)
+            return;
+
+        std::lock_guard lock(m_mx);
+        for(auto& s : m_contexts)
+        {
+            s->ctx->ClearLineCallback();
+            s->ctx->ClearExceptionCallback();
+        }
+    }
+
+    trace_recorder& operator=(const trace_recorder&) = delete;
+
+    /**
+     * @brief Get the recorder of an engine
+     *
+     * @return Null if the recorder is not created
+     */
+    [[nodiscard]]
+    static trace_recorder* get(const AS_NAMESPACE_QUALIFIER asIScriptEngine* engine)
+    {
+        if(!engine) [[unlikely]]
+            return nullptr;
+        return static_cast<trace_recorder*>(
+            engine->GetUserData(asbind20::detail::trace_recorder_user_data)
+        );
+    }
+
+    /**
+     * @brief Get the recorder of an engine, creating it if it doesn't exist
+     *
+     * @param engine Script engine
+     * @param capacity Capacity of the ring buffer of each thread. Only used when creating the recorder.
+     */
+    static trace_recorder& get_or_create(
+        AS_NAMESPACE_QUALIFIER asIScriptEngine* engine,
+        std::size_t capacity = 1 << 16
+    )
+    {
+        ASBIND20_ASSERT(engine != nullptr);
+
+        if(auto* existing = get(engine))
+            return *existing;
+
+        auto* recorder = new trace_recorder(engine, capacity);
+        recorder->m_engine_owned = true;
+        engine->SetUserData(recorder, asbind20::detail::trace_recorder_user_data);
+        engine->SetEngineUserDataCleanupCallback(
+            [](AS_NAMESPACE_QUALIFIER asIScriptEngine* engine)
+            {
+                delete get(engine);
+            },
+            asbind20::detail::trace_recorder_user_data
+        );
+        return *recorder;
+    }
+
+    /**
+     * @brief Enable or disable recording. Recording is enabled by default.
+     */
+    void set_enabled(bool enabled) noexcept
+    {
+        m_enabled.store(enabled, std::memory_order_relaxed);
+    }
+
+    [[nodiscard]]
+    bool enabled() const noexcept
+    {
+        return m_enabled.load(std::memory_order_relaxed);
+    }
+
+    /**
+     * @brief Record an event from the calling thread
+     */
+    void record(trace_event_kind kind, int id, int line = 0) noexcept
+    {
+        if(!enabled())
+            return;
+
+        auto* buf = thread_buffer();
+        if(!buf) [[unlikely]]
+            return;
+        buf->push({detail::trace_ticks(), id, line, kind});
+    }
+
+    /**
+     * @brief Attach to a context by installing the line callback and the exception callback
+     */
+    int attach(AS_NAMESPACE_QUALIFIER asIScriptContext* ctx)
+    {
+        if(!ctx) [[unlikely]]
+            return AS_NAMESPACE_QUALIFIER asINVALID_ARG;
+
+        std::lock_guard lock(m_mx);
+        for(const auto& s : m_contexts)
+        {
+            if(s->ctx == ctx)
+                return AS_NAMESPACE_QUALIFIER asALREADY_REGISTERED;
+        }
+
+        auto state = std::make_unique<context_state>();
+        state->self = this;
+        state->ctx = ctx;
+        state->stack.reserve(16);
+
+        int r = ctx->SetLineCallback(
+            AS_NAMESPACE_QUALIFIER asFUNCTION(&line_callback),
+            state.get(),
+            AS_NAMESPACE_QUALIFIER asCALL_CDECL
+        );
+        if(r < 0)
+            return r;
+        r = ctx->SetExceptionCallback(
+            AS_NAMESPACE_QUALIFIER asFUNCTION(&exception_callback),
+            state.get(),
+            AS_NAMESPACE_QUALIFIER asCALL_CDECL
+        );
+        if(r < 0)
+        {
+            ctx->ClearLineCallback();
+            return r;
+        }
+
+        m_contexts.push_back(std::move(state));
+        return AS_NAMESPACE_QUALIFIER asSUCCESS;
+    }
+
+    /**
+     * @brief Detach from a context and clear its callbacks
+     */
+    void detach(AS_NAMESPACE_QUALIFIER asIScriptContext* ctx)
+    {
+        std::lock_guard lock(m_mx);
+        for(auto it = m_contexts.begin(); it != m_contexts.end(); ++it)
+        {
+            if((*it)->ctx == ctx)
+            {
+                ctx->ClearLineCallback();
+                ctx->ClearExceptionCallback();
+                m_contexts.erase(it);
+                return;
+            }
+        }
+    }
+
+    /**
+     * @brief Close the frames remaining in the trace after the execution of an attached context returns
+     *
+     * @param ctx Attached context
+     * @param r Result of `asIScriptContext::Execute()`
+     */
+    void end_execution(AS_NAMESPACE_QUALIFIER asIScriptContext* ctx, int r)
+    {
+        auto* state = find_state(ctx);
+        if(!state)
+            return;
+
+        if(r == AS_NAMESPACE_QUALIFIER asEXECUTION_SUSPENDED)
+        {
+            // Frames are still alive, and they will be continued by the next execution
+            record(trace_event_kind::suspend, state->stack.empty() ? -1 : state->stack.back(), 0);
+            return;
+        }
+
+        while(!state->stack.empty())
+        {
+            record(trace_event_kind::script_exit, state->stack.back());
+            state->stack.pop_back();
+        }
+    }
+
+    /**
+     * @brief Execute an attached context and close the remaining frames
+     *
+     * @return Result of `asIScriptContext::Execute()`
+     */
+    int execute(AS_NAMESPACE_QUALIFIER asIScriptContext* ctx)
+    {
+        int r = ctx->Execute();
+        end_execution(ctx, r);
+        return r;
+    }
+
+    /**
+     * @brief Drain recorded events from all threads
+     *
+     * This function can be called from any thread, but only one thread can drain at the same time.
+     *
+     * @param out Events will be appended to it
+     * @return Count of drained events
+     */
+    std::size_t drain(std::vector<trace_event>& out)
+    {
+        std::lock_guard drain_lock(m_drain_mx);
+
+        std::vector<detail::trace_buffer*> buffers;
+        {
+            std::lock_guard lock(m_mx);
+            buffers.reserve(m_buffers.size());
+            for(auto& b : m_buffers)
+                buffers.push_back(b.get());
+        }
+
+        const double ns_per_tick = calibrate();
+        std::size_t count = 0;
+        for(auto* buf : buffers)
+        {
+            count += buf->consume(
+                [&](const trace_record& rec)
+                {
+                    const auto elapsed = rec.ticks >= m_start_ticks ? rec.ticks - m_start_ticks : 0;
+                    out.push_back({
+                        rec.kind,
+                        static_cast<std::uint64_t>(static_cast<double>(elapsed) * ns_per_tick),
+                        buf->tid(),
+                        rec.id,
+                        rec.line
+                    });
+                }
+            );
+        }
+
+        return count;
+    }
+
+    /**
+     * @brief Count of records dropped because of full buffers
+     */
+    [[nodiscard]]
+    std::uint64_t dropped() const
+    {
+        std::lock_guard lock(m_mx);
+        std::uint64_t result = 0;
+        for(const auto& b : m_buffers)
+            result += b->dropped();
+        return result;
+    }
+
+    /**
+     * @brief Get the message of an exception event
+     */
+    [[nodiscard]]
+    std::string exception_string(int id) const
+    {
+        std::lock_guard lock(m_mx);
+        if(id < 0 || static_cast<std::size_t>(id) >= m_strings.size())
+            return {};
+        return m_strings[id];
+    }
+
+    /**
+     * @brief Write events in the Chrome trace event format, which can also be loaded by Perfetto
+     *
+     * @param os Output stream
+     * @param events Events to write
+     * @param first True if these are the first events of the file
+     */
+    void write_chrome_trace_events(std::ostream& os, std::span<const trace_event> events, bool first = true)
+    {
+        using asbind20::detail::write_json_string;
+
+        for(const auto& e : events)
+        {
+            if(!first)
+                os << ",\n";
+            first = false;
+
+            const char* ph = "i";
+            const char* cat = "script";
+            switch(e.kind)
+            {
+            case trace_event_kind::script_enter:
+                ph = "B";
+                break;
+            case trace_event_kind::script_exit:
+                ph = "E";
+                break;
+            case trace_event_kind::native_enter:
+                ph = "B";
+                cat = "native";
+                break;
+            case trace_event_kind::native_exit:
+                ph = "E";
+                cat = "native";
+                break;
+            case trace_event_kind::exception:
+            case trace_event_kind::suspend:
+                break;
+            }
+
+            os << "{\"name\":";
+            if(e.kind == trace_event_kind::exception)
+                write_json_string(os, exception_string(e.id));
+            else if(e.kind == trace_event_kind::suspend)
+                os << "\"suspend\"";
+            else
+                write_json_string(os, function_name(e.id));
+
+            // Timestamps are in microseconds
+            os << ",\"cat\":\"" << cat
+               << "\",\"ph\":\"" << ph
+               << "\",\"ts\":" << e.timestamp_ns / 1000 << '.' << (e.timestamp_ns % 1000) / 100
+               << ",\"pid\":1,\"tid\":" << e.tid;
+            if(ph[0] == 'i')
+                os << ",\"s\":\"t\"";
+            if(e.line != 0)
+                os << ",\"args\":{\"line\":" << e.line << '}';
+            os << '}';
+        }
+    }
+
+    /**
+     * @brief Drain all events and write them as a complete Chrome trace file
+     */
+    void write_chrome_trace(std::ostream& os)
+    {
+        std::vector<trace_event> events;
+        drain(events);
+
+        os << "{\"traceEvents\":[\n";
+        write_chrome_trace_events(os, events);
+        os << "\n]}\n";
+    }
+
+    /**
+     * @brief Start a background thread flushing events into a stream periodically
+     *
+     * The output is a JSON array of Chrome trace events.
+     *
+     * @param os Output stream. It must be alive until `stop()`.
+     * @param interval Interval between flushes
+     */
+    void start(std::ostream& os, std::chrono::milliseconds interval = std::chrono::milliseconds(100))
+    {
+        stop();
+
+        m_stop_requested = false;
+        m_flusher = std::thread(
+            [this, &os, interval]()
+            {
+                std::vector<trace_event> events;
+                bool first = true;
+                os << "[\n";
+
+                std::unique_lock lock(m_flusher_mx);
+                while(true)
+                {
+                    const bool stopping = m_stop_requested;
+                    lock.unlock();
+
+                    events.clear();
+                    drain(events);
+                    if(!events.empty())
+                    {
+                        write_chrome_trace_events(os, events, first);
+                        first = false;
+                    }
+
+                    if(stopping)
+                        break;
+
+                    lock.lock();
+                    m_flusher_cv.wait_for(
+                        lock, interval, [this]()
+                        { return m_stop_requested; }
+                    );
+                }
+
+                os << "\n]\n";
+                os.flush();
+                AS_NAMESPACE_QUALIFIER asThreadCleanup();
+            }
+        );
+    }
+
+    /**
+     * @brief Stop the background flushing after writing remaining events
+     */
+    void stop()
+    {
+        if(!m_flusher.joinable())
+            return;
+
+        {
+            std::lock_guard lock(m_flusher_mx);
+            m_stop_requested = true;
+        }
+        m_flusher_cv.notify_all();
+        m_flusher.join();
+    }
+
+    [[nodiscard]]
+    bool running() const noexcept
+    {
+        return m_flusher.joinable();
+    }
+
+    [[nodiscard]]
+    AS_NAMESPACE_QUALIFIER asIScriptEngine* get_engine() const noexcept
+    {
+        return m_engine;
+    }
+
+    /**
+     * @brief Create a record for a generic function to be registered
+     */
+    detail::traced_function* add_traced(AS_NAMESPACE_QUALIFIER asGENFUNC_t func)
+    {
+        std::lock_guard lock(m_mx);
+        m_traced.push_back(std::make_unique<detail::traced_function>(func, this));
+        return m_traced.back().get();
+    }
+
+private:
+    struct context_state
+    {
+        trace_recorder* self;
+        AS_NAMESPACE_QUALIFIER asIScriptContext* ctx;
+        /// IDs of functions on the call stack, from the bottom to the top
+        std::vector<int> stack;
+    };
+
+    AS_NAMESPACE_QUALIFIER asIScriptEngine* m_engine;
+    std::size_t m_capacity;
+    std::uint64_t m_id;
+    std::atomic_bool m_enabled = true;
+    bool m_engine_owned = false;
+
+    mutable std::mutex m_mx;
+    std::vector<std::unique_ptr<context_state>> m_contexts;
+    std::vector<std::unique_ptr<detail::trace_buffer>> m_buffers;
+    std::vector<std::string> m_strings;
+    std::vector<std::unique_ptr<detail::traced_function>> m_traced;
+
+    std::mutex m_drain_mx;
+    std::uint64_t m_start_ticks;
+    std::chrono::steady_clock::time_point m_start_time;
+    // Names are cached by both the background flusher and the user writing traces
+    std::mutex m_names_mx;
+    std::unordered_map<int, std::string> m_names;
+
+    std::thread m_flusher;
+    std::mutex m_flusher_mx;
+    std::condition_variable m_flusher_cv;
+    bool m_stop_requested = false;
+
+    static std::uint64_t next_recorder_id() noexcept
+    {
+        static std::atomic_uint64_t counter = 0;
+        return ++counter;
+    }
+
+    detail::trace_buffer* thread_buffer()
+    {
+        // Cache the buffer of the last used recorder.
+        // Recorder IDs are never reused, so a destroyed recorder won't be matched.
+        struct cache_t
+        {
+            std::uint64_t recorder_id = 0;
+            detail::trace_buffer* buf = nullptr;
+        };
+        static thread_local cache_t cache;
+
+        if(cache.recorder_id == m_id) [[likely]]
+            return cache.buf;
+
+        // Slow path: Look for the buffer of this thread, or create a new one
+        static thread_local std::unordered_map<std::uint64_t, detail::trace_buffer*> buffers;
+        auto& buf = buffers[m_id];
+        if(!buf)
+        {
+            std::lock_guard lock(m_mx);
+            m_buffers.push_back(std::make_unique<detail::trace_buffer>(
+                m_capacity, static_cast<std::uint32_t>(m_buffers.size() + 1)
+            ));
+            buf = m_buffers.back().get();
+        }
+
+        cache = {m_id, buf};
+        return buf;
+    }
+
+    /**
+     * @brief Get nanoseconds per tick
+     */
+    double calibrate()
+    {
+#ifdef ASBIND20_TRACE_HAS_TSC
+        // Wait for enough time to get a stable ratio
+        auto now = std::chrono::steady_clock::now();
+        while(now - m_start_time < std::chrono::milliseconds(1))
+            now = std::chrono::steady_clock::now();
+        const std::uint64_t ticks = detail::trace_ticks();
+
+        const auto ns = std::chrono::duration_cast<std::chrono::nanoseconds>(now - m_start_time).count();
+        return static_cast<double>(ns) / static_cast<double>(ticks - m_start_ticks);
+#else
+        return 1.0;
+#endif
+    }
+
+    std::string function_name(int id)
+    {
+        std::lock_guard lock(m_names_mx);
+        auto [it, inserted] = m_names.try_emplace(id);
+        if(inserted)
+        {
+            auto* f = m_engine ? m_engine->GetFunctionById(id) : nullptr;
+            if(f)
+                it->second = f->GetDeclaration(true, true, false);
+            else
+                it->second = "<unknown>";
+        }
+
+        return it->second;
+    }
+
+    context_state* find_state(AS_NAMESPACE_QUALIFIER asIScriptContext* ctx)
+    {
+        std::lock_guard lock(m_mx);
+        for(auto& s : m_contexts)
+        {
+            if(s->ctx == ctx)
+                return s.get();
+        }
+        return nullptr;
+    }
+
+    void on_line(context_state& state)
+    {
+        auto* ctx = state.ctx;
+        const std::size_t depth = ctx->GetCallstackSize();
+        auto& stack = state.stack;
+
+        // Fast path: still in the same function
+        auto* top = ctx->GetFunction(0);
+        const int top_id = top ? top->GetId() : -1;
+        if(depth == stack.size() && !stack.empty() && stack.back() == top_id)
+            return;
+
+        // Find the common frames from the bottom
+        std::size_t common = 0;
+        while(common < depth && common < stack.size())
+        {
+            auto* f = ctx->GetFunction(static_cast<AS_NAMESPACE_QUALIFIER asUINT>(depth - 1 - common));
+            if((f ? f->GetId() : -1) != stack[common])
+                break;
+            ++common;
+        }
+
+        while(stack.size() > common)
+        {
+            record(trace_event_kind::script_exit, stack.back());
+            stack.pop_back();
+        }
+        for(std::size_t i = common; i < depth; ++i)
+        {
+            const auto level = static_cast<AS_NAMESPACE_QUALIFIER asUINT>(depth - 1 - i);
+            auto* f = ctx->GetFunction(level);
+            const int id = f ? f->GetId() : -1;
+            stack.push_back(id);
+            record(trace_event_kind::script_enter, id, ctx->GetLineNumber(level));
+        }
+    }
+
+    void on_exception(context_state& state)
+    {
+        if(!enabled())
+            return;
+
+        int id;
+        {
+            const char* msg = state.ctx->GetExceptionString();
+            std::lock_guard lock(m_mx);
+            id = static_cast<int>(m_strings.size());
+            m_strings.emplace_back(msg ? msg : "");
+        }
+        record(trace_event_kind::exception, id, state.ctx->GetExceptionLineNumber());
+    }
+
+    static void line_callback(AS_NAMESPACE_QUALIFIER asIScriptContext*, void* param)
+    {
+        auto* state = static_cast<context_state*>(param);
+        state->self->on_line(*state);
+    }
+
+    static void exception_callback(AS_NAMESPACE_QUALIFIER asIScriptContext*, void* param)
+    {
+        auto* state = static_cast<context_state*>(param);
+        state->self->on_exception(*state);
+    }
+};
+
+namespace detail
+{
+    inline void traced_generic_thunk(AS_NAMESPACE_QUALIFIER asIScriptGeneric* gen)
+    {
+        auto* rec = static_cast<traced_function*>(gen->GetAuxiliary());
+
+        // Record the exit even if the wrapped function throws
+        struct guard_t
+        {
+            traced_function* rec;
+
+            ~guard_t()
+            {
+                rec->recorder->record(trace_event_kind::native_exit, rec->func_id);
+            }
+        } guard{rec};
+
+        rec->recorder->record(trace_event_kind::native_enter, rec->func_id);
+        rec->func(gen);
+    }
+} // namespace detail
+
+/**
+ * @brief Listener for tracing calls of registered functions
+ *
+ * Generic functions registered by binding generators with this listener are wrapped by a thunk
+ * recording native enter and exit events into the recorder of the engine.
+ *
+ * @note The recorder must be created by `trace_recorder::get_or_create()` before registering functions.
+ *       Only functions using the generic calling convention without an auxiliary object can be traced.
+ */
+class tracing_listener
+{
+public:
+    template <typename BindingGenerator>
+    void wrap_generic(
+        BindingGenerator& gen,
+        AS_NAMESPACE_QUALIFIER asGENFUNC_t& gfn,
+        void*& aux
+    )
+    {
+        if(aux != nullptr || gfn == nullptr)
+            return;
+
+        auto* recorder = trace_recorder::get(gen.get_engine());
+        if(!recorder)
+            return;
+
+        m_pending = recorder->add_traced(gfn);
+        gfn = &detail::traced_generic_thunk;
+        aux = m_pending;
+    }
+
+    template <typename BindingGenerator>
+    void on_function(BindingGenerator&, int id)
+    {
+        commit_pending(id);
+        report_error(id, "bad function");
+    }
+
+    template <typename BindingGenerator>
+    void on_method(BindingGenerator&, int id)
+    {
+        commit_pending(id);
+        report_error(id, "bad method");
+    }
+
+private:
+    detail::traced_function* m_pending = nullptr;
+
+    void commit_pending(int id)
+    {
+        if(!m_pending)
+            return;
+        m_pending->func_id = id;
+        m_pending = nullptr;
+    }
+
+    static void report_error(
+        [[maybe_unused]] int id,
+        [[maybe_unused]] const char* what
+    )
+    {
+        if(id >= 0) [[likely]]
+            return;
+
+#ifndef ASBIND20_CONFIG_NO_THROW_ON_BAD_BINDING
+        auto code = static_cast<AS_NAMESPACE_QUALIFIER asERetCodes>(id);
+        ::asbind20::detail::throw_<std::system_error>(
+            make_error_code(code), what
+        );
+#endif
+    }
+};
+} // namespace asbind20::debugging
+
+#endif
@@ -0,0 +1,183 @@
+/**
+ * @file detail/byte_code.hpp
+ * @author HenryAWE
+ * @brief Helpers for walking the byte code of script functions
+ */
+
+#ifndef ASBIND20_DETAIL_BYTE_CODE_HPP
+#define ASBIND20_DETAIL_BYTE_CODE_HPP
+
+#pragma once
+
+#include <cstddef>
+#include <span>
+#include "include_as.hpp"
+
+namespace asbind20::detail
+{
+/**
+ * @brief Size of a pointer argument in DWORDs
+ */
+inline constexpr std::size_t bc_ptr_size =
+    sizeof(AS_NAMESPACE_QUALIFIER asPWORD) / sizeof(AS_NAMESPACE_QUALIFIER asDWORD);
+
+[[nodiscard]]
+inline AS_NAMESPACE_QUALIFIER asEBCInstr bc_op(const AS_NAMESPACE_QUALIFIER asDWORD* bc) noexcept
+{
+    return static_cast<AS_NAMESPACE_QUALIFIER asEBCInstr>(
+        *reinterpret_cast<const AS_NAMESPACE_QUALIFIER asBYTE*>(bc)
+    );
+}
+
+/**
+ * @brief Size of an instruction in DWORDs
+ */
+[[nodiscard]]
+inline std::size_t bc_size(AS_NAMESPACE_QUALIFIER asEBCInstr op) noexcept
+{
+    int sz = AS_NAMESPACE_QUALIFIER asBCTypeSize[AS_NAMESPACE_QUALIFIER asBCInfo[op].type];
+    // Guard against pseudo instructions, which should not appear in the final byte code
+    return sz > 0 ? static_cast<std::size_t>(sz) : 1;
+}
+
+/**
+ * @brief Get the byte code of a script function
+ *
+ * @return Empty span if the function has no byte code
+ */
+[[nodiscard]]
+inline std::span<AS_NAMESPACE_QUALIFIER asDWORD> get_byte_code(
+    AS_NAMESPACE_QUALIFIER asIScriptFunction* func
+)
+{
+    if(!func) [[unlikely]]
+        return {};
+
+    AS_NAMESPACE_QUALIFIER asUINT len = 0;
+    AS_NAMESPACE_QUALIFIER asDWORD* bc = func->GetByteCode(&len);
+    if(!bc)
+        return {};
+    return {bc, len};
+}
+
+/**
+ * @brief Invoke the callback with the position of every instruction in the byte code
+ *
+ * @param bc Byte code
+ * @param fn Callback with signature similar to `void(const asDWORD* instr, std::size_t pos)`
+ */
+template <typename Callback>
+void for_each_instruction(std::span<const AS_NAMESPACE_QUALIFIER asDWORD> bc, Callback&& fn)
+{
+    std::size_t pos = 0;
+    while(pos < bc.size())
+    {
+        const AS_NAMESPACE_QUALIFIER asDWORD* instr = bc.data() + pos;
+        fn(instr, pos);
+        pos += bc_size(bc_op(instr));
+    }
+}
+
+/**
+ * @brief Get the function referenced by a call-like instruction
+ *
+ * @return Null if the instruction doesn't refer to a function
+ */
+[[nodiscard]]
+inline AS_NAMESPACE_QUALIFIER asIScriptFunction* bc_referenced_function(
+    AS_NAMESPACE_QUALIFIER asIScriptEngine* engine,
+    const AS_NAMESPACE_QUALIFIER asDWORD* instr
+)
+{
+    switch(bc_op(instr))
+    {
+    case AS_NAMESPACE_QUALIFIER asBC_CALL:
+    case AS_NAMESPACE_QUALIFIER asBC_CALLINTF:
+    case AS_NAMESPACE_QUALIFIER asBC_CALLSYS:
+    case AS_NAMESPACE_QUALIFIER asBC_Thiscall1:
+        return engine->GetFunctionById(*reinterpret_cast<const int*>(instr + 1));
+
+    case AS_NAMESPACE_QUALIFIER asBC_ALLOC:
+        // The ID of constructor follows the pointer to type
+        return engine->GetFunctionById(
+            *reinterpret_cast<const int*>(instr + 1 + bc_ptr_size)
+        );
+
+    case AS_NAMESPACE_QUALIFIER asBC_FuncPtr:
+        return reinterpret_cast<AS_NAMESPACE_QUALIFIER asIScriptFunction*>(
+            *reinterpret_cast<const AS_NAMESPACE_QUALIFIER asPWORD*>(instr + 1)
+        );
+
+    default:
+        return nullptr;
+    }
+}
+
+/**
+ * @brief Get the destination of a relative jump instruction
+ *
+ * @param instr Instruction
+ * @param pos Position of the instruction in DWORDs
+ * @param[out] target Position of the destination in DWORDs
+ * @return False if the instruction is not a relative jump
+ */
+inline bool bc_jump_target(
+    const AS_NAMESPACE_QUALIFIER asDWORD* instr,
+    std::size_t pos,
+    std::size_t& target
+) noexcept
+{
+    const auto op = bc_op(instr);
+    switch(op)
+    {
+    case AS_NAMESPACE_QUALIFIER asBC_JMP:
+    case AS_NAMESPACE_QUALIFIER asBC_JZ:
+    case AS_NAMESPACE_QUALIFIER asBC_JNZ:
+    case AS_NAMESPACE_QUALIFIER asBC_JS:
+    case AS_NAMESPACE_QUALIFIER asBC_JNS:
+    case AS_NAMESPACE_QUALIFIER asBC_JP:
+    case AS_NAMESPACE_QUALIFIER asBC_JNP:
+    case AS_NAMESPACE_QUALIFIER asBC_JLowZ:
+    case AS_NAMESPACE_QUALIFIER asBC_JLowNZ:
+        // The offset is relative to the next instruction
+        target = static_cast<std::size_t>(
+            static_cast<std::ptrdiff_t>(pos + bc_size(op)) +
+            *reinterpret_cast<const int*>(instr + 1)
+        );
+        return true;
+
+    default:
+        return false;
+    }
+}
+
+/**
+ * @brief Get the address of global variable referenced by an instruction
+ *
+ * @return Null if the instruction doesn't refer to a global variable
+ */
+[[nodiscard]]
+inline void* bc_referenced_global(const AS_NAMESPACE_QUALIFIER asDWORD* instr) noexcept
+{
+    switch(bc_op(instr))
+    {
+    case AS_NAMESPACE_QUALIFIER asBC_PGA:
+    case AS_NAMESPACE_QUALIFIER asBC_PshGPtr:
+    case AS_NAMESPACE_QUALIFIER asBC_LDG:
+    case AS_NAMESPACE_QUALIFIER asBC_PshG4:
+    case AS_NAMESPACE_QUALIFIER asBC_SetG4:
+    case AS_NAMESPACE_QUALIFIER asBC_CpyVtoG4:
+    case AS_NAMESPACE_QUALIFIER asBC_CpyGtoV4:
+    case AS_NAMESPACE_QUALIFIER asBC_LdGRdR4:
+        // Word arguments are packed into the first DWORD, so the pointer always follows it
+        return reinterpret_cast<void*>(
+            *reinterpret_cast<const AS_NAMESPACE_QUALIFIER asPWORD*>(instr + 1)
+        );
+
+    default:
+        return nullptr;
+    }
+}
+} // namespace asbind20::detail
+
+#endif
@@ -0,0 +1,92 @@
+/**
+ * @file detail/hash.hpp
+ * @author HenryAWE
+ * @brief Non-cryptographic hash for content digests
+ */
+
+#ifndef ASBIND20_DETAIL_HASH_HPP
+#define ASBIND20_DETAIL_HASH_HPP
+
+#pragma once
+
+#include <cstdint>
+#include <cstddef>
+#include <string_view>
+#include <type_traits>
+
+namespace asbind20::detail
+{
+/**
+ * @brief Incremental 64-bit FNV-1a hasher
+ *
+ * The result is stable across runs, which makes it suitable for content-addressed file names.
+ */
+class fnv1a_64
+{
+public:
+    using value_type = std::uint64_t;
+
+    static constexpr value_type offset_basis = 0xcbf29ce484222325ull;
+    static constexpr value_type prime = 0x100000001b3ull;
+
+    constexpr fnv1a_64() noexcept = default;
+
+    constexpr fnv1a_64& update(const void* data, std::size_t size) noexcept
+    {
+        const auto* p = static_cast<const unsigned char*>(data);
+        for(std::size_t i = 0; i < size; ++i)
+        {
+            m_val ^= static_cast<value_type>(p[i]);
+            m_val *= prime;
+        }
+        return *this;
+    }
+
+    /**
+     * @brief Hash a string with its length prefixed, so adjacent strings cannot be confused
+     */
+    constexpr fnv1a_64& update(std::string_view str) noexcept
+    {
+        update_value(static_cast<std::uint64_t>(str.size()));
+        for(char c : str)
+        {
+            m_val ^= static_cast<value_type>(static_cast<unsigned char>(c));
+            m_val *= prime;
+        }
+        return *this;
+    }
+
+    /**
+     * @brief Hash a null-terminated string. Null pointer is treated as empty string.
+     */
+    constexpr fnv1a_64& update(const char* str) noexcept
+    {
+        return update(str ? std::string_view(str) : std::string_view());
+    }
+
+    template <typename T>
+    requires std::is_integral_v<T> || std::is_enum_v<T>
+    constexpr fnv1a_64& update_value(T val) noexcept
+    {
+        auto u = static_cast<std::uint64_t>(val);
+        for(int i = 0; i < 8; ++i)
+        {
+            m_val ^= static_cast<value_type>(u & 0xFF);
+            m_val *= prime;
+            u >>= 8;
+        }
+        return *this;
+    }
+
+    [[nodiscard]]
+    constexpr value_type value() const noexcept
+    {
+        return m_val;
+    }
+
+private:
+    value_type m_val = offset_basis;
+};
+} // namespace asbind20::detail
+
+#endif
@@ -0,0 +1,63 @@
+/**
+ * @file detail/json.hpp
+ * @author HenryAWE
+ * @brief Minimal helpers for writing JSON reports
+ */
+
+#ifndef ASBIND20_DETAIL_JSON_HPP
+#define ASBIND20_DETAIL_JSON_HPP
+
+#pragma once
+
+#include <ostream>
+#include <string_view>
+
+namespace asbind20::detail
+{
+/**
+ * @brief Write a quoted and escaped JSON string
+ */
+inline std::ostream& write_json_string(std::ostream& os, std::string_view str)
+{
+    constexpr char hex_digits[] = "0123456789abcdef";
+
+    os.put('"');
+    for(char c : str)
+    {
+        switch(c)
+        {
+        case '"':
+            os << "\\\"";
+            break;
+        case '\\':
+            os << "\\\\";
+            break;
+        case '\n':
+            os << "\\n";
+            break;
+        case '\r':
+            os << "\\r";
+            break;
+        case '\t':
+            os << "\\t";
+            break;
+
+        default:
+            if(static_cast<unsigned char>(c) < 0x20)
+            {
+                os << "\\u00"
+                   << hex_digits[(c >> 4) & 0xF]
+                   << hex_digits[c & 0xF];
+            }
+            else
+                os.put(c);
+            break;
+        }
+    }
+    os.put('"');
+
+    return os;
+}
+} // namespace asbind20::detail
+
+#endif
@@ -0,0 +1,49 @@
+/**
+ * @file detail/user_data.hpp
+ * @author HenryAWE
+ * @brief Identifiers of user data used by the library
+ */
+
+#ifndef ASBIND20_DETAIL_USER_DATA_HPP
+#define ASBIND20_DETAIL_USER_DATA_HPP
+
+#pragma once
+
+#include "include_as.hpp"
+
+namespace asbind20::detail
+{
+/**
+ * @brief Base of user data types reserved by the library
+ *
+ * The value spells "asb\0" in ASCII, which is unlikely to collide with the types chosen by the application.
+ */
+inline constexpr AS_NAMESPACE_QUALIFIER asPWORD user_data_base = 0x61736200;
+
+/**
+ * @brief Engine user data type of the call statistics registry
+ */
+inline constexpr AS_NAMESPACE_QUALIFIER asPWORD call_stats_user_data = user_data_base + 1;
+
+/**
+ * @brief Engine user data type of the trace recorder
+ */
+inline constexpr AS_NAMESPACE_QUALIFIER asPWORD trace_recorder_user_data = user_data_base + 2;
+
+/**
+ * @brief Engine user data type of the interface manifest recorded by `recording_listener`
+ */
+inline constexpr AS_NAMESPACE_QUALIFIER asPWORD interface_manifest_user_data = user_data_base + 3;
+
+/**
+ * @brief Engine user data type of the entries registered by `lazy_registry`
+ */
+inline constexpr AS_NAMESPACE_QUALIFIER asPWORD lazy_registry_user_data = user_data_base + 4;
+
+/**
+ * @brief Engine user data type of the `engine_local_lock`
+ */
+inline constexpr AS_NAMESPACE_QUALIFIER asPWORD engine_local_lock_user_data = user_data_base + 5;
+} // namespace asbind20::detail
+
+#endif
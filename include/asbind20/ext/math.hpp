@@ -0,0 +1,1130 @@
+/**
+ * @file ext/math.hpp
+ * @author HenryAWE
+ * @brief Presets of vector, quaternion, and matrix types for scripts
+ *
+ * This header is optional and not included by `asbind.hpp`.
+ */
+
+#ifndef ASBIND20_EXT_MATH_HPP
+#define ASBIND20_EXT_MATH_HPP
+
+#pragma once
+
+#include <cmath>
+#include <cstddef>
+#include <cstring>
+#include <span>
+#include <string_view>
+#include <type_traits>
+#include "../detail/include_as.hpp"
+#include "../detail/config.hpp"
+#include "../utility.hpp"
+#include "../policies.hpp"
+#include "../bind.hpp"
+#include "../operators.hpp"
+
+#ifndef ASBIND20_CONFIG_EXT_MATH_NO_SIMD
+#    if defined(__SSE__) || defined(_M_X64) || defined(_M_AMD64) || (defined(_M_IX86_FP) && _M_IX86_FP >= 1)
+#        define ASBIND20_EXT_MATH_HAS_SSE
+#        include <xmmintrin.h>
+#    elif defined(__ARM_NEON) || defined(_M_ARM64)
+#        define ASBIND20_EXT_MATH_HAS_NEON
+#        include <arm_neon.h>
+#    endif
+#endif
+
+namespace asbind20::ext
+{
+namespace detail
+{
+    // Kernels of 4 floats.
+    // AngelScript only aligns values on the script stack to 4 bytes,
+    // so all loads and stores are unaligned.
+
+#if defined(ASBIND20_EXT_MATH_HAS_SSE)
+    using f32x4 = __m128;
+
+    inline f32x4 load_f32x4(const float* p) noexcept
+    {
+        return _mm_loadu_ps(p);
+    }
+
+    inline void store_f32x4(float* p, f32x4 v) noexcept
+    {
+        _mm_storeu_ps(p, v);
+    }
+
+    inline f32x4 splat_f32x4(float f) noexcept
+    {
+        return _mm_set1_ps(f);
+    }
+
+    inline f32x4 add_f32x4(f32x4 lhs, f32x4 rhs) noexcept
+    {
+        return _mm_add_ps(lhs, rhs);
+    }
+
+    inline f32x4 sub_f32x4(f32x4 lhs, f32x4 rhs) noexcept
+    {
+        return _mm_sub_ps(lhs, rhs);
+    }
+
+    inline f32x4 mul_f32x4(f32x4 lhs, f32x4 rhs) noexcept
+    {
+        return _mm_mul_ps(lhs, rhs);
+    }
+
+    inline float hsum_f32x4(f32x4 v) noexcept
+    {
+        __m128 shuf = _mm_shuffle_ps(v, v, _MM_SHUFFLE(2, 3, 0, 1));
+        __m128 sums = _mm_add_ps(v, shuf);
+        shuf = _mm_movehl_ps(shuf, sums);
+        sums = _mm_add_ss(sums, shuf);
+        return _mm_cvtss_f32(sums);
+    }
+
+#elif defined(ASBIND20_EXT_MATH_HAS_NEON)
+    using f32x4 = float32x4_t;
+
+    inline f32x4 load_f32x4(const float* p) noexcept
+    {
+        return vld1q_f32(p);
+    }
+
+    inline void store_f32x4(float* p, f32x4 v) noexcept
+    {
+        vst1q_f32(p, v);
+    }
+
+    inline f32x4 splat_f32x4(float f) noexcept
+    {
+        return vdupq_n_f32(f);
+    }
+
+    inline f32x4 add_f32x4(f32x4 lhs, f32x4 rhs) noexcept
+    {
+        return vaddq_f32(lhs, rhs);
+    }
+
+    inline f32x4 sub_f32x4(f32x4 lhs, f32x4 rhs) noexcept
+    {
+        return vsubq_f32(lhs, rhs);
+    }
+
+    inline f32x4 mul_f32x4(f32x4 lhs, f32x4 rhs) noexcept
+    {
+        return vmulq_f32(lhs, rhs);
+    }
+
+    inline float hsum_f32x4(f32x4 v) noexcept
+    {
+        float32x2_t sums = vadd_f32(vget_low_f32(v), vget_high_f32(v));
+        return vget_lane_f32(vpadd_f32(sums, sums), 0);
+    }
+
+#else
+    // Fallback for platforms without SIMD. Compilers can still vectorize these loops.
+    struct f32x4
+    {
+        float v[4];
+    };
+
+    inline f32x4 load_f32x4(const float* p) noexcept
+    {
+        f32x4 result;
+        std::memcpy(result.v, p, sizeof(result.v));
+        return result;
+    }
+
+    inline void store_f32x4(float* p, f32x4 v) noexcept
+    {
+        std::memcpy(p, v.v, sizeof(v.v));
+    }
+
+    inline f32x4 splat_f32x4(float f) noexcept
+    {
+        return f32x4{{f, f, f, f}};
+    }
+
+    inline f32x4 add_f32x4(f32x4 lhs, f32x4 rhs) noexcept
+    {
+        for(int i = 0; i < 4; ++i)
+            lhs.v[i] += rhs.v[i];
+        return lhs;
+    }
+
+    inline f32x4 sub_f32x4(f32x4 lhs, f32x4 rhs) noexcept
+    {
+        for(int i = 0; i < 4; ++i)
+            lhs.v[i] -= rhs.v[i];
+        return lhs;
+    }
+
+    inline f32x4 mul_f32x4(f32x4 lhs, f32x4 rhs) noexcept
+    {
+        for(int i = 0; i < 4; ++i)
+            lhs.v[i] *= rhs.v[i];
+        return lhs;
+    }
+
+    inline float hsum_f32x4(f32x4 v) noexcept
+    {
+        return (v.v[0] + v.v[1]) + (v.v[2] + v.v[3]);
+    }
+
+#endif
+
+    /**
+     * @brief Linear combination of the 4 columns of a column-major matrix, i.e., `m * (x, y, z, w)`
+     */
+    inline f32x4 combine_columns(
+        const f32x4 (&cols)[4], float x, float y, float z, float w
+    ) noexcept
+    {
+        f32x4 result = mul_f32x4(cols[0], splat_f32x4(x));
+        result = add_f32x4(result, mul_f32x4(cols[1], splat_f32x4(y)));
+        result = add_f32x4(result, mul_f32x4(cols[2], splat_f32x4(z)));
+        result = add_f32x4(result, mul_f32x4(cols[3], splat_f32x4(w)));
+        return result;
+    }
+
+    inline void load_columns(f32x4 (&cols)[4], const float* m) noexcept
+    {
+        for(int i = 0; i < 4; ++i)
+            cols[i] = load_f32x4(m + i * 4);
+    }
+
+    /**
+     * @brief Transform packed `(x, y, z)` triples by a column-major matrix with the given `w`
+     *
+     * The w component of results is discarded. Input and output may be the same buffer.
+     */
+    inline void transform_xyz(
+        const float* m, const float* in, float* out, std::size_t count, float w
+    ) noexcept
+    {
+        f32x4 cols[4];
+        load_columns(cols, m);
+
+        for(std::size_t i = 0; i < count; ++i)
+        {
+            const float* p = in + i * 3;
+            float result[4];
+            store_f32x4(result, combine_columns(cols, p[0], p[1], p[2], w));
+            // Storing 4 floats directly will overwrite the next triple
+            std::memcpy(out + i * 3, result, sizeof(float) * 3);
+        }
+    }
+
+    /**
+     * @brief Transform packed `(x, y, z, w)` vectors by a column-major matrix
+     *
+     * Input and output may be the same buffer.
+     */
+    inline void transform_xyzw(
+        const float* m, const float* in, float* out, std::size_t count
+    ) noexcept
+    {
+        f32x4 cols[4];
+        load_columns(cols, m);
+
+        for(std::size_t i = 0; i < count; ++i)
+        {
+            const float* p = in + i * 4;
+            store_f32x4(out + i * 4, combine_columns(cols, p[0], p[1], p[2], p[3]));
+        }
+    }
+} // namespace detail
+
+/**
+ * @brief 2D vector
+ */
+struct vec2
+{
+    float x = 0.0f;
+    float y = 0.0f;
+
+    constexpr vec2() noexcept = default;
+
+    constexpr explicit vec2(float scalar) noexcept
+        : x(scalar), y(scalar) {}
+
+    constexpr vec2(float x_, float y_) noexcept
+        : x(x_), y(y_) {}
+
+    float* data() noexcept
+    {
+        return &x;
+    }
+
+    const float* data() const noexcept
+    {
+        return &x;
+    }
+
+    constexpr float dot(const vec2& rhs) const noexcept
+    {
+        return x * rhs.x + y * rhs.y;
+    }
+
+    constexpr float length_sq() const noexcept
+    {
+        return dot(*this);
+    }
+
+    float length() const noexcept
+    {
+        return std::sqrt(length_sq());
+    }
+
+    /**
+     * @brief Get the normalized vector. Zero vector is returned unchanged.
+     */
+    vec2 normalized() const noexcept
+    {
+        float len = length();
+        return len == 0.0f ? *this : *this / len;
+    }
+
+    constexpr vec2 operator-() const noexcept
+    {
+        return vec2(-x, -y);
+    }
+
+    friend constexpr vec2 operator+(const vec2& lhs, const vec2& rhs) noexcept
+    {
+        return vec2(lhs.x + rhs.x, lhs.y + rhs.y);
+    }
+
+    friend constexpr vec2 operator-(const vec2& lhs, const vec2& rhs) noexcept
+    {
+        return vec2(lhs.x - rhs.x, lhs.y - rhs.y);
+    }
+
+    // Component-wise product
+    friend constexpr vec2 operator*(const vec2& lhs, const vec2& rhs) noexcept
+    {
+        return vec2(lhs.x * rhs.x, lhs.y * rhs.y);
+    }
+
+    friend constexpr vec2 operator*(const vec2& lhs, float rhs) noexcept
+    {
+        return vec2(lhs.x * rhs, lhs.y * rhs);
+    }
+
+    friend constexpr vec2 operator*(float lhs, const vec2& rhs) noexcept
+    {
+        return rhs * lhs;
+    }
+
+    friend constexpr vec2 operator/(const vec2& lhs, float rhs) noexcept
+    {
+        return vec2(lhs.x / rhs, lhs.y / rhs);
+    }
+
+    constexpr vec2& operator+=(const vec2& rhs) noexcept
+    {
+        return *this = *this + rhs;
+    }
+
+    constexpr vec2& operator-=(const vec2& rhs) noexcept
+    {
+        return *this = *this - rhs;
+    }
+
+    constexpr vec2& operator*=(float rhs) noexcept
+    {
+        return *this = *this * rhs;
+    }
+
+    constexpr vec2& operator/=(float rhs) noexcept
+    {
+        return *this = *this / rhs;
+    }
+
+    constexpr bool operator==(const vec2&) const = default;
+};
+
+/**
+ * @brief 3D vector
+ */
+struct vec3
+{
+    float x = 0.0f;
+    float y = 0.0f;
+    float z = 0.0f;
+
+    constexpr vec3() noexcept = default;
+
+    constexpr explicit vec3(float scalar) noexcept
+        : x(scalar), y(scalar), z(scalar) {}
+
+    constexpr vec3(float x_, float y_, float z_) noexcept
+        : x(x_), y(y_), z(z_) {}
+
+    float* data() noexcept
+    {
+        return &x;
+    }
+
+    const float* data() const noexcept
+    {
+        return &x;
+    }
+
+    constexpr float dot(const vec3& rhs) const noexcept
+    {
+        return x * rhs.x + y * rhs.y + z * rhs.z;
+    }
+
+    constexpr vec3 cross(const vec3& rhs) const noexcept
+    {
+        return vec3(
+            y * rhs.z - z * rhs.y,
+            z * rhs.x - x * rhs.z,
+            x * rhs.y - y * rhs.x
+        );
+    }
+
+    constexpr float length_sq() const noexcept
+    {
+        return dot(*this);
+    }
+
+    float length() const noexcept
+    {
+        return std::sqrt(length_sq());
+    }
+
+    /**
+     * @brief Get the normalized vector. Zero vector is returned unchanged.
+     */
+    vec3 normalized() const noexcept
+    {
+        float len = length();
+        return len == 0.0f ? *this : *this / len;
+    }
+
+    constexpr vec3 operator-() const noexcept
+    {
+        return vec3(-x, -y, -z);
+    }
+
+    friend constexpr vec3 operator+(const vec3& lhs, const vec3& rhs) noexcept
+    {
+        return vec3(lhs.x + rhs.x, lhs.y + rhs.y, lhs.z + rhs.z);
+    }
+
+    friend constexpr vec3 operator-(const vec3& lhs, const vec3& rhs) noexcept
+    {
+        return vec3(lhs.x - rhs.x, lhs.y - rhs.y, lhs.z - rhs.z);
+    }
+
+    // Component-wise product
+    friend constexpr vec3 operator*(const vec3& lhs, const vec3& rhs) noexcept
+    {
+        return vec3(lhs.x * rhs.x, lhs.y * rhs.y, lhs.z * rhs.z);
+    }
+
+    friend constexpr vec3 operator*(const vec3& lhs, float rhs) noexcept
+    {
+        return vec3(lhs.x * rhs, lhs.y * rhs, lhs.z * rhs);
+    }
+
+    friend constexpr vec3 operator*(float lhs, const vec3& rhs) noexcept
+    {
+        return rhs * lhs;
+    }
+
+    friend constexpr vec3 operator/(const vec3& lhs, float rhs) noexcept
+    {
+        return vec3(lhs.x / rhs, lhs.y / rhs, lhs.z / rhs);
+    }
+
+    constexpr vec3& operator+=(const vec3& rhs) noexcept
+    {
+        return *this = *this + rhs;
+    }
+
+    constexpr vec3& operator-=(const vec3& rhs) noexcept
+    {
+        return *this = *this - rhs;
+    }
+
+    constexpr vec3& operator*=(float rhs) noexcept
+    {
+        return *this = *this * rhs;
+    }
+
+    constexpr vec3& operator/=(float rhs) noexcept
+    {
+        return *this = *this / rhs;
+    }
+
+    constexpr bool operator==(const vec3&) const = default;
+};
+
+/**
+ * @brief 4D vector
+ *
+ * Arithmetic operators are implemented by SIMD kernels if available.
+ */
+struct vec4
+{
+    float x = 0.0f;
+    float y = 0.0f;
+    float z = 0.0f;
+    float w = 0.0f;
+
+    constexpr vec4() noexcept = default;
+
+    constexpr explicit vec4(float scalar) noexcept
+        : x(scalar), y(scalar), z(scalar), w(scalar) {}
+
+    constexpr vec4(float x_, float y_, float z_, float w_) noexcept
+        : x(x_), y(y_), z(z_), w(w_) {}
+
+    constexpr vec4(const vec3& xyz, float w_) noexcept
+        : x(xyz.x), y(xyz.y), z(xyz.z), w(w_) {}
+
+    float* data() noexcept
+    {
+        return &x;
+    }
+
+    const float* data() const noexcept
+    {
+        return &x;
+    }
+
+    constexpr vec3 xyz() const noexcept
+    {
+        return vec3(x, y, z);
+    }
+
+    float dot(const vec4& rhs) const noexcept
+    {
+        using namespace detail;
+        return hsum_f32x4(mul_f32x4(load_f32x4(data()), load_f32x4(rhs.data())));
+    }
+
+    float length_sq() const noexcept
+    {
+        return dot(*this);
+    }
+
+    float length() const noexcept
+    {
+        return std::sqrt(length_sq());
+    }
+
+    /**
+     * @brief Get the normalized vector. Zero vector is returned unchanged.
+     */
+    vec4 normalized() const noexcept
+    {
+        float len = length();
+        return len == 0.0f ? *this : *this / len;
+    }
+
+    vec4 operator-() const noexcept
+    {
+        return vec4() - *this;
+    }
+
+    friend vec4 operator+(const vec4& lhs, const vec4& rhs) noexcept
+    {
+        return apply(lhs, rhs, &detail::add_f32x4);
+    }
+
+    friend vec4 operator-(const vec4& lhs, const vec4& rhs) noexcept
+    {
+        return apply(lhs, rhs, &detail::sub_f32x4);
+    }
+
+    // Component-wise product
+    friend vec4 operator*(const vec4& lhs, const vec4& rhs) noexcept
+    {
+        return apply(lhs, rhs, &detail::mul_f32x4);
+    }
+
+    friend vec4 operator*(const vec4& lhs, float rhs) noexcept
+    {
+        return lhs * vec4(rhs);
+    }
+
+    friend vec4 operator*(float lhs, const vec4& rhs) noexcept
+    {
+        return vec4(lhs) * rhs;
+    }
+
+    friend constexpr vec4 operator/(const vec4& lhs, float rhs) noexcept
+    {
+        return vec4(lhs.x / rhs, lhs.y / rhs, lhs.z / rhs, lhs.w / rhs);
+    }
+
+    vec4& operator+=(const vec4& rhs) noexcept
+    {
+        return *this = *this + rhs;
+    }
+
+    vec4& operator-=(const vec4& rhs) noexcept
+    {
+        return *this = *this - rhs;
+    }
+
+    vec4& operator*=(float rhs) noexcept
+    {
+        return *this = *this * rhs;
+    }
+
+    constexpr vec4& operator/=(float rhs) noexcept
+    {
+        return *this = *this / rhs;
+    }
+
+    constexpr bool operator==(const vec4&) const = default;
+
+private:
+    static vec4 apply(const vec4& lhs, const vec4& rhs, detail::f32x4 (*op)(detail::f32x4, detail::f32x4)) noexcept
+    {
+        using namespace detail;
+        vec4 result;
+        store_f32x4(result.data(), op(load_f32x4(lhs.data()), load_f32x4(rhs.data())));
+        return result;
+    }
+};
+
+/**
+ * @brief Quaternion for rotations
+ *
+ * Default constructed quaternion is the identity, i.e., `(0, 0, 0, 1)`.
+ */
+struct quat
+{
+    float x = 0.0f;
+    float y = 0.0f;
+    float z = 0.0f;
+    float w = 1.0f;
+
+    constexpr quat() noexcept = default;
+
+    constexpr quat(float x_, float y_, float z_, float w_) noexcept
+        : x(x_), y(y_), z(z_), w(w_) {}
+
+    /**
+     * @brief Create a quaternion rotating around the axis
+     *
+     * @param axis Rotation axis, which will be normalized
+     * @param angle Angle in radians
+     */
+    static quat from_axis_angle(const vec3& axis, float angle) noexcept
+    {
+        vec3 v = axis.normalized() * std::sin(angle * 0.5f);
+        return quat(v.x, v.y, v.z, std::cos(angle * 0.5f));
+    }
+
+    float* data() noexcept
+    {
+        return &x;
+    }
+
+    const float* data() const noexcept
+    {
+        return &x;
+    }
+
+    float dot(const quat& rhs) const noexcept
+    {
+        using namespace detail;
+        return hsum_f32x4(mul_f32x4(load_f32x4(data()), load_f32x4(rhs.data())));
+    }
+
+    float length() const noexcept
+    {
+        return std::sqrt(dot(*this));
+    }
+
+    /**
+     * @brief Get the normalized quaternion. Zero quaternion is returned unchanged.
+     */
+    quat normalized() const noexcept
+    {
+        float len = length();
+        if(len == 0.0f)
+            return *this;
+        return quat(x / len, y / len, z / len, w / len);
+    }
+
+    constexpr quat conjugate() const noexcept
+    {
+        return quat(-x, -y, -z, w);
+    }
+
+    /**
+     * @brief Rotate a vector. The quaternion should be normalized.
+     */
+    constexpr vec3 rotate(const vec3& v) const noexcept
+    {
+        vec3 u(x, y, z);
+        vec3 t = 2.0f * u.cross(v);
+        return v + w * t + u.cross(t);
+    }
+
+    // Hamilton product, i.e., applying the rotation of `rhs` first
+    friend constexpr quat operator*(const quat& lhs, const quat& rhs) noexcept
+    {
+        return quat(
+            lhs.w * rhs.x + lhs.x * rhs.w + lhs.y * rhs.z - lhs.z * rhs.y,
+            lhs.w * rhs.y - lhs.x * rhs.z + lhs.y * rhs.w + lhs.z * rhs.x,
+            lhs.w * rhs.z + lhs.x * rhs.y - lhs.y * rhs.x + lhs.z * rhs.w,
+            lhs.w * rhs.w - lhs.x * rhs.x - lhs.y * rhs.y - lhs.z * rhs.z
+        );
+    }
+
+    friend constexpr vec3 operator*(const quat& lhs, const vec3& rhs) noexcept
+    {
+        return lhs.rotate(rhs);
+    }
+
+    constexpr bool operator==(const quat&) const = default;
+};
+
+/**
+ * @brief 4x4 matrix of column-major order
+ *
+ * Default constructed matrix is the identity.
+ * Multiplications are implemented by SIMD kernels if available.
+ */
+struct mat4
+{
+    float m[16] = {
+        1.0f, 0.0f, 0.0f, 0.0f,
+        0.0f, 1.0f, 0.0f, 0.0f,
+        0.0f, 0.0f, 1.0f, 0.0f,
+        0.0f, 0.0f, 0.0f, 1.0f
+    };
+
+    constexpr mat4() noexcept = default;
+
+    // Elements are listed column by column
+    constexpr mat4(
+        float m0, float m1, float m2, float m3,
+        float m4, float m5, float m6, float m7,
+        float m8, float m9, float m10, float m11,
+        float m12, float m13, float m14, float m15
+    ) noexcept
+        : m{m0, m1, m2, m3, m4, m5, m6, m7, m8, m9, m10, m11, m12, m13, m14, m15} {}
+
+    static constexpr mat4 translation(const vec3& v) noexcept
+    {
+        mat4 result;
+        result.m[12] = v.x;
+        result.m[13] = v.y;
+        result.m[14] = v.z;
+        return result;
+    }
+
+    static constexpr mat4 scale(const vec3& v) noexcept
+    {
+        mat4 result;
+        result.m[0] = v.x;
+        result.m[5] = v.y;
+        result.m[10] = v.z;
+        return result;
+    }
+
+    /**
+     * @brief Create a rotation matrix from a normalized quaternion
+     */
+    static constexpr mat4 rotation(const quat& q) noexcept
+    {
+        float xx = q.x * q.x, yy = q.y * q.y, zz = q.z * q.z;
+        float xy = q.x * q.y, xz = q.x * q.z, yz = q.y * q.z;
+        float wx = q.w * q.x, wy = q.w * q.y, wz = q.w * q.z;
+
+        return mat4(
+            1.0f - 2.0f * (yy + zz), 2.0f * (xy + wz), 2.0f * (xz - wy), 0.0f,
+            2.0f * (xy - wz), 1.0f - 2.0f * (xx + zz), 2.0f * (yz + wx), 0.0f,
+            2.0f * (xz + wy), 2.0f * (yz - wx), 1.0f - 2.0f * (xx + yy), 0.0f,
+            0.0f, 0.0f, 0.0f, 1.0f
+        );
+    }
+
+    float* data() noexcept
+    {
+        return m;
+    }
+
+    const float* data() const noexcept
+    {
+        return m;
+    }
+
+    constexpr mat4 transposed() const noexcept
+    {
+        mat4 result;
+        for(int c = 0; c < 4; ++c)
+        {
+            for(int r = 0; r < 4; ++r)
+                result.m[r * 4 + c] = m[c * 4 + r];
+        }
+        return result;
+    }
+
+    vec3 transform_point(const vec3& p) const noexcept
+    {
+        vec3 result;
+        detail::transform_xyz(m, p.data(), result.data(), 1, 1.0f);
+        return result;
+    }
+
+    vec3 transform_direction(const vec3& d) const noexcept
+    {
+        vec3 result;
+        detail::transform_xyz(m, d.data(), result.data(), 1, 0.0f);
+        return result;
+    }
+
+    friend vec4 operator*(const mat4& lhs, const vec4& rhs) noexcept
+    {
+        vec4 result;
+        detail::transform_xyzw(lhs.m, rhs.data(), result.data(), 1);
+        return result;
+    }
+
+    friend mat4 operator*(const mat4& lhs, const mat4& rhs) noexcept
+    {
+        // Each column of the result is the left matrix multiplied by the column of the right one
+        mat4 result;
+        detail::transform_xyzw(lhs.m, rhs.m, result.m, 4);
+        return result;
+    }
+
+    mat4& operator*=(const mat4& rhs) noexcept
+    {
+        return *this = *this * rhs;
+    }
+
+    constexpr bool operator==(const mat4&) const = default;
+};
+
+static_assert(std::is_standard_layout_v<vec3> && sizeof(vec3) == sizeof(float) * 3);
+static_assert(std::is_standard_layout_v<vec4> && sizeof(vec4) == sizeof(float) * 4);
+static_assert(std::is_standard_layout_v<mat4> && sizeof(mat4) == sizeof(float) * 16);
+
+/**
+ * @brief Transform points by a matrix, i.e., `(m * vec4(p, 1)).xyz`
+ *
+ * @note No perspective division is performed.
+ *
+ * @param in Input points
+ * @param out Output points, which may be the same as the input. Its size should be no less than the input.
+ */
+inline void transform_points(const mat4& m, std::span<const vec3> in, std::span<vec3> out) noexcept
+{
+    ASBIND20_ASSERT(out.size() >= in.size());
+    detail::transform_xyz(
+        m.data(),
+        reinterpret_cast<const float*>(in.data()),
+        reinterpret_cast<float*>(out.data()),
+        in.size(),
+        1.0f
+    );
+}
+
+/**
+ * @brief Transform points in place
+ */
+inline void transform_points(const mat4& m, std::span<vec3> points) noexcept
+{
+    transform_points(m, points, points);
+}
+
+/**
+ * @brief Transform directions by a matrix, i.e., `(m * vec4(d, 0)).xyz`
+ *
+ * @param in Input directions
+ * @param out Output directions, which may be the same as the input. Its size should be no less than the input.
+ */
+inline void transform_directions(const mat4& m, std::span<const vec3> in, std::span<vec3> out) noexcept
+{
+    ASBIND20_ASSERT(out.size() >= in.size());
+    detail::transform_xyz(
+        m.data(),
+        reinterpret_cast<const float*>(in.data()),
+        reinterpret_cast<float*>(out.data()),
+        in.size(),
+        0.0f
+    );
+}
+
+/**
+ * @brief Transform directions in place
+ */
+inline void transform_directions(const mat4& m, std::span<vec3> directions) noexcept
+{
+    transform_directions(m, directions, directions);
+}
+
+/**
+ * @brief Transform 4D vectors by a matrix
+ *
+ * @param in Input vectors
+ * @param out Output vectors, which may be the same as the input. Its size should be no less than the input.
+ */
+inline void transform(const mat4& m, std::span<const vec4> in, std::span<vec4> out) noexcept
+{
+    ASBIND20_ASSERT(out.size() >= in.size());
+    detail::transform_xyzw(
+        m.data(),
+        reinterpret_cast<const float*>(in.data()),
+        reinterpret_cast<float*>(out.data()),
+        in.size()
+    );
+}
+
+/**
+ * @brief Transform 4D vectors in place
+ */
+inline void transform(const mat4& m, std::span<vec4> vectors) noexcept
+{
+    transform(m, vectors, vectors);
+}
+
+/**
+ * @brief Flags of registered math types
+ */
+inline constexpr AS_NAMESPACE_QUALIFIER asQWORD math_type_flags =
+    AS_NAMESPACE_QUALIFIER asOBJ_POD |
+    AS_NAMESPACE_QUALIFIER asOBJ_APP_CLASS_ALLFLOATS |
+    AS_NAMESPACE_QUALIFIER asOBJ_APP_CLASS_MORE_CONSTRUCTORS;
+
+/**
+ * @brief Array of floats whose elements are stored contiguously,
+ *        e.g., `array<float>` of the official add-on (`GetBuffer`/`GetSize`) or any type providing `data`/`size`.
+ */
+template <typename Array>
+concept float_buffer_array =
+    requires(Array& arr) {
+        arr.data();
+        { arr.size() } -> std::convertible_to<std::size_t>;
+    } ||
+    requires(Array& arr) {
+        arr.GetBuffer();
+        { arr.GetSize() } -> std::convertible_to<std::size_t>;
+    };
+
+namespace detail
+{
+    template <typename Vec>
+    using math_index_result_t = std::conditional_t<std::is_const_v<Vec>, const float&, float&>;
+
+    template <typename Vec, std::size_t Size>
+    math_index_result_t<Vec> math_index(Vec& v, AS_NAMESPACE_QUALIFIER asUINT idx)
+    {
+        if(idx >= Size) [[unlikely]]
+        {
+            set_script_exception("math: index out of range");
+            return v.data()[0];
+        }
+        return v.data()[idx];
+    }
+
+    template <float_buffer_array Array>
+    std::span<float> float_buffer_of(Array& arr)
+    {
+        if constexpr(requires() { arr.data(); arr.size(); })
+            return {static_cast<float*>(arr.data()), static_cast<std::size_t>(arr.size())};
+        else
+            return {static_cast<float*>(arr.GetBuffer()), static_cast<std::size_t>(arr.GetSize())};
+    }
+
+    template <float_buffer_array Array, std::size_t Stride>
+    std::span<float> packed_float_buffer(Array& arr, const char* func_name)
+    {
+        std::span<float> buf = float_buffer_of(arr);
+        if(buf.size() % Stride != 0) [[unlikely]]
+        {
+            set_script_exception(string_concat(
+                func_name, "(): size of array is not a multiple of ", Stride == 3 ? "3" : "4"
+            ));
+            return {};
+        }
+        return buf;
+    }
+
+    template <float_buffer_array Array>
+    void script_transform_points(const mat4& m, Array& xyz)
+    {
+        std::span<float> buf = packed_float_buffer<Array, 3>(xyz, "transform_points");
+        transform_xyz(m.data(), buf.data(), buf.data(), buf.size() / 3, 1.0f);
+    }
+
+    template <float_buffer_array Array>
+    void script_transform_directions(const mat4& m, Array& xyz)
+    {
+        std::span<float> buf = packed_float_buffer<Array, 3>(xyz, "transform_directions");
+        transform_xyz(m.data(), buf.data(), buf.data(), buf.size() / 3, 0.0f);
+    }
+
+    template <float_buffer_array Array>
+    void script_transform(const mat4& m, Array& xyzw)
+    {
+        std::span<float> buf = packed_float_buffer<Array, 4>(xyzw, "transform");
+        transform_xyzw(m.data(), buf.data(), buf.data(), buf.size() / 4);
+    }
+
+    template <typename Vec, bool UseGeneric>
+    auto register_math_vector(AS_NAMESPACE_QUALIFIER asIScriptEngine* engine, const char* name)
+    {
+        using namespace asbind20;
+
+        value_class<Vec, UseGeneric> c(engine, name, math_type_flags);
+        c
+            .behaviours_by_traits(math_type_flags | AS_NAMESPACE_QUALIFIER asGetTypeTraits<Vec>())
+            .template constructor<float>("float")
+            .opEquals()
+            .opAdd()
+            .opSub()
+            .opNeg()
+            .opMul()
+            .use(const_this * param<float>)
+            .use(param<float> * const_this)
+            .use(const_this / param<float>)
+            .opAddAssign()
+            .opSubAssign()
+            .use(_this *= param<float>)
+            .use(_this /= param<float>)
+            .method(string_concat("float dot(const ", name, "&in) const"), fp<&Vec::dot>)
+            .method("float length() const", fp<&Vec::length>)
+            .method("float length_sq() const", fp<&Vec::length_sq>)
+            .method(string_concat(name, " normalized() const"), fp<&Vec::normalized>)
+            .method("float& opIndex(uint)", fp<&math_index<Vec, sizeof(Vec) / sizeof(float)>>)
+            .method("const float& opIndex(uint) const", fp<&math_index<const Vec, sizeof(Vec) / sizeof(float)>>)
+            .property("float x", &Vec::x)
+            .property("float y", &Vec::y);
+
+        return c;
+    }
+} // namespace detail
+
+/**
+ * @brief Register `vec2`, `vec3`, `vec4`, `quat`, and `mat4` into the engine
+ *
+ * @tparam UseGeneric Use generic calling convention, e.g., for platforms with `AS_MAX_PORTABILITY`
+ */
+template <bool UseGeneric = false>
+void register_math(AS_NAMESPACE_QUALIFIER asIScriptEngine* engine)
+{
+    using namespace asbind20;
+
+    detail::register_math_vector<vec2, UseGeneric>(engine, "vec2")
+        .template constructor<float, float>("float,float")
+        .template list_constructor<float>(use_policy<policies::apply_to<2>>);
+
+    detail::register_math_vector<vec3, UseGeneric>(engine, "vec3")
+        .template constructor<float, float, float>("float,float,float")
+        .template list_constructor<float>(use_policy<policies::apply_to<3>>)
+        .method("vec3 cross(const vec3&in) const", fp<&vec3::cross>)
+        .property("float z", &vec3::z);
+
+    detail::register_math_vector<vec4, UseGeneric>(engine, "vec4")
+        .template constructor<float, float, float, float>("float,float,float,float")
+        .template constructor<const vec3&, float>("const vec3&in,float")
+        .template list_constructor<float>(use_policy<policies::apply_to<4>>)
+        .method("vec3 xyz() const", fp<&vec4::xyz>)
+        .property("float z", &vec4::z)
+        .property("float w", &vec4::w);
+
+    value_class<quat, UseGeneric>(engine, "quat", math_type_flags)
+        .behaviours_by_traits(math_type_flags | AS_NAMESPACE_QUALIFIER asGetTypeTraits<quat>())
+        .template constructor<float, float, float, float>("float,float,float,float")
+        .template list_constructor<float>(use_policy<policies::apply_to<4>>)
+        .opEquals()
+        .opMul()
+        .use((const_this * param<const vec3&>("const vec3&in"))->template return_<vec3>("vec3"))
+        .method("float dot(const quat&in) const", fp<&quat::dot>)
+        .method("float length() const", fp<&quat::length>)
+        .method("quat normalized() const", fp<&quat::normalized>)
+        .method("quat conjugate() const", fp<&quat::conjugate>)
+        .method("vec3 rotate(const vec3&in) const", fp<&quat::rotate>)
+        .property("float x", &quat::x)
+        .property("float y", &quat::y)
+        .property("float z", &quat::z)
+        .property("float w", &quat::w);
+
+    value_class<mat4, UseGeneric>(engine, "mat4", math_type_flags)
+        .behaviours_by_traits(math_type_flags | AS_NAMESPACE_QUALIFIER asGetTypeTraits<mat4>())
+        .template list_constructor<float>(use_policy<policies::apply_to<16>>)
+        .opEquals()
+        .opMul()
+        .opMulAssign()
+        .use((const_this * param<const vec4&>("const vec4&in"))->template return_<vec4>("vec4"))
+        .method("mat4 transposed() const", fp<&mat4::transposed>)
+        .method("vec3 transform_point(const vec3&in) const", fp<&mat4::transform_point>)
+        .method("vec3 transform_direction(const vec3&in) const", fp<&mat4::transform_direction>)
+        .method("float& opIndex(uint)", fp<&detail::math_index<mat4, 16>>)
+        .method("const float& opIndex(uint) const", fp<&detail::math_index<const mat4, 16>>);
+
+    global<UseGeneric>(engine)
+        .function("quat quat_from_axis_angle(const vec3&in axis, float angle)", fp<&quat::from_axis_angle>)
+        .function("mat4 mat4_translation(const vec3&in)", fp<&mat4::translation>)
+        .function("mat4 mat4_scale(const vec3&in)", fp<&mat4::scale>)
+        .function("mat4 mat4_rotation(const quat&in)", fp<&mat4::rotation>);
+}
+
+/**
+ * @brief Register math types using generic calling convention if `generic` is true
+ */
+inline void register_math(AS_NAMESPACE_QUALIFIER asIScriptEngine* engine, bool generic)
+{
+    if(generic)
+        register_math<true>(engine);
+    else
+        register_math<false>(engine);
+}
+
+/**
+ * @brief Register functions for transforming packed arrays of floats in one call
+ *
+ * The following functions will be registered, where `array<float>` is replaced by `float_array_decl`:
+ * - `void transform_points(const mat4&in m, array<float>& xyz)`
+ * - `void transform_directions(const mat4&in m, array<float>& xyz)`
+ * - `void transform(const mat4&in m, array<float>& xyzw)`
+ *
+ * Arrays of floats are used because script arrays of value types store pointers to elements,
+ * which cannot be processed by SIMD kernels directly.
+ *
+ * @note Math types must be registered before calling this function.
+ *
+ * @tparam Array Registered array type, whose elements must be stored contiguously
+ * @tparam UseGeneric Use generic calling convention
+ * @param float_array_decl Declaration of the array of floats
+ */
+template <float_buffer_array Array, bool UseGeneric = false>
+void register_math_batch(
+    AS_NAMESPACE_QUALIFIER asIScriptEngine* engine,
+    std::string_view float_array_decl = "array<float>"
+)
+{
+    using namespace asbind20;
+
+    global<UseGeneric>(engine)
+        .function(
+            string_concat("void transform_points(const mat4&in m, ", float_array_decl, "& xyz)"),
+            fp<&detail::script_transform_points<Array>>
+        )
+        .function(
+            string_concat("void transform_directions(const mat4&in m, ", float_array_decl, "& xyz)"),
+            fp<&detail::script_transform_directions<Array>>
+        )
+        .function(
+            string_concat("void transform(const mat4&in m, ", float_array_decl, "& xyzw)"),
+            fp<&detail::script_transform<Array>>
+        );
+}
+} // namespace asbind20::ext
+
+#endif
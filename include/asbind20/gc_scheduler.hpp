@@ -0,0 +1,399 @@
+/**
+ * @file gc_scheduler.hpp
+ * @author HenryAWE
+ * @brief Incremental garbage collection with a per-frame time budget
+ */
+
+#ifndef ASBIND20_GC_SCHEDULER_HPP
+#define ASBIND20_GC_SCHEDULER_HPP
+
+#pragma once
+
+#include <cstddef>
+#include <cstdint>
+#include <cstring>
+#include <algorithm>
+#include <chrono>
+#include <condition_variable>
+#include <mutex>
+#include <thread>
+#include "detail/config.hpp"
+#include "detail/include_as.hpp"
+#include "debugging/gc_statistics.hpp"
+#include "debugging/gc_monitor.hpp"
+
+namespace asbind20
+{
+/**
+ * @brief Options of the GC scheduler
+ */
+struct gc_scheduler_options
+{
+    /// Time budget of GC in every frame
+    std::chrono::microseconds frame_budget{1000};
+
+    /// Escalate to a full cycle if the count of objects added to the GC since the last full cycle reaches this value.
+    /// Zero disables this condition.
+    AS_NAMESPACE_QUALIFIER asUINT new_objects_threshold = 10000;
+
+    /// Escalate to a full cycle if the count of objects in the GC grows by this factor since the last full cycle.
+    /// Values not greater than 1 disable this condition.
+    double growth_factor = 2.0;
+
+    /// Growth below this count of objects never causes escalation
+    AS_NAMESPACE_QUALIFIER asUINT min_escalation_size = 1000;
+
+    /// Disable the automatic GC of engine during the lifetime of scheduler
+    bool disable_auto_collect = true;
+
+    /// Detect garbage in a background thread.
+    /// Only the destruction of garbage is performed by `run_frame()`.
+    /// This option is ignored if the library is built with `AS_NO_THREADS`.
+    bool background_detection = false;
+
+    /// Interval of background detection
+    std::chrono::milliseconds background_interval{16};
+};
+
+/**
+ * @brief Result of a scheduled GC frame
+ */
+struct gc_frame_result
+{
+    /// Count of incremental steps performed
+    std::size_t steps = 0;
+    /// True if the frame escalated to a full cycle
+    bool full_cycle = false;
+    /// True if the full cycle didn't run because the GC was being run by another thread.
+    /// The escalation will be retried in the next frame.
+    bool deferred = false;
+    /// Count of objects destroyed in this frame
+    std::size_t destroyed = 0;
+    /// Time spent in this frame
+    std::chrono::nanoseconds elapsed{0};
+};
+
+/**
+ * @brief Scheduler of the garbage collector
+ *
+ * Call `run_frame()` once per frame. It performs incremental steps of the GC until the time budget runs out.
+ * The cost of a step is estimated by a moving average, so the scheduler stops before a step would exceed the budget.
+ * When the GC grows too fast for the incremental steps, the scheduler escalates to a full cycle for bounding memory.
+ *
+ * @note Except the background detection, this class is not thread-safe.
+ */
+class gc_scheduler
+{
+public:
+    using clock_type = std::chrono::steady_clock;
+
+    explicit gc_scheduler(
+        AS_NAMESPACE_QUALIFIER asIScriptEngine* engine,
+        const gc_scheduler_options& opts = gc_scheduler_options()
+    )
+        : m_engine(engine), m_opts(opts)
+    {
+        ASBIND20_ASSERT(engine != nullptr);
+
+        if(m_opts.disable_auto_collect)
+        {
+            m_prev_auto_collect = m_engine->GetEngineProperty(AS_NAMESPACE_QUALIFIER asEP_AUTO_GARBAGE_COLLECT);
+            m_engine->SetEngineProperty(AS_NAMESPACE_QUALIFIER asEP_AUTO_GARBAGE_COLLECT, false);
+        }
+
+        update_baseline();
+
+        // Same as has_threads() in asbind.hpp
+        const bool threads = std::strstr(AS_NAMESPACE_QUALIFIER asGetLibraryOptions(), "AS_NO_THREADS") == nullptr;
+        if(m_opts.background_detection && threads)
+            start_background();
+    }
+
+    gc_scheduler(const gc_scheduler&) = delete;
+
+    ~gc_scheduler()
+    {
+        stop_background();
+
+        if(m_opts.disable_auto_collect)
+            m_engine->SetEngineProperty(AS_NAMESPACE_QUALIFIER asEP_AUTO_GARBAGE_COLLECT, m_prev_auto_collect);
+    }
+
+    gc_scheduler& operator=(const gc_scheduler&) = delete;
+
+    /**
+     * @brief Run the GC with the budget in options
+     */
+    gc_frame_result run_frame()
+    {
+        return run_frame(m_opts.frame_budget);
+    }
+
+    /**
+     * @brief Run the GC with a custom budget
+     *
+     * @param budget Time budget of this frame
+     */
+    gc_frame_result run_frame(std::chrono::nanoseconds budget)
+    {
+        gc_frame_result result;
+        const auto start = clock_type::now();
+        const auto before = debugging::get_gc_statistics(m_engine);
+
+        begin_foreground();
+        if(should_escalate(before))
+        {
+            full_collect_impl(result);
+        }
+        else
+        {
+            const AS_NAMESPACE_QUALIFIER asDWORD flags =
+                AS_NAMESPACE_QUALIFIER asGC_ONE_STEP |
+                AS_NAMESPACE_QUALIFIER asGC_DESTROY_GARBAGE |
+                (background_running() ? 0 : AS_NAMESPACE_QUALIFIER asGC_DETECT_GARBAGE);
+
+            // At least one step is performed in every frame for guaranteeing progress
+            auto elapsed = clock_type::duration::zero();
+            while(result.steps == 0 || elapsed + estimated_step_cost() <= budget)
+            {
+                const auto step_start = clock_type::now();
+                int r = m_engine->GarbageCollect(flags);
+                const auto step_end = clock_type::now();
+
+                update_step_cost(step_end - step_start);
+                ++result.steps;
+                elapsed = step_end - start;
+
+                // 0 means the cycle is finished, and there is nothing more to do in this frame
+                if(r <= 0)
+                    break;
+            }
+        }
+        end_foreground();
+
+        const auto after = debugging::get_gc_statistics(m_engine);
+        result.destroyed = after.total_destroyed - before.total_destroyed;
+        result.elapsed = clock_type::now() - start;
+        m_frame_times.record(static_cast<std::uint64_t>(result.elapsed.count()));
+
+        return result;
+    }
+
+    /**
+     * @brief Run a full cycle regardless of the budget
+     */
+    gc_frame_result full_collect()
+    {
+        gc_frame_result result;
+        const auto start = clock_type::now();
+        const auto before = debugging::get_gc_statistics(m_engine);
+
+        begin_foreground();
+        full_collect_impl(result);
+        end_foreground();
+
+        const auto after = debugging::get_gc_statistics(m_engine);
+        result.destroyed = after.total_destroyed - before.total_destroyed;
+        result.elapsed = clock_type::now() - start;
+        m_frame_times.record(static_cast<std::uint64_t>(result.elapsed.count()));
+
+        return result;
+    }
+
+    /**
+     * @brief Check if the next frame will escalate to a full cycle
+     */
+    [[nodiscard]]
+    bool should_escalate() const
+    {
+        return should_escalate(debugging::get_gc_statistics(m_engine));
+    }
+
+    /**
+     * @brief Estimated cost of an incremental step
+     */
+    [[nodiscard]]
+    std::chrono::nanoseconds estimated_step_cost() const noexcept
+    {
+        return std::chrono::nanoseconds(static_cast<std::int64_t>(m_step_cost_ns));
+    }
+
+    /**
+     * @brief Histogram of time spent in frames in nanoseconds
+     */
+    [[nodiscard]]
+    const debugging::pause_histogram& frame_times() const noexcept
+    {
+        return m_frame_times;
+    }
+
+    [[nodiscard]]
+    bool background_running() const noexcept
+    {
+        return m_background.joinable();
+    }
+
+    [[nodiscard]]
+    const gc_scheduler_options& options() const noexcept
+    {
+        return m_opts;
+    }
+
+    [[nodiscard]]
+    AS_NAMESPACE_QUALIFIER asIScriptEngine* get_engine() const noexcept
+    {
+        return m_engine;
+    }
+
+private:
+    AS_NAMESPACE_QUALIFIER asIScriptEngine* m_engine;
+    gc_scheduler_options m_opts;
+    AS_NAMESPACE_QUALIFIER asPWORD m_prev_auto_collect = true;
+
+    AS_NAMESPACE_QUALIFIER asUINT m_baseline_size = 0;
+    AS_NAMESPACE_QUALIFIER asUINT m_baseline_new_objects = 0;
+    double m_step_cost_ns = 0;
+    debugging::pause_histogram m_frame_times;
+
+    std::thread m_background;
+    std::mutex m_background_mtx;
+    std::condition_variable m_background_cv;
+    bool m_stop_requested = false;
+    // The scheduler is running the GC in the calling thread
+    bool m_foreground = false;
+
+    bool should_escalate(const debugging::gc_statistics& stats) const noexcept
+    {
+        // The new_objects is a cumulative counter
+        if(m_opts.new_objects_threshold != 0 &&
+           stats.new_objects - m_baseline_new_objects >= m_opts.new_objects_threshold)
+            return true;
+
+        if(m_opts.growth_factor > 1.0 && stats.current_size >= m_opts.min_escalation_size)
+        {
+            const double limit =
+                static_cast<double>(std::max(m_baseline_size, m_opts.min_escalation_size)) * m_opts.growth_factor;
+            if(static_cast<double>(stats.current_size) >= limit)
+                return true;
+        }
+
+        return false;
+    }
+
+    void full_collect_impl(gc_frame_result& result)
+    {
+        result.full_cycle = true;
+
+        // 1 means the GC is being run by another thread, and nothing is done
+        int r = m_engine->GarbageCollect(AS_NAMESPACE_QUALIFIER asGC_FULL_CYCLE);
+        if(r != 0)
+        {
+            // Keep the baseline, so the escalation will be retried
+            result.deferred = true;
+            return;
+        }
+
+        result.steps = 1;
+        update_baseline();
+    }
+
+    // Park the background detection while running the GC in the calling thread,
+    // so the threads won't contend for the GC
+    void begin_foreground()
+    {
+        if(!background_running())
+            return;
+
+        std::lock_guard lock(m_background_mtx);
+        m_foreground = true;
+    }
+
+    void end_foreground()
+    {
+        if(!background_running())
+            return;
+
+        {
+            std::lock_guard lock(m_background_mtx);
+            m_foreground = false;
+        }
+        m_background_cv.notify_all();
+    }
+
+    void update_baseline()
+    {
+        const auto stats = debugging::get_gc_statistics(m_engine);
+        m_baseline_size = stats.current_size;
+        m_baseline_new_objects = stats.new_objects;
+    }
+
+    void update_step_cost(clock_type::duration dur) noexcept
+    {
+        const auto ns = static_cast<double>(
+            std::chrono::duration_cast<std::chrono::nanoseconds>(dur).count()
+        );
+        // Exponential moving average. The first measurement initializes the estimate.
+        if(m_step_cost_ns == 0)
+            m_step_cost_ns = ns;
+        else
+            m_step_cost_ns += (ns - m_step_cost_ns) / 8;
+    }
+
+    void start_background()
+    {
+        m_stop_requested = false;
+        m_background = std::thread(
+            [this]()
+            {
+                std::unique_lock lock(m_background_mtx);
+                while(!m_stop_requested)
+                {
+                    // Sleep while the GC is being run by the scheduler instead of spinning on it
+                    m_background_cv.wait(
+                        lock, [this]()
+                        { return m_stop_requested || !m_foreground; }
+                    );
+                    if(m_stop_requested)
+                        break;
+
+                    lock.unlock();
+                    // The GC returns 1 immediately if it is being run by another thread,
+                    // so it won't block the frames
+                    int r = m_engine->GarbageCollect(
+                        AS_NAMESPACE_QUALIFIER asGC_ONE_STEP |
+                        AS_NAMESPACE_QUALIFIER asGC_DETECT_GARBAGE
+                    );
+                    lock.lock();
+
+                    // Continue the detection, or wait for the scheduler to leave the GC
+                    if(r > 0)
+                        continue;
+
+                    m_background_cv.wait_for(
+                        lock, m_opts.background_interval, [this]()
+                        { return m_stop_requested; }
+                    );
+                }
+
+                lock.unlock();
+                AS_NAMESPACE_QUALIFIER asThreadCleanup();
+            }
+        );
+    }
+
+    void stop_background()
+    {
+        if(!m_background.joinable())
+            return;
+
+        {
+            std::lock_guard lock(m_background_mtx);
+            m_stop_requested = true;
+        }
+        m_background_cv.notify_all();
+        m_background.join();
+    }
+};
+} // namespace asbind20
+
+#endif
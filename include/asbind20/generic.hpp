@@ -123,7 +123,10 @@ T get_generic_arg(
     }
     else if constexpr(std::is_enum_v<T>)
     {
-        return static_cast<T>(get_generic_arg<int>(gen, idx));
+        if constexpr(sizeof(T) == sizeof(AS_NAMESPACE_QUALIFIER asQWORD))
+            return static_cast<T>(get_generic_arg<std::underlying_type_t<T>>(gen, idx));
+        else
+            return static_cast<T>(get_generic_arg<int>(gen, idx));
     }
     else if constexpr(std::integral<T>)
     {
@@ -200,7 +203,13 @@ void set_generic_return(
     }
     else if constexpr(std::is_enum_v<Return>)
     {
-        set_generic_return<int>(gen, static_cast<int>(ret));
+        if constexpr(sizeof(Return) == sizeof(AS_NAMESPACE_QUALIFIER asQWORD))
+        {
+            using underlying_t = std::underlying_type_t<Return>;
+            set_generic_return<underlying_t>(gen, static_cast<underlying_t>(ret));
+        }
+        else
+            set_generic_return<int>(gen, static_cast<int>(ret));
     }
     else if constexpr(std::integral<Return>)
     {
@@ -0,0 +1,759 @@
+/**
+ * @file io/compression.hpp
+ * @author HenryAWE
+ * @brief Compressed byte code streams
+ */
+
+#ifndef ASBIND20_IO_COMPRESSION_HPP
+#define ASBIND20_IO_COMPRESSION_HPP
+
+#pragma once
+
+#include <cstdint>
+#include <cstring>
+#include <cstddef>
+#include <algorithm>
+#include <span>
+#include <vector>
+#include <iostream>
+#include "../detail/config.hpp"
+#include "../detail/include_as.hpp"
+#include "stream.hpp"
+
+namespace asbind20::io
+{
+/**
+ * @brief Compression method of byte code stream
+ */
+enum class compression : std::uint8_t
+{
+    /// Store the byte code without compression
+    none = 0,
+    /// Built-in LZ77 compression using the LZ4 block format
+    lz = 1
+};
+
+/**
+ * @brief Built-in LZ codec
+ *
+ * The encoded data follows the LZ4 block format, so it can also be decoded by the reference LZ4 implementation.
+ */
+namespace lz
+{
+    /**
+     * @brief Maximum distance of a back reference
+     */
+    inline constexpr std::size_t max_distance = 65535;
+
+    /**
+     * @brief Worst-case size of compressed data
+     */
+    [[nodiscard]]
+    constexpr std::size_t compress_bound(std::size_t size) noexcept
+    {
+        return size + size / 255 + 16;
+    }
+
+    namespace detail
+    {
+        inline constexpr std::size_t min_match = 4;
+        // The last match must start at least 12 bytes before the end of block
+        inline constexpr std::size_t match_limit = 12;
+        // The last 5 bytes are always literals
+        inline constexpr std::size_t last_literals = 5;
+        inline constexpr unsigned int hash_log = 12;
+
+        inline std::uint32_t read32(const std::byte* p) noexcept
+        {
+            std::uint32_t val;
+            std::memcpy(&val, p, sizeof(val));
+            return val;
+        }
+
+        inline std::uint32_t hash32(std::uint32_t seq) noexcept
+        {
+            return (seq * 2654435761u) >> (32 - hash_log);
+        }
+
+        inline std::byte* write_length(std::byte* op, std::size_t len) noexcept
+        {
+            while(len >= 255)
+            {
+                *op++ = std::byte(255);
+                len -= 255;
+            }
+            *op++ = static_cast<std::byte>(len);
+            return op;
+        }
+
+        inline std::byte* write_sequence(
+            std::byte* op,
+            const std::byte* literals,
+            std::size_t literal_len,
+            std::size_t offset,
+            std::size_t match_len
+        ) noexcept
+        {
+            std::byte* token = op++;
+            unsigned int tk = 0;
+
+            if(literal_len >= 15)
+            {
+                tk = 15u << 4;
+                op = write_length(op, literal_len - 15);
+            }
+            else
+                tk = static_cast<unsigned int>(literal_len) << 4;
+            if(literal_len != 0)
+            {
+                std::memcpy(op, literals, literal_len);
+                op += literal_len;
+            }
+
+            if(match_len != 0)
+            {
+                *op++ = static_cast<std::byte>(offset & 0xFF);
+                *op++ = static_cast<std::byte>((offset >> 8) & 0xFF);
+
+                std::size_t ml = match_len - min_match;
+                if(ml >= 15)
+                {
+                    tk |= 15u;
+                    op = write_length(op, ml - 15);
+                }
+                else
+                    tk |= static_cast<unsigned int>(ml);
+            }
+
+            *token = static_cast<std::byte>(tk);
+            return op;
+        }
+    } // namespace detail
+
+    /**
+     * @brief Compress data
+     *
+     * @param src Source data
+     * @param dst Output buffer. Its size must be at least `compress_bound(src.size())`.
+     * @return Size of compressed data
+     */
+    inline std::size_t compress(
+        std::span<const std::byte> src,
+        std::span<std::byte> dst
+    ) noexcept
+    {
+        using namespace detail;
+
+        ASBIND20_ASSERT(dst.size() >= compress_bound(src.size()));
+
+        const std::byte* const base = src.data();
+        const std::size_t n = src.size();
+        std::byte* op = dst.data();
+
+        std::size_t anchor = 0;
+        if(n > match_limit)
+        {
+            // Stores position + 1, so 0 means empty slot
+            std::uint32_t table[1u << hash_log] = {};
+
+            const std::size_t limit = n - match_limit;
+            const std::size_t match_end_limit = n - last_literals;
+            std::size_t ip = 0;
+            while(ip < limit)
+            {
+                const std::uint32_t seq = read32(base + ip);
+                const std::uint32_t h = hash32(seq);
+                const std::size_t ref = table[h];
+                table[h] = static_cast<std::uint32_t>(ip + 1);
+
+                if(ref == 0 ||
+                   ip - (ref - 1) > max_distance ||
+                   read32(base + ref - 1) != seq)
+                {
+                    ++ip;
+                    continue;
+                }
+
+                const std::size_t match_pos = ref - 1;
+                std::size_t match_len = min_match;
+                while(ip + match_len < match_end_limit &&
+                      base[match_pos + match_len] == base[ip + match_len])
+                    ++match_len;
+
+                op = write_sequence(
+                    op,
+                    base + anchor,
+                    ip - anchor,
+                    ip - match_pos,
+                    match_len
+                );
+                ip += match_len;
+                anchor = ip;
+            }
+        }
+
+        op = detail::write_sequence(op, base + anchor, n - anchor, 0, 0);
+        return static_cast<std::size_t>(op - dst.data());
+    }
+
+    /**
+     * @brief Decompress data
+     *
+     * @param src Compressed data
+     * @param dst Output buffer. Its size must be exactly the size of original data.
+     * @return True if the data is valid and exactly fills the output buffer
+     */
+    [[nodiscard]]
+    inline bool decompress(
+        std::span<const std::byte> src,
+        std::span<std::byte> dst
+    ) noexcept
+    {
+        const std::byte* ip = src.data();
+        const std::byte* const ip_end = ip + src.size();
+        std::byte* op = dst.data();
+        std::byte* const op_end = op + dst.size();
+
+        auto read_length = [&](std::size_t& len) -> bool
+        {
+            unsigned int b;
+            do
+            {
+                if(ip == ip_end) [[unlikely]]
+                    return false;
+                b = static_cast<unsigned int>(*ip++);
+                len += b;
+            } while(b == 255);
+            return true;
+        };
+
+        while(ip < ip_end)
+        {
+            const auto token = static_cast<unsigned int>(*ip++);
+
+            std::size_t literal_len = token >> 4;
+            if(literal_len == 15 && !read_length(literal_len)) [[unlikely]]
+                return false;
+            if(static_cast<std::size_t>(ip_end - ip) < literal_len ||
+               static_cast<std::size_t>(op_end - op) < literal_len) [[unlikely]]
+                return false;
+            if(literal_len != 0)
+            {
+                std::memcpy(op, ip, literal_len);
+                ip += literal_len;
+                op += literal_len;
+            }
+
+            if(ip == ip_end)
+                break; // The last sequence only contains literals
+
+            if(ip_end - ip < 2) [[unlikely]]
+                return false;
+            const std::size_t offset =
+                static_cast<std::size_t>(ip[0]) |
+                (static_cast<std::size_t>(ip[1]) << 8);
+            ip += 2;
+            if(offset == 0 || offset > static_cast<std::size_t>(op - dst.data())) [[unlikely]]
+                return false;
+
+            std::size_t match_len = token & 15u;
+            if(match_len == 15 && !read_length(match_len)) [[unlikely]]
+                return false;
+            match_len += detail::min_match;
+            if(static_cast<std::size_t>(op_end - op) < match_len) [[unlikely]]
+                return false;
+
+            // Byte-wise copy because the ranges may overlap
+            const std::byte* match = op - offset;
+            for(std::size_t i = 0; i < match_len; ++i)
+                op[i] = match[i];
+            op += match_len;
+        }
+
+        return op == op_end;
+    }
+} // namespace lz
+
+namespace detail
+{
+    inline constexpr char compressed_magic[4] = {'A', 'S', 'B', 'Z'};
+    inline constexpr std::uint8_t compressed_format_version = 1;
+    // Every block can be decompressed independently.
+    // Its size is limited by the maximum distance of back reference.
+    inline constexpr std::size_t compressed_block_size = 64 * 1024;
+
+    inline void store_u32(std::byte* p, std::uint32_t val) noexcept
+    {
+        for(int i = 0; i < 4; ++i)
+            p[i] = static_cast<std::byte>((val >> (8 * i)) & 0xFF);
+    }
+
+    inline std::uint32_t load_u32(const std::byte* p) noexcept
+    {
+        std::uint32_t val = 0;
+        for(int i = 0; i < 4; ++i)
+            val |= static_cast<std::uint32_t>(p[i]) << (8 * i);
+        return val;
+    }
+} // namespace detail
+
+/**
+ * @brief Stream that compresses content block by block before writing it into another binary stream
+ *
+ * Layout: a 6-byte header (magic `ASBZ`, format version, compression method),
+ * followed by blocks of `[raw size][stored size][data]` and a terminating block whose raw size is 0.
+ * A block whose stored size equals to its raw size is stored without compression.
+ *
+ * @note Call `finish()` after writing all content.
+ */
+class compressed_writer final : public AS_NAMESPACE_QUALIFIER asIBinaryStream
+{
+public:
+    compressed_writer() = delete;
+    compressed_writer(const compressed_writer&) = delete;
+
+    /**
+     * @param out Underlying binary stream
+     * @param method Compression method
+     */
+    explicit compressed_writer(
+        AS_NAMESPACE_QUALIFIER asIBinaryStream& out,
+        compression method = compression::lz
+    )
+        : m_out(&out), m_method(method)
+    {
+        m_raw.reserve(detail::compressed_block_size);
+    }
+
+    compressed_writer& operator=(const compressed_writer&) = delete;
+
+    int Read(void* ptr, AS_NAMESPACE_QUALIFIER asUINT size) override
+    {
+        (void)ptr;
+        (void)size;
+        return AS_NAMESPACE_QUALIFIER asERROR;
+    }
+
+    int Write(const void* ptr, AS_NAMESPACE_QUALIFIER asUINT size) override
+    {
+        if(m_error < 0) [[unlikely]]
+            return m_error;
+
+        if(!m_header_written)
+        {
+            int r = write_header();
+            if(r < 0) [[unlikely]]
+                return r;
+        }
+
+        const auto* src = static_cast<const std::byte*>(ptr);
+        while(size > 0)
+        {
+            std::size_t n = std::min<std::size_t>(
+                size, detail::compressed_block_size - m_raw.size()
+            );
+            m_raw.insert(m_raw.end(), src, src + n);
+            src += n;
+            size -= static_cast<AS_NAMESPACE_QUALIFIER asUINT>(n);
+
+            if(m_raw.size() == detail::compressed_block_size)
+            {
+                int r = flush_block();
+                if(r < 0) [[unlikely]]
+                    return r;
+            }
+        }
+
+        return AS_NAMESPACE_QUALIFIER asSUCCESS;
+    }
+
+    /**
+     * @brief Write the remaining content and the terminating block
+     *
+     * @return AngelScript error code
+     */
+    int finish()
+    {
+        if(m_error < 0) [[unlikely]]
+            return m_error;
+        if(!m_header_written)
+        {
+            int r = write_header();
+            if(r < 0) [[unlikely]]
+                return r;
+        }
+
+        if(!m_raw.empty())
+        {
+            int r = flush_block();
+            if(r < 0) [[unlikely]]
+                return r;
+        }
+
+        std::byte terminator[8] = {};
+        m_total_stored += sizeof(terminator);
+        return set_error(m_out->Write(terminator, sizeof(terminator)));
+    }
+
+    /**
+     * @brief Total bytes written by the engine
+     */
+    [[nodiscard]]
+    std::size_t raw_size() const noexcept
+    {
+        return m_total_raw + m_raw.size();
+    }
+
+    /**
+     * @brief Total bytes written into the underlying stream
+     */
+    [[nodiscard]]
+    std::size_t stored_size() const noexcept
+    {
+        return m_total_stored;
+    }
+
+private:
+    AS_NAMESPACE_QUALIFIER asIBinaryStream* m_out;
+    compression m_method;
+    bool m_header_written = false;
+    int m_error = AS_NAMESPACE_QUALIFIER asSUCCESS;
+    std::size_t m_total_raw = 0;
+    std::size_t m_total_stored = 0;
+    std::vector<std::byte> m_raw;
+    std::vector<std::byte> m_packed;
+
+    int set_error(int r) noexcept
+    {
+        if(r < 0)
+            m_error = r;
+        return r;
+    }
+
+    int write_header()
+    {
+        std::byte header[6];
+        std::memcpy(header, detail::compressed_magic, 4);
+        header[4] = static_cast<std::byte>(detail::compressed_format_version);
+        header[5] = static_cast<std::byte>(m_method);
+        m_header_written = true;
+        m_total_stored += sizeof(header);
+        return set_error(m_out->Write(header, sizeof(header)));
+    }
+
+    int flush_block()
+    {
+        const std::byte* data = m_raw.data();
+        std::size_t stored = m_raw.size();
+
+        if(m_method == compression::lz)
+        {
+            m_packed.resize(lz::compress_bound(m_raw.size()));
+            std::size_t packed_size = lz::compress(m_raw, m_packed);
+            if(packed_size < m_raw.size())
+            {
+                data = m_packed.data();
+                stored = packed_size;
+            }
+        }
+
+        std::byte block_header[8];
+        detail::store_u32(block_header, static_cast<std::uint32_t>(m_raw.size()));
+        detail::store_u32(block_header + 4, static_cast<std::uint32_t>(stored));
+        int r = set_error(m_out->Write(block_header, sizeof(block_header)));
+        if(r < 0) [[unlikely]]
+            return r;
+        r = set_error(m_out->Write(data, static_cast<AS_NAMESPACE_QUALIFIER asUINT>(stored)));
+        if(r < 0) [[unlikely]]
+            return r;
+
+        m_total_raw += m_raw.size();
+        m_total_stored += sizeof(block_header) + stored;
+        m_raw.clear();
+        return AS_NAMESPACE_QUALIFIER asSUCCESS;
+    }
+};
+
+/**
+ * @brief Stream that decompresses content written by `compressed_writer`
+ *
+ * The compression method is detected from the header.
+ */
+class compressed_reader final : public AS_NAMESPACE_QUALIFIER asIBinaryStream
+{
+public:
+    compressed_reader() = delete;
+    compressed_reader(const compressed_reader&) = delete;
+
+    /**
+     * @param in Underlying binary stream
+     */
+    explicit compressed_reader(AS_NAMESPACE_QUALIFIER asIBinaryStream& in)
+        : m_in(&in) {}
+
+    compressed_reader& operator=(const compressed_reader&) = delete;
+
+    int Read(void* ptr, AS_NAMESPACE_QUALIFIER asUINT size) override
+    {
+        if(m_error < 0) [[unlikely]]
+            return m_error;
+
+        if(!m_header_read)
+        {
+            int r = read_header();
+            if(r < 0) [[unlikely]]
+                return r;
+        }
+
+        auto* dst = static_cast<std::byte*>(ptr);
+        while(size > 0)
+        {
+            if(m_pos == m_raw.size())
+            {
+                int r = load_block();
+                if(r < 0) [[unlikely]]
+                    return r;
+            }
+
+            std::size_t n = std::min<std::size_t>(size, m_raw.size() - m_pos);
+            std::memcpy(dst, m_raw.data() + m_pos, n);
+            m_pos += n;
+            dst += n;
+            size -= static_cast<AS_NAMESPACE_QUALIFIER asUINT>(n);
+        }
+
+        return AS_NAMESPACE_QUALIFIER asSUCCESS;
+    }
+
+    int Write(const void* ptr, AS_NAMESPACE_QUALIFIER asUINT size) override
+    {
+        (void)ptr;
+        (void)size;
+        return AS_NAMESPACE_QUALIFIER asERROR;
+    }
+
+    /**
+     * @brief Read and validate the header
+     *
+     * It will be called automatically on the first read.
+     *
+     * @return AngelScript error code
+     */
+    int read_header()
+    {
+        m_header_read = true;
+
+        std::byte header[6];
+        int r = set_error(m_in->Read(header, sizeof(header)));
+        if(r < 0)
+            return r;
+
+        if(std::memcmp(header, detail::compressed_magic, 4) != 0 ||
+           static_cast<std::uint8_t>(header[4]) != detail::compressed_format_version)
+            return set_error(AS_NAMESPACE_QUALIFIER asINVALID_ARG);
+
+        auto method = static_cast<compression>(header[5]);
+        if(method != compression::none && method != compression::lz)
+            return set_error(AS_NAMESPACE_QUALIFIER asNOT_SUPPORTED);
+        m_method = method;
+
+        return AS_NAMESPACE_QUALIFIER asSUCCESS;
+    }
+
+    /**
+     * @brief Compression method declared by the header
+     */
+    [[nodiscard]]
+    compression method() const noexcept
+    {
+        return m_method;
+    }
+
+private:
+    AS_NAMESPACE_QUALIFIER asIBinaryStream* m_in;
+    compression m_method = compression::none;
+    bool m_header_read = false;
+    int m_error = AS_NAMESPACE_QUALIFIER asSUCCESS;
+    std::size_t m_pos = 0;
+    std::vector<std::byte> m_raw;
+    std::vector<std::byte> m_packed;
+
+    int set_error(int r) noexcept
+    {
+        if(r < 0)
+            m_error = r;
+        return r;
+    }
+
+    int load_block()
+    {
+        std::byte block_header[8];
+        int r = set_error(m_in->Read(block_header, sizeof(block_header)));
+        if(r < 0) [[unlikely]]
+            return r;
+
+        const std::size_t raw = detail::load_u32(block_header);
+        const std::size_t stored = detail::load_u32(block_header + 4);
+        // Terminating block or invalid size
+        if(raw == 0 ||
+           raw > detail::compressed_block_size ||
+           stored > lz::compress_bound(raw)) [[unlikely]]
+            return set_error(AS_NAMESPACE_QUALIFIER asERROR);
+
+        m_raw.resize(raw);
+        m_pos = 0;
+        if(stored == raw)
+        {
+            return set_error(m_in->Read(
+                m_raw.data(), static_cast<AS_NAMESPACE_QUALIFIER asUINT>(raw)
+            ));
+        }
+
+        if(m_method != compression::lz) [[unlikely]]
+            return set_error(AS_NAMESPACE_QUALIFIER asERROR);
+
+        m_packed.resize(stored);
+        r = set_error(m_in->Read(
+            m_packed.data(), static_cast<AS_NAMESPACE_QUALIFIER asUINT>(stored)
+        ));
+        if(r < 0) [[unlikely]]
+            return r;
+
+        if(!lz::decompress(m_packed, m_raw)) [[unlikely]]
+            return set_error(AS_NAMESPACE_QUALIFIER asERROR);
+        return AS_NAMESPACE_QUALIFIER asSUCCESS;
+    }
+};
+
+} // namespace asbind20::io
+
+namespace asbind20
+{
+/**
+ * @addtogroup ByteCode
+ */
+/// @{
+
+/**
+ * @brief Save compressed byte code to `std::ostream`
+ *
+ * @param os Output stream
+ * @param m Script module to save
+ * @param strip_debug_info Strip debug information
+ * @param method Compression method
+ * @return AngelScript error code
+ */
+inline int save_byte_code_compressed(
+    std::ostream& os,
+    AS_NAMESPACE_QUALIFIER asIScriptModule* m,
+    bool strip_debug_info = false,
+    io::compression method = io::compression::lz
+)
+{
+    if(!m) [[unlikely]]
+        return AS_NAMESPACE_QUALIFIER asINVALID_ARG;
+
+    io::ostream_wrapper out(os);
+    io::compressed_writer writer(out, method);
+    int r = m->SaveByteCode(&writer, strip_debug_info);
+    if(r < 0)
+        return r;
+    return writer.finish();
+}
+
+/**
+ * @brief Save compressed byte code to an output iterator
+ *
+ * @tparam OutputIteratorValueType Value type of output iterator.
+ *
+ * @param out Output iterator
+ * @param m Script module
+ * @param strip_debug_info Strip debug information
+ * @param method Compression method
+ * @return AngelScript error code
+ */
+template <typename OutputIteratorValueType = std::byte>
+int save_byte_code_compressed(
+    std::output_iterator<OutputIteratorValueType> auto out,
+    AS_NAMESPACE_QUALIFIER asIScriptModule* m,
+    bool strip_debug_info = false,
+    io::compression method = io::compression::lz
+)
+{
+    if(!m) [[unlikely]]
+        return AS_NAMESPACE_QUALIFIER asINVALID_ARG;
+
+    io::copy_to<decltype(out), OutputIteratorValueType> wrapper(std::move(out));
+    io::compressed_writer writer(wrapper, method);
+    int r = m->SaveByteCode(&writer, strip_debug_info);
+    if(r < 0)
+        return r;
+    return writer.finish();
+}
+
+/**
+ * @brief Load compressed byte code from `std::istream`
+ *
+ * @param is Input stream
+ * @param m Script module
+ * @return Loading result
+ */
+inline io::load_byte_code_result load_byte_code_compressed(
+    std::istream& is,
+    AS_NAMESPACE_QUALIFIER asIScriptModule* m
+)
+{
+    if(!m) [[unlikely]]
+        return {AS_NAMESPACE_QUALIFIER asINVALID_ARG, false};
+
+    io::istream_wrapper in(is);
+    io::compressed_reader reader(in);
+    int r = reader.read_header();
+    if(r < 0)
+        return {r, false};
+
+    bool debug_info_stripped;
+    r = m->LoadByteCode(&reader, &debug_info_stripped);
+    return {r, debug_info_stripped};
+}
+
+/**
+ * @brief Load compressed byte code from memory buffer
+ *
+ * @param mem Memory buffer
+ * @param size Buffer size
+ * @param m Script module
+ * @return Loading result
+ */
+inline io::load_byte_code_result load_byte_code_compressed(
+    const void* mem,
+    std::size_t size,
+    AS_NAMESPACE_QUALIFIER asIScriptModule* m
+)
+{
+    if(!m) [[unlikely]]
+        return {AS_NAMESPACE_QUALIFIER asINVALID_ARG, false};
+
+    io::memory_reader in(mem, size);
+    io::compressed_reader reader(in);
+    int r = reader.read_header();
+    if(r < 0)
+        return {r, false};
+
+    bool debug_info_stripped;
+    r = m->LoadByteCode(&reader, &debug_info_stripped);
+    return {r, debug_info_stripped};
+}
+
+inline io::load_byte_code_result load_byte_code_compressed(
+    std::span<const std::byte> mem,
+    AS_NAMESPACE_QUALIFIER asIScriptModule* m
+)
+{
+    return load_byte_code_compressed(mem.data(), mem.size_bytes(), m);
+}
+
+/// @}
+} // namespace asbind20
+
+#endif
@@ -0,0 +1,262 @@
+/**
+ * @file io/module_builder.hpp
+ * @author HenryAWE
+ * @brief Building multiple modules concurrently
+ */
+
+#ifndef ASBIND20_IO_MODULE_BUILDER_HPP
+#define ASBIND20_IO_MODULE_BUILDER_HPP
+
+#pragma once
+
+#include <cstddef>
+#include <algorithm>
+#include <atomic>
+#include <mutex>
+#include <span>
+#include <string>
+#include <thread>
+#include <vector>
+#include <filesystem>
+#include "../detail/include_as.hpp"
+#include "section.hpp"
+
+namespace asbind20::io
+{
+/**
+ * @brief Description of a module to be built
+ */
+struct module_spec
+{
+    std::string name;
+    std::vector<std::filesystem::path> files;
+};
+
+/**
+ * @brief Message emitted by the engine during building a module
+ */
+struct diagnostic
+{
+    std::string section;
+    int row = 0;
+    int col = 0;
+    AS_NAMESPACE_QUALIFIER asEMsgType type = AS_NAMESPACE_QUALIFIER asMSGTYPE_INFORMATION;
+    std::string message;
+};
+
+/**
+ * @brief Result of building a module
+ */
+struct module_build_result
+{
+    /**
+     * @brief Result code. It will be the error of reading files if any file cannot be read.
+     */
+    int r = AS_NAMESPACE_QUALIFIER asSUCCESS;
+
+    /**
+     * @brief The built module. Null if it is failed to read files.
+     */
+    AS_NAMESPACE_QUALIFIER asIScriptModule* module = nullptr;
+
+    /**
+     * @brief Messages emitted by the engine during building this module
+     */
+    std::vector<diagnostic> diagnostics;
+
+    explicit operator bool() const noexcept
+    {
+        return r >= 0;
+    }
+
+    [[nodiscard]]
+    std::size_t error_count() const noexcept
+    {
+        return static_cast<std::size_t>(std::ranges::count(
+            diagnostics,
+            AS_NAMESPACE_QUALIFIER asMSGTYPE_ERROR,
+            &diagnostic::type
+        ));
+    }
+};
+
+namespace detail
+{
+    class module_build_job
+    {
+    public:
+        module_build_job(
+            AS_NAMESPACE_QUALIFIER asIScriptEngine* engine,
+            std::span<const module_spec> specs,
+            std::span<module_build_result> results
+        ) noexcept
+            : m_engine(engine), m_specs(specs), m_results(results) {}
+
+        void run()
+        {
+            std::vector<script_section> sections;
+
+            while(true)
+            {
+                std::size_t idx = m_next.fetch_add(1, std::memory_order_relaxed);
+                if(idx >= m_specs.size())
+                    break;
+
+                const module_spec& spec = m_specs[idx];
+                module_build_result& result = m_results[idx];
+
+                // Reading files doesn't touch the engine, so it can be done concurrently.
+                sections.resize(spec.files.size());
+                int r = AS_NAMESPACE_QUALIFIER asSUCCESS;
+                for(std::size_t i = 0; i < spec.files.size(); ++i)
+                {
+                    r = read_file(sections[i], spec.files[i]);
+                    if(r < 0)
+                    {
+                        result.diagnostics.push_back(
+                            {spec.files[i].string(), 0, 0, AS_NAMESPACE_QUALIFIER asMSGTYPE_ERROR, "Failed to read file"}
+                        );
+                        break;
+                    }
+                }
+                if(r < 0)
+                {
+                    result.r = r;
+                    continue;
+                }
+
+                build(spec, result, sections);
+            }
+        }
+
+    private:
+        AS_NAMESPACE_QUALIFIER asIScriptEngine* m_engine;
+        std::span<const module_spec> m_specs;
+        std::span<module_build_result> m_results;
+        std::atomic_size_t m_next = 0;
+        std::mutex m_build_mx;
+
+        static void message_callback(
+            const AS_NAMESPACE_QUALIFIER asSMessageInfo* msg, void* param
+        )
+        {
+            auto* out = static_cast<std::vector<diagnostic>*>(param);
+            out->push_back(
+                {msg->section ? msg->section : "",
+                 msg->row,
+                 msg->col,
+                 msg->type,
+                 msg->message ? msg->message : ""}
+            );
+        }
+
+        void build(
+            const module_spec& spec,
+            module_build_result& result,
+            std::span<const script_section> sections
+        )
+        {
+            // AngelScript allows only one module to be built at a time for each engine.
+            std::lock_guard lock(m_build_mx);
+
+            m_engine->SetMessageCallback(
+                AS_NAMESPACE_QUALIFIER asFUNCTION(&message_callback),
+                &result.diagnostics,
+                AS_NAMESPACE_QUALIFIER asCALL_CDECL
+            );
+
+            auto* m = m_engine->GetModule(
+                spec.name.c_str(), AS_NAMESPACE_QUALIFIER asGM_ALWAYS_CREATE
+            );
+            result.module = m;
+            if(!m) [[unlikely]]
+            {
+                result.r = AS_NAMESPACE_QUALIFIER asERROR;
+                return;
+            }
+
+            for(const auto& s : sections)
+            {
+                result.r = load_section(m, s);
+                if(result.r < 0)
+                    return;
+            }
+
+            result.r = m->Build();
+        }
+    };
+} // namespace detail
+
+/**
+ * @brief Build modules from files using multiple threads
+ *
+ * Files are read on worker threads concurrently.
+ * Because AngelScript only allows one build at a time for each engine,
+ * the compilation is serialized, while other workers keep reading files of the following modules.
+ *
+ * Messages are collected into the results of the modules they belong to.
+ *
+ * @param engine Script engine
+ * @param specs Modules to build. Existing modules with the same names will be discarded.
+ * @param thread_count Count of worker threads. Zero means using `std::thread::hardware_concurrency()`.
+ *                     One means building in the calling thread.
+ *
+ * @return Results in the same order as `specs`
+ *
+ * @warning The message callback of the engine will be cleared after building,
+ *          because AngelScript doesn't provide a way to query the previous one.
+ *          Set it again if needed.
+ *
+ * @note Call `concurrent::prepare_multithread()` before creating the engine if `thread_count` is not one.
+ */
+inline std::vector<module_build_result> build_modules(
+    AS_NAMESPACE_QUALIFIER asIScriptEngine* engine,
+    std::span<const module_spec> specs,
+    unsigned int thread_count = 0
+)
+{
+    std::vector<module_build_result> results(specs.size());
+    if(!engine) [[unlikely]]
+    {
+        for(auto& r : results)
+            r.r = AS_NAMESPACE_QUALIFIER asINVALID_ARG;
+        return results;
+    }
+
+    if(thread_count == 0)
+        thread_count = std::max(1u, std::thread::hardware_concurrency());
+    if(thread_count > specs.size())
+        thread_count = static_cast<unsigned int>(std::max<std::size_t>(1, specs.size()));
+
+    detail::module_build_job job(engine, specs, results);
+    if(thread_count == 1)
+        job.run();
+    else
+    {
+        std::vector<std::thread> workers;
+        workers.reserve(thread_count - 1);
+        for(unsigned int i = 0; i < thread_count - 1; ++i)
+        {
+            workers.emplace_back(
+                [&job]()
+                {
+                    job.run();
+                    AS_NAMESPACE_QUALIFIER asThreadCleanup();
+                }
+            );
+        }
+
+        // The calling thread also works
+        job.run();
+
+        for(auto& t : workers)
+            t.join();
+    }
+
+    engine->ClearMessageCallback();
+
+    return results;
+}
+} // namespace asbind20::io
+
+#endif
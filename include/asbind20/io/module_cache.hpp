@@ -0,0 +1,568 @@
+/**
+ * @file io/module_cache.hpp
+ * @author HenryAWE
+ * @brief Content-addressed compile cache for script modules
+ */
+
+#ifndef ASBIND20_IO_MODULE_CACHE_HPP
+#define ASBIND20_IO_MODULE_CACHE_HPP
+
+#pragma once
+
+#include <cstdint>
+#include <cstdio>
+#include <cstring>
+#include <atomic>
+#include <functional>
+#include <iterator>
+#include <random>
+#include <span>
+#include <string>
+#include <thread>
+#include <vector>
+#include <filesystem>
+#include <fstream>
+#include <system_error>
+#include "../detail/include_as.hpp"
+#include "../detail/hash.hpp"
+#include "../ranges/typeinfo_views.hpp"
+#include "stream.hpp"
+#include "section.hpp"
+
+namespace asbind20::io
+{
+namespace detail
+{
+    inline void hash_function(
+        asbind20::detail::fnv1a_64& h,
+        const AS_NAMESPACE_QUALIFIER asIScriptFunction* f
+    )
+    {
+        if(!f) [[unlikely]]
+        {
+            h.update_value(0);
+            return;
+        }
+
+        h.update(f->GetNamespace());
+        h.update(f->GetDeclaration(true, true, true));
+    }
+
+    inline void hash_type_decl(
+        asbind20::detail::fnv1a_64& h,
+        const AS_NAMESPACE_QUALIFIER asIScriptEngine* engine,
+        int type_id
+    )
+    {
+        h.update_value(type_id & ~AS_NAMESPACE_QUALIFIER asTYPEID_MASK_SEQNBR);
+        h.update(engine->GetTypeDeclaration(type_id, true));
+    }
+
+    inline void hash_typeinfo(
+        asbind20::detail::fnv1a_64& h,
+        const AS_NAMESPACE_QUALIFIER asITypeInfo* ti
+    )
+    {
+        if(!ti) [[unlikely]]
+        {
+            h.update_value(0);
+            return;
+        }
+
+        h.update(ti->GetNamespace());
+        h.update(ti->GetName());
+        h.update_value(ti->GetFlags());
+        h.update_value(ti->GetSize());
+
+        for(auto* f : ranges::views::all_factories(ti))
+            hash_function(h, f);
+        for(auto [beh, f] : ranges::views::all_behaviours(ti))
+        {
+            h.update_value(beh);
+            hash_function(h, f);
+        }
+        for(auto* f : ranges::views::all_methods(const_cast<AS_NAMESPACE_QUALIFIER asITypeInfo*>(ti)))
+            hash_function(h, f);
+
+        AS_NAMESPACE_QUALIFIER asUINT prop_count = ti->GetPropertyCount();
+        h.update_value(prop_count);
+        for(AS_NAMESPACE_QUALIFIER asUINT i = 0; i < prop_count; ++i)
+        {
+            int offset = 0;
+            ti->GetProperty(i, nullptr, nullptr, nullptr, nullptr, &offset);
+            h.update_value(offset);
+            h.update(ti->GetPropertyDeclaration(i, true));
+        }
+
+        AS_NAMESPACE_QUALIFIER asUINT funcdef_count = ti->GetChildFuncdefCount();
+        h.update_value(funcdef_count);
+        for(AS_NAMESPACE_QUALIFIER asUINT i = 0; i < funcdef_count; ++i)
+        {
+            auto* fd = ti->GetChildFuncdef(i);
+            hash_function(h, fd ? fd->GetFuncdefSignature() : nullptr);
+        }
+    }
+} // namespace detail
+
+/**
+ * @brief Compute a digest of the application interface registered to the engine
+ *
+ * The digest covers global functions, global properties, object types and their members,
+ * enums, funcdefs, typedefs, the string factory, and the default array type.
+ * Any change to the registered API will result in a different digest.
+ *
+ * @param engine Script engine. It cannot be nullptr.
+ */
+[[nodiscard]]
+inline std::uint64_t interface_digest(
+    const AS_NAMESPACE_QUALIFIER asIScriptEngine* engine
+)
+{
+    asbind20::detail::fnv1a_64 h;
+    if(!engine) [[unlikely]]
+        return h.value();
+
+    h.update(AS_NAMESPACE_QUALIFIER asGetLibraryVersion());
+    h.update(AS_NAMESPACE_QUALIFIER asGetLibraryOptions());
+
+    AS_NAMESPACE_QUALIFIER asUINT func_count = engine->GetGlobalFunctionCount();
+    h.update_value(func_count);
+    for(AS_NAMESPACE_QUALIFIER asUINT i = 0; i < func_count; ++i)
+        detail::hash_function(h, engine->GetGlobalFunctionByIndex(i));
+
+    AS_NAMESPACE_QUALIFIER asUINT prop_count = engine->GetGlobalPropertyCount();
+    h.update_value(prop_count);
+    for(AS_NAMESPACE_QUALIFIER asUINT i = 0; i < prop_count; ++i)
+    {
+        const char* name = nullptr;
+        const char* ns = nullptr;
+        int type_id = 0;
+        bool is_const = false;
+        engine->GetGlobalPropertyByIndex(i, &name, &ns, &type_id, &is_const);
+        h.update(ns);
+        h.update(name);
+        h.update_value(is_const);
+        detail::hash_type_decl(h, engine, type_id);
+    }
+
+    AS_NAMESPACE_QUALIFIER asUINT type_count = engine->GetObjectTypeCount();
+    h.update_value(type_count);
+    for(AS_NAMESPACE_QUALIFIER asUINT i = 0; i < type_count; ++i)
+        detail::hash_typeinfo(h, engine->GetObjectTypeByIndex(i));
+
+    AS_NAMESPACE_QUALIFIER asUINT enum_count = engine->GetEnumCount();
+    h.update_value(enum_count);
+    for(AS_NAMESPACE_QUALIFIER asUINT i = 0; i < enum_count; ++i)
+    {
+        auto* ti = engine->GetEnumByIndex(i);
+        h.update(ti->GetNamespace());
+        h.update(ti->GetName());
+        h.update_value(ti->GetTypedefTypeId());
+        for(auto [name, val] : ranges::views::all_enum_values_of<compat::script_enum_value_type>(ti))
+        {
+            h.update(name);
+            h.update_value(val);
+        }
+    }
+
+    AS_NAMESPACE_QUALIFIER asUINT funcdef_count = engine->GetFuncdefCount();
+    h.update_value(funcdef_count);
+    for(AS_NAMESPACE_QUALIFIER asUINT i = 0; i < funcdef_count; ++i)
+    {
+        auto* fd = engine->GetFuncdefByIndex(i);
+        detail::hash_function(h, fd ? fd->GetFuncdefSignature() : nullptr);
+    }
+
+    AS_NAMESPACE_QUALIFIER asUINT typedef_count = engine->GetTypedefCount();
+    h.update_value(typedef_count);
+    for(AS_NAMESPACE_QUALIFIER asUINT i = 0; i < typedef_count; ++i)
+    {
+        auto* ti = engine->GetTypedefByIndex(i);
+        h.update(ti->GetNamespace());
+        h.update(ti->GetName());
+        detail::hash_type_decl(h, engine, ti->GetTypedefTypeId());
+    }
+
+    AS_NAMESPACE_QUALIFIER asDWORD str_flags = 0;
+    int str_type_id = engine->GetStringFactoryReturnTypeId(&str_flags);
+    h.update_value(str_flags);
+    if(str_type_id >= 0)
+        detail::hash_type_decl(h, engine, str_type_id);
+    else
+        h.update_value(str_type_id);
+
+    int array_type_id = engine->GetDefaultArrayTypeId();
+    if(array_type_id >= 0)
+        detail::hash_type_decl(h, engine, array_type_id);
+    else
+        h.update_value(array_type_id);
+
+    return h.value();
+}
+
+namespace detail
+{
+    // Engine properties that only affect the execution, e.g. the size of stack and the garbage collection.
+    // Other properties are considered to affect the compilation or the byte code.
+    inline bool is_runtime_engine_property(int prop) noexcept
+    {
+        switch(prop)
+        {
+        case AS_NAMESPACE_QUALIFIER asEP_COPY_SCRIPT_SECTIONS:
+        case AS_NAMESPACE_QUALIFIER asEP_MAX_STACK_SIZE:
+        case AS_NAMESPACE_QUALIFIER asEP_INIT_GLOBAL_VARS_AFTER_BUILD:
+        case AS_NAMESPACE_QUALIFIER asEP_AUTO_GARBAGE_COLLECT:
+        case AS_NAMESPACE_QUALIFIER asEP_MAX_NESTED_CALLS:
+        case AS_NAMESPACE_QUALIFIER asEP_GENERIC_CALL_MODE:
+        case AS_NAMESPACE_QUALIFIER asEP_INIT_STACK_SIZE:
+        case AS_NAMESPACE_QUALIFIER asEP_INIT_CALL_STACK_SIZE:
+        case AS_NAMESPACE_QUALIFIER asEP_MAX_CALL_STACK_SIZE:
+        case AS_NAMESPACE_QUALIFIER asEP_NO_DEBUG_OUTPUT:
+            return true;
+
+        default:
+            return false;
+        }
+    }
+} // namespace detail
+
+/**
+ * @brief Compute a digest of the engine properties that affect the compilation and the byte code
+ *
+ * Properties only affecting the execution, such as the stack size and the automatic garbage collection,
+ * are excluded.
+ *
+ * @param engine Script engine. It cannot be nullptr.
+ */
+[[nodiscard]]
+inline std::uint64_t engine_properties_digest(
+    const AS_NAMESPACE_QUALIFIER asIScriptEngine* engine
+)
+{
+    asbind20::detail::fnv1a_64 h;
+    if(!engine) [[unlikely]]
+        return h.value();
+
+    for(int prop = 1; prop < AS_NAMESPACE_QUALIFIER asEP_LAST_PROPERTY; ++prop)
+    {
+        if(detail::is_runtime_engine_property(prop))
+            continue;
+
+        h.update_value(prop);
+        h.update_value(engine->GetEngineProperty(
+            static_cast<AS_NAMESPACE_QUALIFIER asEEngineProp>(prop)
+        ));
+    }
+
+    return h.value();
+}
+
+/**
+ * @brief Result of building a module through the cache
+ */
+struct module_cache_result
+{
+    /// Result of building or loading byte code
+    int r;
+    /// The byte code was loaded from the cache
+    bool cache_hit;
+
+    /**
+     * @brief Will return true if `r` indicates the module was successfully built or loaded
+     */
+    explicit operator bool() const noexcept
+    {
+        return r >= 0;
+    }
+};
+
+/**
+ * @brief Content-addressed compile cache for script modules
+ *
+ * The cache key is computed from the script sections, the registered application interface,
+ * the engine properties affecting the compilation, and the AngelScript library version.
+ * On a cache hit, the stored byte code will be loaded into the module instead of compiling the sources.
+ * On a miss, the module will be built from the sources and the result will be written back to the cache.
+ *
+ * Every cache file starts with a header containing the size and the checksum of byte code.
+ * Truncated or corrupted files are rejected before loading, and the module will be rebuilt.
+ *
+ * @note The digest of application interface is computed on every build by default.
+ *       Use `pin_interface()` to reuse it if the interface won't be changed.
+ */
+class module_cache
+{
+public:
+    module_cache() = delete;
+
+    /**
+     * @param dir Directory for storing cached byte code. It will be created if it doesn't exist.
+     * @param strip_debug_info Strip debug information from cached byte code
+     */
+    explicit module_cache(
+        std::filesystem::path dir,
+        bool strip_debug_info = false
+    )
+        : m_dir(std::move(dir)), m_strip_debug_info(strip_debug_info) {}
+
+    module_cache(const module_cache&) = delete;
+
+    module_cache& operator=(const module_cache&) = delete;
+
+    [[nodiscard]]
+    const std::filesystem::path& directory() const noexcept
+    {
+        return m_dir;
+    }
+
+    /**
+     * @brief Compute the cache key of sections for a module of the given engine
+     */
+    [[nodiscard]]
+    std::uint64_t compute_key(
+        const AS_NAMESPACE_QUALIFIER asIScriptEngine* engine,
+        std::span<const script_section> sections
+    )
+    {
+        asbind20::detail::fnv1a_64 h;
+        h.update_value(get_interface_digest(engine));
+        h.update_value(engine_properties_digest(engine));
+        h.update_value(m_strip_debug_info);
+
+        h.update_value(sections.size());
+        for(const auto& s : sections)
+        {
+            h.update(s.name);
+            h.update_value(s.line_offset);
+            h.update(s.code);
+        }
+
+        return h.value();
+    }
+
+    /**
+     * @brief Path of the cache file for a key
+     */
+    [[nodiscard]]
+    std::filesystem::path cache_file(std::uint64_t key) const
+    {
+        char buf[24];
+        std::snprintf(
+            buf,
+            sizeof(buf),
+            "%016llx.asbc",
+            static_cast<unsigned long long>(key)
+        );
+        return m_dir / buf;
+    }
+
+    /**
+     * @brief Build a module from sections, reusing cached byte code if possible
+     *
+     * If the cached byte code fails to load, e.g. it is corrupted, the module will be rebuilt from the sources.
+     *
+     * @param m Script module. It should be empty.
+     * @param sections Script sections
+     */
+    module_cache_result build(
+        AS_NAMESPACE_QUALIFIER asIScriptModule* m,
+        std::span<const script_section> sections
+    )
+    {
+        if(!m) [[unlikely]]
+            return {AS_NAMESPACE_QUALIFIER asINVALID_ARG, false};
+
+        const std::filesystem::path filename = cache_file(
+            compute_key(m->GetEngine(), sections)
+        );
+
+        {
+            std::vector<std::byte> payload;
+            if(read_entry(filename, payload))
+            {
+                auto result = load_byte_code(std::span<const std::byte>(payload), m);
+                if(result)
+                    return {result.r, true};
+            }
+        }
+
+        for(const auto& s : sections)
+        {
+            int r = load_section(m, s);
+            if(r < 0)
+                return {r, false};
+        }
+        int r = m->Build();
+        if(r < 0)
+            return {r, false};
+
+        store(m, filename);
+        return {r, false};
+    }
+
+    /**
+     * @brief Compute the digest of application interface once and reuse it for the engine
+     *
+     * The pinned digest is only used for the same engine.
+     * Call `invalidate_interface()` after changing the registered interface of the engine,
+     * and before releasing the engine, because a new engine may reuse its address.
+     *
+     * @param engine Script engine. It cannot be nullptr.
+     */
+    void pin_interface(const AS_NAMESPACE_QUALIFIER asIScriptEngine* engine)
+    {
+        m_interface_digest = interface_digest(engine);
+        m_engine = engine;
+    }
+
+    /**
+     * @brief Discard the pinned digest of application interface
+     *
+     * The digest will be computed on every build until the next call of `pin_interface()`.
+     */
+    void invalidate_interface() noexcept
+    {
+        m_engine = nullptr;
+    }
+
+    /**
+     * @brief Remove all cached byte code in the directory
+     */
+    void clear()
+    {
+        std::error_code ec;
+        for(const auto& entry : std::filesystem::directory_iterator(m_dir, ec))
+        {
+            if(entry.path().extension() == ".asbc")
+                std::filesystem::remove(entry.path(), ec);
+        }
+    }
+
+private:
+    std::filesystem::path m_dir;
+    // Engine of the pinned digest
+    const AS_NAMESPACE_QUALIFIER asIScriptEngine* m_engine = nullptr;
+    std::uint64_t m_interface_digest = 0;
+    bool m_strip_debug_info;
+
+    std::uint64_t get_interface_digest(
+        const AS_NAMESPACE_QUALIFIER asIScriptEngine* engine
+    ) const
+    {
+        if(engine && m_engine == engine)
+            return m_interface_digest;
+        return interface_digest(engine);
+    }
+
+    // Header of cache files
+    struct entry_header
+    {
+        char magic[4];
+        std::uint32_t version;
+        std::uint64_t size;
+        std::uint64_t checksum;
+    };
+
+    static constexpr char entry_magic[4] = {'A', 'S', 'B', 'C'};
+    static constexpr std::uint32_t entry_version = 1;
+
+    static std::uint64_t checksum(std::span<const std::byte> payload) noexcept
+    {
+        asbind20::detail::fnv1a_64 h;
+        h.update(payload.data(), payload.size());
+        return h.value();
+    }
+
+    // Returns false if the file doesn't exist, or it is truncated or corrupted
+    static bool read_entry(
+        const std::filesystem::path& filename,
+        std::vector<std::byte>& payload
+    )
+    {
+        std::ifstream ifs(filename, std::ios_base::in | std::ios_base::binary);
+        if(!ifs.good())
+            return false;
+
+        entry_header header;
+        if(!ifs.read(reinterpret_cast<char*>(&header), sizeof(header)))
+            return false;
+        if(std::memcmp(header.magic, entry_magic, sizeof(entry_magic)) != 0 ||
+           header.version != entry_version)
+            return false;
+
+        std::error_code ec;
+        const auto file_size = std::filesystem::file_size(filename, ec);
+        if(ec || file_size != sizeof(header) + header.size)
+            return false;
+
+        payload.resize(static_cast<std::size_t>(header.size));
+        if(!ifs.read(reinterpret_cast<char*>(payload.data()), static_cast<std::streamsize>(payload.size())))
+            return false;
+
+        return checksum(payload) == header.checksum;
+    }
+
+    // Unique among threads and processes writing to the same directory
+    static std::filesystem::path temp_file(const std::filesystem::path& filename)
+    {
+        static std::atomic<std::uint64_t> counter = 0;
+
+        asbind20::detail::fnv1a_64 h;
+        h.update_value(std::random_device{}());
+        h.update_value(std::hash<std::thread::id>{}(std::this_thread::get_id()));
+        h.update_value(counter.fetch_add(1, std::memory_order_relaxed));
+
+        char buf[24];
+        std::snprintf(
+            buf,
+            sizeof(buf),
+            ".%016llx.tmp",
+            static_cast<unsigned long long>(h.value())
+        );
+        std::filesystem::path tmp = filename;
+        tmp += buf;
+        return tmp;
+    }
+
+    // Write to a temporary file first, so a concurrent reader never sees partial byte code.
+    void store(
+        AS_NAMESPACE_QUALIFIER asIScriptModule* m,
+        const std::filesystem::path& filename
+    ) const
+    {
+        std::vector<std::byte> payload;
+        if(save_byte_code(std::back_inserter(payload), m, m_strip_debug_info) < 0)
+            return;
+
+        entry_header header;
+        std::memcpy(header.magic, entry_magic, sizeof(entry_magic));
+        header.version = entry_version;
+        header.size = payload.size();
+        header.checksum = checksum(payload);
+
+        std::error_code ec;
+        std::filesystem::create_directories(m_dir, ec);
+
+        const std::filesystem::path tmp = temp_file(filename);
+        {
+            std::ofstream ofs(tmp, std::ios_base::out | std::ios_base::binary | std::ios_base::trunc);
+            if(!ofs.good())
+                return;
+            ofs.write(reinterpret_cast<const char*>(&header), sizeof(header));
+            ofs.write(reinterpret_cast<const char*>(payload.data()), static_cast<std::streamsize>(payload.size()));
+            ofs.close();
+            if(!ofs)
+            {
+                std::filesystem::remove(tmp, ec);
+                return;
+            }
+        }
+
+        std::filesystem::rename(tmp, filename, ec);
+        if(ec)
+            std::filesystem::remove(tmp, ec);
+    }
+};
+} // namespace asbind20::io
+
+#endif
@@ -0,0 +1,651 @@
+/**
+ * @file io/module_reloader.hpp
+ * @author HenryAWE
+ * @brief Hot reloading of script modules built from files
+ */
+
+#ifndef ASBIND20_IO_MODULE_RELOADER_HPP
+#define ASBIND20_IO_MODULE_RELOADER_HPP
+
+#pragma once
+
+#include <cstdint>
+#include <atomic>
+#include <chrono>
+#include <map>
+#include <memory>
+#include <mutex>
+#include <condition_variable>
+#include <span>
+#include <string>
+#include <string_view>
+#include <thread>
+#include <initializer_list>
+#include <vector>
+#include <filesystem>
+#include <system_error>
+#include "../detail/include_as.hpp"
+#include "../detail/hash.hpp"
+#include "../invoke.hpp"
+#include "section.hpp"
+
+#if defined(__linux__) && !defined(__EMSCRIPTEN__) && !defined(ASBIND20_NO_INOTIFY)
+#    define ASBIND20_HAS_INOTIFY
+#    include <sys/inotify.h>
+#    include <unistd.h>
+#endif
+
+namespace asbind20::io
+{
+namespace detail
+{
+    struct reloader_slot
+    {
+        std::atomic<AS_NAMESPACE_QUALIFIER asIScriptModule*> module = nullptr;
+        std::atomic<std::uint64_t> generation = 0;
+        std::atomic<int> last_result = AS_NAMESPACE_QUALIFIER asSUCCESS;
+    };
+
+    inline std::filesystem::path normalize_watched_path(const std::filesystem::path& p)
+    {
+        std::error_code ec;
+        auto result = std::filesystem::absolute(p, ec);
+        if(ec)
+            return p.lexically_normal();
+        return result.lexically_normal();
+    }
+
+#ifdef ASBIND20_HAS_INOTIFY
+
+    /**
+     * @brief Watches directories of tracked files by inotify
+     */
+    class inotify_watcher
+    {
+    public:
+        inotify_watcher() noexcept
+            : m_fd(::inotify_init1(IN_NONBLOCK | IN_CLOEXEC)) {}
+
+        inotify_watcher(const inotify_watcher&) = delete;
+
+        ~inotify_watcher()
+        {
+            if(m_fd >= 0)
+                ::close(m_fd);
+        }
+
+        inotify_watcher& operator=(const inotify_watcher&) = delete;
+
+        [[nodiscard]]
+        bool valid() const noexcept
+        {
+            return m_fd >= 0;
+        }
+
+        bool watch_directory(const std::filesystem::path& dir)
+        {
+            if(!valid()) [[unlikely]]
+                return false;
+
+            for(const auto& [wd, watched] : m_dirs)
+            {
+                if(watched == dir)
+                    return true;
+            }
+
+            int wd = ::inotify_add_watch(
+                m_fd,
+                dir.c_str(),
+                IN_CLOSE_WRITE | IN_MODIFY | IN_MOVED_TO | IN_CREATE | IN_ATTRIB
+            );
+            if(wd < 0)
+                return false;
+            m_dirs.emplace(wd, dir);
+            return true;
+        }
+
+        /**
+         * @brief Drain pending events
+         *
+         * @param out Paths of changed files
+         * @return False if some events are lost and all files need to be checked
+         */
+        bool read_events(std::vector<std::filesystem::path>& out)
+        {
+            bool complete = true;
+
+            alignas(::inotify_event) char buf[4096];
+            while(true)
+            {
+                ::ssize_t n = ::read(m_fd, buf, sizeof(buf));
+                if(n <= 0)
+                    break;
+
+                for(char* p = buf; p < buf + n;)
+                {
+                    const auto* ev = reinterpret_cast<const ::inotify_event*>(p);
+                    if(ev->mask & IN_Q_OVERFLOW)
+                        complete = false;
+                    else if(ev->len > 0)
+                    {
+                        auto it = m_dirs.find(ev->wd);
+                        if(it != m_dirs.end())
+                            out.push_back(it->second / ev->name);
+                    }
+                    p += sizeof(::inotify_event) + ev->len;
+                }
+            }
+
+            return complete;
+        }
+
+    private:
+        int m_fd;
+        std::map<int, std::filesystem::path> m_dirs;
+    };
+
+#endif
+} // namespace detail
+
+/**
+ * @brief Handle of a module managed by `module_reloader`
+ *
+ * The handle always refers to the latest successfully built module.
+ * It remains valid after the reloader is destroyed, but then it will no longer be updated.
+ */
+class module_handle
+{
+public:
+    module_handle() noexcept = default;
+
+    explicit module_handle(std::shared_ptr<const detail::reloader_slot> slot) noexcept
+        : m_slot(std::move(slot)) {}
+
+    /**
+     * @brief Get current module
+     *
+     * @warning Don't store the returned pointer across reloads.
+     *          The replaced module is only kept alive until the next reload of the same module.
+     */
+    [[nodiscard]]
+    AS_NAMESPACE_QUALIFIER asIScriptModule* get() const noexcept
+    {
+        if(!m_slot) [[unlikely]]
+            return nullptr;
+        return m_slot->module.load(std::memory_order_acquire);
+    }
+
+    AS_NAMESPACE_QUALIFIER asIScriptModule* operator->() const noexcept
+    {
+        return get();
+    }
+
+    /**
+     * @brief Counter increased on every successful reload
+     */
+    [[nodiscard]]
+    std::uint64_t generation() const noexcept
+    {
+        if(!m_slot) [[unlikely]]
+            return 0;
+        return m_slot->generation.load(std::memory_order_acquire);
+    }
+
+    /**
+     * @brief Result of the last build. The current module is not replaced if the build failed.
+     */
+    [[nodiscard]]
+    int last_result() const noexcept
+    {
+        if(!m_slot) [[unlikely]]
+            return AS_NAMESPACE_QUALIFIER asNO_MODULE;
+        return m_slot->last_result.load(std::memory_order_relaxed);
+    }
+
+    explicit operator bool() const noexcept
+    {
+        return get() != nullptr;
+    }
+
+private:
+    std::shared_ptr<const detail::reloader_slot> m_slot;
+};
+
+template <typename T>
+class reloadable_function;
+
+/**
+ * @brief Script function that follows the reloads of its module
+ *
+ * The function will be resolved again by its declaration when the module has been reloaded.
+ * The old function is kept alive by reference counting until it is resolved again.
+ */
+template <typename R, typename... Args>
+class reloadable_function<R(Args...)>
+{
+public:
+    using result_type = script_invoke_result<R>;
+
+    reloadable_function() = default;
+
+    reloadable_function(module_handle handle, std::string decl)
+        : m_handle(std::move(handle)), m_decl(std::move(decl)) {}
+
+    /**
+     * @brief Get the function of current module
+     */
+    [[nodiscard]]
+    const script_function<R(Args...)>& get()
+    {
+        std::uint64_t gen = m_handle.generation();
+        if(gen != m_generation || !m_func)
+        {
+            auto* m = m_handle.get();
+            if(m)
+                m_func.reset(m->GetFunctionByDecl(m_decl.c_str()));
+            else
+                m_func.reset();
+            m_generation = gen;
+        }
+
+        return m_func;
+    }
+
+    result_type operator()(
+        AS_NAMESPACE_QUALIFIER asIScriptContext* ctx, Args... args
+    )
+    {
+        return get()(ctx, std::forward<Args>(args)...);
+    }
+
+    [[nodiscard]]
+    const module_handle& handle() const noexcept
+    {
+        return m_handle;
+    }
+
+private:
+    module_handle m_handle;
+    std::string m_decl;
+    script_function<R(Args...)> m_func;
+    std::uint64_t m_generation = 0;
+};
+
+/**
+ * @brief Rebuilds modules when their source files are changed
+ *
+ * The reloader tracks which files belong to which module.
+ * Only the modules with changed files will be rebuilt.
+ * A module is rebuilt under a temporary name, and it only replaces the current one if the build succeeded.
+ *
+ * Changes are detected by the modification time and size of files, then confirmed by hashing the content.
+ * On Linux, inotify is used for avoiding checking every file on each poll.
+ * Define `ASBIND20_NO_INOTIFY` to always use the polling fallback.
+ *
+ * @note AngelScript doesn't allow building multiple modules of an engine at the same time.
+ *       If the background polling is enabled, don't build other modules of the engine in another thread.
+ */
+class module_reloader
+{
+public:
+    module_reloader() = delete;
+    module_reloader(const module_reloader&) = delete;
+
+    explicit module_reloader(AS_NAMESPACE_QUALIFIER asIScriptEngine* engine)
+        : m_engine(engine)
+    {
+        ASBIND20_ASSERT(engine != nullptr);
+    }
+
+    ~module_reloader()
+    {
+        stop();
+
+        for(auto& m : m_modules)
+        {
+            if(m.retired)
+                m.retired->Discard();
+        }
+    }
+
+    module_reloader& operator=(const module_reloader&) = delete;
+
+    /**
+     * @brief Build a module from files and start tracking them
+     *
+     * @param name Module name
+     * @param files Source files. Each file will be a script section.
+     * @return Result of building the module
+     */
+    int add_module(
+        const std::string& name,
+        std::span<const std::filesystem::path> files
+    )
+    {
+        std::lock_guard lock(m_mtx);
+
+        for(const auto& m : m_modules)
+        {
+            if(m.name == name)
+                return AS_NAMESPACE_QUALIFIER asALREADY_REGISTERED;
+        }
+
+        module_entry entry;
+        entry.name = name;
+        entry.slot = std::make_shared<detail::reloader_slot>();
+        for(const auto& f : files)
+        {
+            std::size_t idx = 0;
+            int r = track_file(f, idx);
+            if(r < 0)
+                return r;
+            entry.files.push_back(idx);
+        }
+
+        m_modules.push_back(std::move(entry));
+        const std::size_t module_idx = m_modules.size() - 1;
+        for(std::size_t idx : m_modules.back().files)
+            m_files[idx].modules.push_back(module_idx);
+
+        return rebuild(m_modules.back());
+    }
+
+    int add_module(
+        const std::string& name,
+        std::initializer_list<std::filesystem::path> files
+    )
+    {
+        return add_module(name, std::span(files.begin(), files.size()));
+    }
+
+    /**
+     * @brief Get the handle of a tracked module
+     */
+    [[nodiscard]]
+    module_handle get_handle(std::string_view name) const
+    {
+        std::lock_guard lock(m_mtx);
+
+        for(const auto& m : m_modules)
+        {
+            if(m.name == name)
+                return module_handle(m.slot);
+        }
+
+        return module_handle();
+    }
+
+    /**
+     * @brief Check tracked files and rebuild modules whose files are changed
+     *
+     * @return Count of successfully reloaded modules
+     */
+    std::size_t poll()
+    {
+        std::lock_guard lock(m_mtx);
+
+        std::vector<bool> dirty(m_modules.size(), false);
+        for(std::size_t idx : changed_files())
+        {
+            for(std::size_t module_idx : m_files[idx].modules)
+                dirty[module_idx] = true;
+        }
+
+        std::size_t count = 0;
+        for(std::size_t i = 0; i < m_modules.size(); ++i)
+        {
+            if(dirty[i] && rebuild(m_modules[i]) >= 0)
+                ++count;
+        }
+
+        return count;
+    }
+
+    /**
+     * @brief Start polling in a background thread
+     *
+     * @param interval Interval between polls
+     */
+    void start(std::chrono::milliseconds interval = std::chrono::milliseconds(500))
+    {
+        stop();
+
+        m_stop_requested = false;
+        m_worker = std::thread(
+            [this, interval]()
+            {
+                std::unique_lock lock(m_worker_mtx);
+                while(!m_stop_requested)
+                {
+                    lock.unlock();
+                    poll();
+                    lock.lock();
+                    m_worker_cv.wait_for(
+                        lock, interval, [this]()
+                        { return m_stop_requested; }
+                    );
+                }
+
+                lock.unlock();
+                AS_NAMESPACE_QUALIFIER asThreadCleanup();
+            }
+        );
+    }
+
+    /**
+     * @brief Stop the background polling
+     */
+    void stop()
+    {
+        if(!m_worker.joinable())
+            return;
+
+        {
+            std::lock_guard lock(m_worker_mtx);
+            m_stop_requested = true;
+        }
+        m_worker_cv.notify_all();
+        m_worker.join();
+    }
+
+    [[nodiscard]]
+    bool running() const noexcept
+    {
+        return m_worker.joinable();
+    }
+
+    [[nodiscard]]
+    AS_NAMESPACE_QUALIFIER asIScriptEngine* get_engine() const noexcept
+    {
+        return m_engine;
+    }
+
+private:
+    struct file_entry
+    {
+        std::filesystem::path path;
+        std::filesystem::file_time_type mtime;
+        std::uintmax_t size = 0;
+        std::uint64_t hash = 0;
+        script_section section;
+        std::vector<std::size_t> modules;
+    };
+
+    struct module_entry
+    {
+        std::string name;
+        std::vector<std::size_t> files;
+        std::shared_ptr<detail::reloader_slot> slot;
+        AS_NAMESPACE_QUALIFIER asIScriptModule* retired = nullptr;
+    };
+
+    AS_NAMESPACE_QUALIFIER asIScriptEngine* m_engine;
+    mutable std::mutex m_mtx;
+    std::vector<file_entry> m_files;
+    std::vector<module_entry> m_modules;
+#ifdef ASBIND20_HAS_INOTIFY
+    detail::inotify_watcher m_watcher;
+#endif
+
+    std::thread m_worker;
+    std::mutex m_worker_mtx;
+    std::condition_variable m_worker_cv;
+    bool m_stop_requested = false;
+
+    static std::uint64_t hash_content(std::string_view code) noexcept
+    {
+        return asbind20::detail::fnv1a_64().update(code).value();
+    }
+
+    int track_file(const std::filesystem::path& filename, std::size_t& out_idx)
+    {
+        auto key = detail::normalize_watched_path(filename);
+        for(std::size_t i = 0; i < m_files.size(); ++i)
+        {
+            if(m_files[i].path == key)
+            {
+                out_idx = i;
+                return AS_NAMESPACE_QUALIFIER asSUCCESS;
+            }
+        }
+
+        file_entry entry;
+        entry.path = key;
+        int r = read_file(entry.section, filename);
+        if(r < 0)
+            return r;
+        entry.hash = hash_content(entry.section.code);
+
+        std::error_code ec;
+        entry.mtime = std::filesystem::last_write_time(key, ec);
+        entry.size = std::filesystem::file_size(key, ec);
+
+#ifdef ASBIND20_HAS_INOTIFY
+        m_watcher.watch_directory(key.parent_path());
+#endif
+
+        m_files.push_back(std::move(entry));
+        out_idx = m_files.size() - 1;
+        return AS_NAMESPACE_QUALIFIER asSUCCESS;
+    }
+
+    // Returns true if the content of file is actually changed
+    bool refresh_file(file_entry& f)
+    {
+        std::error_code ec;
+        auto mtime = std::filesystem::last_write_time(f.path, ec);
+        if(ec)
+            return false; // Removed or being replaced, keep the old content
+        auto size = std::filesystem::file_size(f.path, ec);
+        if(ec)
+            return false;
+        if(mtime == f.mtime && size == f.size)
+            return false;
+
+        f.mtime = mtime;
+        f.size = size;
+
+        script_section section;
+        if(read_file(section, f.path) < 0)
+            return false;
+        std::uint64_t h = hash_content(section.code);
+        if(h == f.hash)
+            return false;
+
+        f.hash = h;
+        f.section.code = std::move(section.code);
+        return true;
+    }
+
+    std::vector<std::size_t> changed_files()
+    {
+        std::vector<std::size_t> result;
+
+#ifdef ASBIND20_HAS_INOTIFY
+        if(m_watcher.valid())
+        {
+            std::vector<std::filesystem::path> events;
+            if(m_watcher.read_events(events))
+            {
+                for(std::size_t i = 0; i < m_files.size(); ++i)
+                {
+                    bool touched = false;
+                    for(const auto& p : events)
+                    {
+                        if(p == m_files[i].path)
+                        {
+                            touched = true;
+                            break;
+                        }
+                    }
+
+                    if(touched && refresh_file(m_files[i]))
+                        result.push_back(i);
+                }
+
+                return result;
+            }
+        }
+#endif
+
+        for(std::size_t i = 0; i < m_files.size(); ++i)
+        {
+            if(refresh_file(m_files[i]))
+                result.push_back(i);
+        }
+
+        return result;
+    }
+
+    int rebuild(module_entry& entry)
+    {
+        auto& slot = *entry.slot;
+
+        // Build under a temporary name, so the current module is untouched if the build failed
+        std::string tmp_name = entry.name + "$reloading";
+        auto* m = m_engine->GetModule(
+            tmp_name.c_str(), AS_NAMESPACE_QUALIFIER asGM_ALWAYS_CREATE
+        );
+        if(!m) [[unlikely]]
+        {
+            slot.last_result.store(AS_NAMESPACE_QUALIFIER asERROR, std::memory_order_relaxed);
+            return AS_NAMESPACE_QUALIFIER asERROR;
+        }
+
+        int r = AS_NAMESPACE_QUALIFIER asSUCCESS;
+        for(std::size_t idx : entry.files)
+        {
+            r = load_section(m, m_files[idx].section);
+            if(r < 0)
+                break;
+        }
+        if(r >= 0)
+            r = m->Build();
+
+        slot.last_result.store(r, std::memory_order_relaxed);
+        if(r < 0)
+        {
+            m->Discard();
+            return r;
+        }
+
+        auto* old = slot.module.load(std::memory_order_relaxed);
+        if(entry.retired)
+            entry.retired->Discard();
+        if(old)
+        {
+            std::string retired_name = entry.name + "$retired";
+            old->SetName(retired_name.c_str());
+        }
+        entry.retired = old;
+        m->SetName(entry.name.c_str());
+
+        slot.module.store(m, std::memory_order_release);
+        slot.generation.fetch_add(1, std::memory_order_acq_rel);
+
+        return r;
+    }
+};
+} // namespace asbind20::io
+
+#endif
@@ -9,6 +9,7 @@
 
 #pragma once
 
+#include <string>
 #include <string_view>
 #include <filesystem>
 #include <fstream>
@@ -41,38 +42,91 @@ inline int load_string(
 }
 
 /**
- * @brief Load a file as script section
+ * @brief Source code of a script section
+ */
+struct script_section
+{
+    /// Section name
+    std::string name;
+    /// Source code
+    std::string code;
+    /// Line offset of the section
+    int line_offset = 0;
+};
+
+/**
+ * @brief Read a file into a script section without adding it to any module
+ *
+ * The section name will be the UTF-8 encoded path of the file.
  *
  * @return AngelScript error code
  */
-inline int load_file(
-    AS_NAMESPACE_QUALIFIER asIScriptModule* m,
+inline int read_file(
+    script_section& out,
     const std::filesystem::path& filename,
     std::ios_base::openmode mode = std::ios_base::in
 )
 {
-    if(!m) [[unlikely]]
-        return AS_NAMESPACE_QUALIFIER asINVALID_ARG;
-
-    std::string code;
     {
         std::ifstream ifs(filename, std::ios_base::in | mode);
         if(!ifs.good())
             return AS_NAMESPACE_QUALIFIER asERROR;
         std::stringstream ss;
         ss << ifs.rdbuf();
-        code = std::move(ss).str();
+        out.code = std::move(ss).str();
     }
 
     // Force UTF-8 encoding
     // This can prevent some issues on Windows
     auto section_name = filename.u8string();
+    out.name.assign(
+        reinterpret_cast<const char*>(section_name.data()),
+        section_name.size()
+    );
+    out.line_offset = 0;
+
+    return AS_NAMESPACE_QUALIFIER asSUCCESS;
+}
+
+/**
+ * @brief Load a script section
+ *
+ * @return AngelScript error code
+ */
+inline int load_section(
+    AS_NAMESPACE_QUALIFIER asIScriptModule* m,
+    const script_section& section
+)
+{
     return load_string(
         m,
-        reinterpret_cast<const char*>(section_name.c_str()),
-        code
+        section.name.c_str(),
+        section.code,
+        section.line_offset
     );
 }
+
+/**
+ * @brief Load a file as script section
+ *
+ * @return AngelScript error code
+ */
+inline int load_file(
+    AS_NAMESPACE_QUALIFIER asIScriptModule* m,
+    const std::filesystem::path& filename,
+    std::ios_base::openmode mode = std::ios_base::in
+)
+{
+    if(!m) [[unlikely]]
+        return AS_NAMESPACE_QUALIFIER asINVALID_ARG;
+
+    script_section section;
+    int r = read_file(section, filename, mode);
+    if(r < 0)
+        return r;
+
+    return load_section(m, section);
+}
 } // namespace asbind20::io
 
 #endif
@@ -12,7 +12,9 @@
 #include "../detail/include_as.hpp"
 #include <cassert>
 #include <cstring>
+#include <cstddef>
 #include <algorithm>
+#include <span>
 #include <iostream>
 
 namespace asbind20
@@ -96,6 +98,195 @@ namespace io
         std::istream* m_is;
     };
 
+    /**
+     * @brief Buffered wrapper for `std::ostream`
+     *
+     * The engine writes byte code in many tiny pieces.
+     * This wrapper collects them into a fixed internal buffer and forwards them to the stream in larger chunks.
+     *
+     * @note The buffer is flushed on destruction. Call `flush()` explicitly for checking the result.
+     *
+     * @tparam BufferSize Size of internal buffer
+     */
+    template <std::size_t BufferSize = 4096>
+    class buffered_ostream_wrapper final : public AS_NAMESPACE_QUALIFIER asIBinaryStream
+    {
+    public:
+        static_assert(BufferSize > 0);
+
+        buffered_ostream_wrapper() = delete;
+        buffered_ostream_wrapper(const buffered_ostream_wrapper&) = delete;
+
+        explicit buffered_ostream_wrapper(std::ostream& stream) noexcept
+            : m_os(&stream) {}
+
+        ~buffered_ostream_wrapper()
+        {
+            flush();
+        }
+
+        buffered_ostream_wrapper& operator=(const buffered_ostream_wrapper&) = delete;
+
+        int Read(void* ptr, AS_NAMESPACE_QUALIFIER asUINT size) override
+        {
+            (void)ptr;
+            (void)size;
+            return AS_NAMESPACE_QUALIFIER asERROR;
+        }
+
+        int Write(const void* ptr, AS_NAMESPACE_QUALIFIER asUINT size) override
+        {
+            if(size <= BufferSize - m_size) [[likely]]
+            {
+                std::memcpy(m_buf + m_size, ptr, size);
+                m_size += size;
+                return AS_NAMESPACE_QUALIFIER asSUCCESS;
+            }
+
+            int r = flush();
+            if(r < 0) [[unlikely]]
+                return r;
+
+            if(size >= BufferSize)
+            {
+                m_os->write(static_cast<const char*>(ptr), size);
+                return m_os->good() ?
+                           AS_NAMESPACE_QUALIFIER asSUCCESS :
+                           AS_NAMESPACE_QUALIFIER asERROR;
+            }
+
+            std::memcpy(m_buf, ptr, size);
+            m_size = size;
+            return AS_NAMESPACE_QUALIFIER asSUCCESS;
+        }
+
+        /**
+         * @brief Write buffered content to the stream
+         *
+         * @return AngelScript error code
+         */
+        int flush()
+        {
+            if(m_size == 0)
+                return AS_NAMESPACE_QUALIFIER asSUCCESS;
+
+            m_os->write(m_buf, static_cast<std::streamsize>(m_size));
+            m_size = 0;
+            if(m_os->good())
+                return AS_NAMESPACE_QUALIFIER asSUCCESS;
+            else
+                return AS_NAMESPACE_QUALIFIER asERROR;
+        }
+
+        [[nodiscard]]
+        std::ostream& get() const noexcept
+        {
+            return *m_os;
+        }
+
+    private:
+        std::ostream* m_os;
+        std::size_t m_size = 0;
+        char m_buf[BufferSize];
+    };
+
+    /**
+     * @brief Buffered wrapper for `std::istream`
+     *
+     * @warning This wrapper may read ahead of the content consumed by the engine.
+     *          Call `sync()` to seek the stream back to the actual position if it is needed.
+     *
+     * @tparam BufferSize Size of internal buffer
+     */
+    template <std::size_t BufferSize = 4096>
+    class buffered_istream_wrapper final : public AS_NAMESPACE_QUALIFIER asIBinaryStream
+    {
+    public:
+        static_assert(BufferSize > 0);
+
+        buffered_istream_wrapper() = delete;
+        buffered_istream_wrapper(const buffered_istream_wrapper&) = delete;
+
+        explicit buffered_istream_wrapper(std::istream& stream) noexcept
+            : m_is(&stream) {}
+
+        buffered_istream_wrapper& operator=(const buffered_istream_wrapper&) = delete;
+
+        int Read(void* ptr, AS_NAMESPACE_QUALIFIER asUINT size) override
+        {
+            char* dst = static_cast<char*>(ptr);
+
+            std::size_t avail = m_size - m_pos;
+            if(size <= avail) [[likely]]
+            {
+                std::memcpy(dst, m_buf + m_pos, size);
+                m_pos += size;
+                return AS_NAMESPACE_QUALIFIER asSUCCESS;
+            }
+
+            std::memcpy(dst, m_buf + m_pos, avail);
+            dst += avail;
+            std::size_t remaining = size - avail;
+            m_pos = m_size = 0;
+
+            if(remaining >= BufferSize)
+            {
+                m_is->read(dst, static_cast<std::streamsize>(remaining));
+                return m_is->good() ?
+                           AS_NAMESPACE_QUALIFIER asSUCCESS :
+                           AS_NAMESPACE_QUALIFIER asERROR;
+            }
+
+            m_is->read(m_buf, BufferSize);
+            m_size = static_cast<std::size_t>(m_is->gcount());
+            if(m_size < remaining)
+                return AS_NAMESPACE_QUALIFIER asERROR;
+
+            std::memcpy(dst, m_buf, remaining);
+            m_pos = remaining;
+            return AS_NAMESPACE_QUALIFIER asSUCCESS;
+        }
+
+        int Write(const void* ptr, AS_NAMESPACE_QUALIFIER asUINT size) override
+        {
+            (void)ptr;
+            (void)size;
+            return AS_NAMESPACE_QUALIFIER asERROR;
+        }
+
+        /**
+         * @brief Seek the stream back to the position of the last byte consumed by the engine
+         *
+         * @return AngelScript error code
+         */
+        int sync()
+        {
+            std::size_t avail = m_size - m_pos;
+            m_pos = m_size = 0;
+            if(avail == 0)
+                return AS_NAMESPACE_QUALIFIER asSUCCESS;
+
+            m_is->clear();
+            m_is->seekg(-static_cast<std::streamoff>(avail), std::ios_base::cur);
+            if(m_is->good())
+                return AS_NAMESPACE_QUALIFIER asSUCCESS;
+            else
+                return AS_NAMESPACE_QUALIFIER asERROR;
+        }
+
+        [[nodiscard]]
+        std::istream& get() const noexcept
+        {
+            return *m_is;
+        }
+
+    private:
+        std::istream* m_is;
+        std::size_t m_pos = 0;
+        std::size_t m_size = 0;
+        char m_buf[BufferSize];
+    };
+
     /**
      * @brief Copy content from binary stream to an output interator
      *
@@ -224,8 +415,11 @@ inline int save_byte_code(
 {
     if(!m) [[unlikely]]
         return AS_NAMESPACE_QUALIFIER asINVALID_ARG;
-    io::ostream_wrapper wrapper(os);
-    return m->SaveByteCode(&wrapper, strip_debug_info);
+    io::buffered_ostream_wrapper wrapper(os);
+    int r = m->SaveByteCode(&wrapper, strip_debug_info);
+    if(r < 0)
+        return r;
+    return wrapper.flush();
 }
 
 /**
@@ -0,0 +1,404 @@
+/**
+ * @file io/strip.hpp
+ * @author HenryAWE
+ * @brief Saving byte code without unreachable functions and variables
+ */
+
+#ifndef ASBIND20_IO_STRIP_HPP
+#define ASBIND20_IO_STRIP_HPP
+
+#pragma once
+
+#include <cstddef>
+#include <ostream>
+#include <string>
+#include <vector>
+#include <unordered_set>
+#include <iterator>
+#include "../detail/include_as.hpp"
+#include "../detail/byte_code.hpp"
+#include "stream.hpp"
+
+namespace asbind20
+{
+namespace io
+{
+    /**
+     * @brief Options of stripping byte code
+     */
+    struct strip_options
+    {
+        /**
+         * @brief Declarations of functions called by the application
+         */
+        std::vector<std::string> entry_points;
+
+        /**
+         * @brief Declarations of functions used by other modules, e.g., by importing
+         */
+        std::vector<std::string> exports;
+
+        bool strip_debug_info = false;
+
+        /**
+         * @brief Remove unreferenced global variables of primitive and enum types
+         *
+         * Only variables with constant initializers (or without initializers) are removable.
+         * A variable initialized by an expression, e.g. `int x = init();`, is written by its initializer function,
+         * which is always kept, so the variable and the side effects of its initializer are kept.
+         *
+         * @note Global variables of object types are always kept,
+         *       because their initialization and destruction may have side effects.
+         */
+        bool strip_variables = true;
+    };
+
+    /**
+     * @brief Result of saving stripped byte code
+     */
+    struct strip_result
+    {
+        int r = AS_NAMESPACE_QUALIFIER asSUCCESS;
+
+        /// Size of byte code saved without stripping
+        std::size_t original_size = 0;
+        /// Size of the saved byte code
+        std::size_t stripped_size = 0;
+
+        std::size_t removed_functions = 0;
+        std::size_t removed_variables = 0;
+
+        /**
+         * @brief True if the stripped byte code failed to load, and the original one was saved instead
+         */
+        bool fallback = false;
+
+        explicit operator bool() const noexcept
+        {
+            return r >= 0;
+        }
+
+        [[nodiscard]]
+        std::size_t saved_bytes() const noexcept
+        {
+            return original_size - stripped_size;
+        }
+    };
+
+    namespace detail
+    {
+        class byte_code_stripper
+        {
+        public:
+            /**
+             * @param m Module for stripping
+             * @param name Name of the original module, for finding functions imported by other modules
+             */
+            byte_code_stripper(AS_NAMESPACE_QUALIFIER asIScriptModule* m, std::string name)
+                : m_module(m), m_engine(m->GetEngine()), m_name(std::move(name)) {}
+
+            int mark_roots(const strip_options& opts)
+            {
+                for(const auto* decls : {&opts.entry_points, &opts.exports})
+                {
+                    for(const auto& decl : *decls)
+                    {
+                        auto* f = m_module->GetFunctionByDecl(decl.c_str());
+                        if(!f)
+                            return AS_NAMESPACE_QUALIFIER asNO_FUNCTION;
+                        mark(f);
+                    }
+                }
+
+                std::unordered_set<AS_NAMESPACE_QUALIFIER asIScriptFunction*> globals;
+                for(AS_NAMESPACE_QUALIFIER asUINT i = 0; i < m_module->GetFunctionCount(); ++i)
+                    globals.insert(m_module->GetFunctionByIndex(i));
+
+                // Methods of script classes, initializers of global variables, etc.
+                // are not removable, so they are always reachable.
+                // Because initializers are reachable, the variables written by them are always kept.
+                const int last_id = m_engine->GetLastFunctionId();
+                for(int id = 0; id <= last_id; ++id)
+                {
+                    auto* f = m_engine->GetFunctionById(id);
+                    if(!f || f->GetModule() != m_module)
+                        continue;
+                    if(!globals.contains(f))
+                        mark(f);
+                }
+
+                mark_imported_by_others();
+
+                return AS_NAMESPACE_QUALIFIER asSUCCESS;
+            }
+
+            void propagate()
+            {
+                while(!m_worklist.empty())
+                {
+                    auto* f = m_worklist.back();
+                    m_worklist.pop_back();
+
+                    asbind20::detail::for_each_instruction(
+                        asbind20::detail::get_byte_code(f),
+                        [this](const AS_NAMESPACE_QUALIFIER asDWORD* instr, std::size_t)
+                        {
+                            // Functions called by asBC_CALLBND are bound from other modules,
+                            // and the argument is not a function ID, so there is nothing to mark
+                            if(asbind20::detail::bc_op(instr) == AS_NAMESPACE_QUALIFIER asBC_CALLBND)
+                                return;
+
+                            if(auto* callee = asbind20::detail::bc_referenced_function(m_engine, instr))
+                                mark(callee);
+                            else if(void* addr = asbind20::detail::bc_referenced_global(instr))
+                                m_used_globals.insert(addr);
+                        }
+                    );
+                }
+            }
+
+            std::size_t remove_functions()
+            {
+                std::vector<AS_NAMESPACE_QUALIFIER asIScriptFunction*> unreachable;
+                for(AS_NAMESPACE_QUALIFIER asUINT i = 0; i < m_module->GetFunctionCount(); ++i)
+                {
+                    auto* f = m_module->GetFunctionByIndex(i);
+                    if(!m_reachable.contains(f))
+                        unreachable.push_back(f);
+                }
+
+                for(auto* f : unreachable)
+                    m_module->RemoveFunction(f);
+                return unreachable.size();
+            }
+
+            std::size_t remove_variables()
+            {
+                std::size_t count = 0;
+                for(AS_NAMESPACE_QUALIFIER asUINT i = m_module->GetGlobalVarCount(); i-- > 0;)
+                {
+                    int type_id = 0;
+                    m_module->GetGlobalVar(i, nullptr, nullptr, &type_id);
+                    if(type_id & (AS_NAMESPACE_QUALIFIER asTYPEID_MASK_OBJECT | AS_NAMESPACE_QUALIFIER asTYPEID_OBJHANDLE))
+                        continue;
+                    if(m_used_globals.contains(m_module->GetAddressOfGlobalVar(i)))
+                        continue;
+
+                    if(m_module->RemoveGlobalVar(i) >= 0)
+                        ++count;
+                }
+
+                return count;
+            }
+
+        private:
+            AS_NAMESPACE_QUALIFIER asIScriptModule* m_module;
+            AS_NAMESPACE_QUALIFIER asIScriptEngine* m_engine;
+            std::unordered_set<AS_NAMESPACE_QUALIFIER asIScriptFunction*> m_reachable;
+            std::unordered_set<void*> m_used_globals;
+            std::vector<AS_NAMESPACE_QUALIFIER asIScriptFunction*> m_worklist;
+            std::string m_name;
+
+            void mark(AS_NAMESPACE_QUALIFIER asIScriptFunction* f)
+            {
+                if(f->GetFuncType() != AS_NAMESPACE_QUALIFIER asFUNC_SCRIPT)
+                    return;
+                if(m_reachable.insert(f).second)
+                    m_worklist.push_back(f);
+            }
+
+            // Functions imported by other modules of the engine are called through asBC_CALLBND there,
+            // so they are kept like the exports.
+            void mark_imported_by_others()
+            {
+                const AS_NAMESPACE_QUALIFIER asUINT module_count = m_engine->GetModuleCount();
+                for(AS_NAMESPACE_QUALIFIER asUINT i = 0; i < module_count; ++i)
+                {
+                    auto* other = m_engine->GetModuleByIndex(i);
+                    if(!other || other == m_module)
+                        continue;
+
+                    const AS_NAMESPACE_QUALIFIER asUINT import_count = other->GetImportedFunctionCount();
+                    for(AS_NAMESPACE_QUALIFIER asUINT j = 0; j < import_count; ++j)
+                    {
+                        const char* source = other->GetImportedFunctionSourceModule(j);
+                        if(!source || m_name != source)
+                            continue;
+
+                        const char* decl = other->GetImportedFunctionDeclaration(j);
+                        if(!decl)
+                            continue;
+                        if(auto* f = m_module->GetFunctionByDecl(decl))
+                            mark(f);
+                    }
+                }
+            }
+        };
+
+        // Restores the engine property on destruction
+        class scoped_engine_property
+        {
+        public:
+            scoped_engine_property(
+                AS_NAMESPACE_QUALIFIER asIScriptEngine* engine,
+                AS_NAMESPACE_QUALIFIER asEEngineProp prop,
+                AS_NAMESPACE_QUALIFIER asPWORD val
+            )
+                : m_engine(engine), m_prop(prop), m_old(engine->GetEngineProperty(prop))
+            {
+                m_engine->SetEngineProperty(m_prop, val);
+            }
+
+            scoped_engine_property(const scoped_engine_property&) = delete;
+
+            ~scoped_engine_property()
+            {
+                m_engine->SetEngineProperty(m_prop, m_old);
+            }
+
+        private:
+            AS_NAMESPACE_QUALIFIER asIScriptEngine* m_engine;
+            AS_NAMESPACE_QUALIFIER asEEngineProp m_prop;
+            AS_NAMESPACE_QUALIFIER asPWORD m_old;
+        };
+
+        // Discards the module on destruction
+        class scratch_module
+        {
+        public:
+            scratch_module(AS_NAMESPACE_QUALIFIER asIScriptEngine* engine, const std::string& name)
+                : m_module(engine->GetModule(name.c_str(), AS_NAMESPACE_QUALIFIER asGM_ALWAYS_CREATE)) {}
+
+            scratch_module(const scratch_module&) = delete;
+
+            ~scratch_module()
+            {
+                if(m_module)
+                    m_module->Discard();
+            }
+
+            AS_NAMESPACE_QUALIFIER asIScriptModule* get() const noexcept
+            {
+                return m_module;
+            }
+
+        private:
+            AS_NAMESPACE_QUALIFIER asIScriptModule* m_module;
+        };
+    } // namespace detail
+} // namespace io
+
+/**
+ * @addtogroup ByteCode
+ */
+/// @{
+
+/**
+ * @brief Save byte code without functions and variables unreachable from the entry points
+ *
+ * The module itself is not modified. It is copied into a temporary module for stripping.
+ * The stripped byte code is verified by loading it into another temporary module.
+ * If the verification failed, the original byte code will be saved instead.
+ *
+ * Global variables are not initialized when loading the temporary modules,
+ * so their initializers won't be executed during stripping.
+ *
+ * @param out Output buffer. The byte code will be appended to it.
+ * @param m Script module
+ * @param opts Options
+ */
+inline io::strip_result save_byte_code_stripped(
+    std::vector<std::byte>& out,
+    AS_NAMESPACE_QUALIFIER asIScriptModule* m,
+    const io::strip_options& opts
+)
+{
+    io::strip_result result;
+    if(!m) [[unlikely]]
+    {
+        result.r = AS_NAMESPACE_QUALIFIER asINVALID_ARG;
+        return result;
+    }
+
+    std::vector<std::byte> original;
+    result.r = save_byte_code(std::back_inserter(original), m, opts.strip_debug_info);
+    if(result.r < 0)
+        return result;
+    result.original_size = original.size();
+
+    auto* engine = m->GetEngine();
+    io::detail::scoped_engine_property no_init(
+        engine, AS_NAMESPACE_QUALIFIER asEP_INIT_GLOBAL_VARS_AFTER_BUILD, false
+    );
+
+    std::vector<std::byte> stripped;
+    {
+        io::detail::scratch_module scratch(engine, std::string(m->GetName()) + "$strip");
+        result.r = load_byte_code(original, scratch.get()).r;
+        if(result.r < 0)
+            return result;
+
+        io::detail::byte_code_stripper stripper(scratch.get(), m->GetName());
+        result.r = stripper.mark_roots(opts);
+        if(result.r < 0)
+            return result;
+        stripper.propagate();
+
+        result.removed_functions = stripper.remove_functions();
+        if(opts.strip_variables)
+            result.removed_variables = stripper.remove_variables();
+
+        result.r = save_byte_code(std::back_inserter(stripped), scratch.get(), opts.strip_debug_info);
+        if(result.r < 0)
+            return result;
+    }
+
+    bool verified = false;
+    {
+        io::detail::scratch_module verify(engine, std::string(m->GetName()) + "$strip_verify");
+        verified = load_byte_code(stripped, verify.get()).r >= 0;
+    }
+
+    if(!verified)
+    {
+        result.fallback = true;
+        result.removed_functions = 0;
+        result.removed_variables = 0;
+        stripped = std::move(original);
+    }
+
+    result.stripped_size = stripped.size();
+    out.insert(out.end(), stripped.begin(), stripped.end());
+
+    return result;
+}
+
+/**
+ * @brief Save byte code without functions and variables unreachable from the entry points
+ *
+ * @param os Output stream
+ * @param m Script module
+ * @param opts Options
+ */
+inline io::strip_result save_byte_code_stripped(
+    std::ostream& os,
+    AS_NAMESPACE_QUALIFIER asIScriptModule* m,
+    const io::strip_options& opts
+)
+{
+    std::vector<std::byte> buf;
+    io::strip_result result = save_byte_code_stripped(buf, m, opts);
+    if(!result)
+        return result;
+
+    os.write(reinterpret_cast<const char*>(buf.data()), static_cast<std::streamsize>(buf.size()));
+    if(!os)
+        result.r = AS_NAMESPACE_QUALIFIER asERROR;
+
+    return result;
+}
+
+/// @}
+} // namespace asbind20
+
+#endif
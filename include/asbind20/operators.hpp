@@ -98,6 +98,51 @@ namespace detail
             return format_full_typename<T>(gen.get_name());
     }
 
+    /**
+     * @brief Declaration known at compile time
+     *
+     * @tparam Decl Content of the declaration
+     */
+    template <util::fixed_string Decl>
+    struct static_decl_t
+    {
+        static constexpr auto value = Decl;
+
+        constexpr operator std::string_view() const noexcept
+        {
+            return value;
+        }
+    };
+
+    template <typename T>
+    constexpr inline bool is_static_decl_v = false;
+
+    template <util::fixed_string Decl>
+    constexpr inline bool is_static_decl_v<static_decl_t<Decl>> = true;
+
+    // Return type whose declaration can be generated at compile time
+    template <typename T, typename ClassType>
+    concept static_return_type =
+        !std::same_as<std::remove_cvref_t<T>, ClassType> &&
+        has_static_name<std::remove_cvref_t<T>>;
+
+    template <typename T>
+    requires(has_static_name<std::remove_cvref_t<T>>)
+    consteval auto fixed_return_decl()
+    {
+        using util::fixed_string;
+        constexpr bool is_const = std::is_const_v<std::remove_reference_t<T>>;
+        constexpr bool is_ref = std::is_reference_v<T>;
+        constexpr auto name = name_of<std::remove_cvref_t<T>>();
+
+        if constexpr(is_const && is_ref)
+            return fixed_string("const ") + name + fixed_string("&");
+        else if constexpr(is_ref)
+            return name + fixed_string("&");
+        else
+            return name;
+    }
+
     // Declaration generation helpers (consolidated from old base classes)
 
     // Binary operators: generate full declaration from plain type name
@@ -164,49 +209,81 @@ namespace detail
         return string_concat(ret_decl, ' ', op_name, is_const ? "()const" : "()");
     }
 
-    // Dispatch between auto-decl and user-decl for binary operators
-    template <bool AutoDecl, typename T>
-    constexpr std::string gen_binary_param_decl(
-        std::string_view ret_decl,
-        std::string_view op_name,
-        std::string_view param_decl_or_name,
-        bool is_const
+    template <util::fixed_string Decl, bool IsConst>
+    consteval auto fixed_const_suffix()
+    {
+        if constexpr(IsConst)
+            return Decl + util::fixed_string("const");
+        else
+            return Decl;
+    }
+
+    /**
+     * @brief Generate declaration of binary operators with a parameter
+     *
+     * The declaration is generated at compile time if both of the return type and the parameter type
+     * have static names, so the registration won't allocate memory for it.
+     */
+    template <util::fixed_string OpName, bool IsConst, typename Param, bool AutoDecl, typename RetDecl>
+    constexpr auto gen_binary_param_decl(
+        const RetDecl& ret_decl,
+        const param_placeholder<Param, AutoDecl>& param
     )
     {
-        if constexpr(AutoDecl)
+        if constexpr(AutoDecl && is_static_decl_v<RetDecl>)
         {
-            constexpr bool param_ref = std::is_reference_v<T>;
-            constexpr bool param_const = std::is_const_v<std::remove_reference_t<T>>;
-            return gen_binary_auto_decl<param_ref, param_const>(
-                ret_decl, op_name, param_decl_or_name, is_const
-            );
+            using util::fixed_string;
+            return fixed_const_suffix<
+                RetDecl::value + fixed_string(" ") + OpName +
+                    fixed_string("(") + meta::full_fixed_name_of<Param>() + fixed_string(")"),
+                IsConst>();
         }
         else
         {
-            return gen_binary_user_decl(ret_decl, op_name, param_decl_or_name, is_const);
+            // The declaration of parameter is already complete
+            return gen_binary_user_decl(ret_decl, OpName, param.get_decl(), IsConst);
         }
     }
 
-    // Dispatch between auto-decl and user-decl for index operators
-    template <bool AutoDecl, typename T>
-    constexpr std::string gen_index_param_decl(
-        std::string_view ret_decl,
-        std::string_view param_decl_or_name,
-        bool is_const
+    /**
+     * @brief Generate declaration of index operators with a parameter
+     *
+     * @sa gen_binary_param_decl
+     */
+    template <bool IsConst, typename Param, bool AutoDecl, typename RetDecl>
+    constexpr auto gen_index_param_decl(
+        const RetDecl& ret_decl,
+        const param_placeholder<Param, AutoDecl>& param
     )
     {
-        if constexpr(AutoDecl)
+        if constexpr(AutoDecl && is_static_decl_v<RetDecl>)
         {
-            constexpr bool param_ref = std::is_reference_v<T>;
-            constexpr bool param_const = std::is_const_v<std::remove_reference_t<T>>;
-            return gen_index_auto_decl<param_ref, param_const>(
-                ret_decl, param_decl_or_name, is_const
-            );
+            using util::fixed_string;
+            return fixed_const_suffix<
+                RetDecl::value + fixed_string(" opIndex(") + meta::full_fixed_name_of<Param>() + fixed_string(")"),
+                IsConst>();
         }
         else
+            return gen_index_user_decl(ret_decl, param.get_decl(), IsConst);
+    }
+
+    /**
+     * @brief Generate declaration of unary operators
+     *
+     * @sa gen_binary_param_decl
+     */
+    template <util::fixed_string OpName, bool IsConst, typename RetDecl>
+    constexpr auto gen_unary_decl(const RetDecl& ret_decl)
+    {
+        if constexpr(is_static_decl_v<RetDecl>)
         {
-            return gen_index_user_decl(ret_decl, param_decl_or_name, is_const);
+            using util::fixed_string;
+            return fixed_const_suffix<
+                RetDecl::value + fixed_string(" ") + OpName + fixed_string("()"),
+                IsConst>();
         }
+        else
+            return gen_unary_decl(ret_decl, OpName, IsConst);
     }
 
     template <typename ClassType, bool IsConst>
@@ -215,15 +292,15 @@ namespace detail
     // Operator tags — extract lambda creation logic
 
     // Binary/assignment operator tags
-#define ASBIND20_OP_TAG_BINARY(Name, Op)                \
-    struct Name                                         \
-    {                                                   \
-        static constexpr std::string_view name = #Name; \
-        template <typename Lhs, typename Rhs>           \
-        static decltype(auto) apply(Lhs& lhs, Rhs& rhs) \
-        {                                               \
-            return lhs Op rhs;                          \
-        }                                               \
+#define ASBIND20_OP_TAG_BINARY(Name, Op)                  \
+    struct Name                                           \
+    {                                                     \
+        static constexpr util::fixed_string name = #Name; \
+        template <typename Lhs, typename Rhs>             \
+        static decltype(auto) apply(Lhs& lhs, Rhs& rhs)   \
+        {                                                 \
+            return lhs Op rhs;                            \
+        }                                                 \
     }
 
     ASBIND20_OP_TAG_BINARY(opAddAssign, +=);
@@ -253,7 +330,7 @@ namespace detail
     // opCmp — always returns int, uses three-way comparison
     struct op_cmp
     {
-        static constexpr std::string_view name = "opCmp";
+        static constexpr util::fixed_string name = "opCmp";
 
         template <typename L, typename R>
         static int apply(L& l, R& r)
@@ -263,26 +340,26 @@ namespace detail
     };
 
     // Unary operator tags
-#define ASBIND20_OP_TAG_UNARY_PREFIX(Name, Op)          \
-    struct Name                                         \
-    {                                                   \
-        static constexpr std::string_view name = #Name; \
-        template <typename T>                           \
-        static decltype(auto) apply(T& v)               \
-        {                                               \
-            return Op v;                                \
-        }                                               \
+#define ASBIND20_OP_TAG_UNARY_PREFIX(Name, Op)            \
+    struct Name                                           \
+    {                                                     \
+        static constexpr util::fixed_string name = #Name; \
+        template <typename T>                             \
+        static decltype(auto) apply(T& v)                 \
+        {                                                 \
+            return Op v;                                  \
+        }                                                 \
     }
 
-#define ASBIND20_OP_TAG_UNARY_SUFFIX(Name, Op)          \
-    struct Name                                         \
-    {                                                   \
-        static constexpr std::string_view name = #Name; \
-        template <typename T>                           \
-        static decltype(auto) apply(T& v)               \
-        {                                               \
-            return v Op;                                \
-        }                                               \
+#define ASBIND20_OP_TAG_UNARY_SUFFIX(Name, Op)            \
+    struct Name                                           \
+    {                                                     \
+        static constexpr util::fixed_string name = #Name; \
+        template <typename T>                             \
+        static decltype(auto) apply(T& v)                 \
+        {                                                 \
+            return v Op;                                  \
+        }                                                 \
     }
 
     ASBIND20_OP_TAG_UNARY_PREFIX(opNeg, -);
@@ -310,9 +387,20 @@ namespace detail
         template <typename RegisterHelper>
         void operator()(RegisterHelper& ar) const
         {
-            m_parent->template register_impl<Return>(
-                ar, detail::get_return_decl<Return>(ar)
-            );
+            using class_type = typename RegisterHelper::class_type;
+
+            if constexpr(static_return_type<Return, class_type>)
+            {
+                m_parent->template register_impl<Return>(
+                    ar, static_decl_t<fixed_return_decl<Return>()>{}
+                );
+            }
+            else
+            {
+                m_parent->template register_impl<Return>(
+                    ar, detail::get_return_decl<Return>(ar)
+                );
+            }
         }
 
     private:
@@ -385,8 +473,8 @@ namespace detail
     class binary_this_this_op : public operator_base<binary_this_this_op<OpTag, LhsConst, RhsConst>, true>
     {
     public:
-        template <typename Return, typename RegisterHelper>
-        void register_impl(RegisterHelper& ar, std::string_view ret_decl) const
+        template <typename Return, typename RegisterHelper, typename RetDecl>
+        void register_impl(RegisterHelper& ar, const RetDecl& ret_decl) const
         {
             using class_type = typename RegisterHelper::class_type;
             using L = this_arg_t<class_type, LhsConst>;
@@ -424,14 +512,14 @@ namespace detail
 
         using operator_base<binary_this_param_op, true>::operator();
 
-        template <typename Return, typename RegisterHelper>
-        void register_impl(RegisterHelper& ar, std::string_view ret_decl) const
+        template <typename Return, typename RegisterHelper, typename RetDecl>
+        void register_impl(RegisterHelper& ar, const RetDecl& ret_decl) const
         {
             using class_type = typename RegisterHelper::class_type;
             using L = this_arg_t<class_type, ThisConst>;
 
-            auto decl = detail::gen_binary_param_decl<AutoDecl, Rhs>(
-                ret_decl, OpTag::name, this->param_type::get_decl(), ThisConst
+            auto decl = detail::gen_binary_param_decl<OpTag::name, ThisConst>(
+                ret_decl, static_cast<const param_type&>(*this)
             );
 
             ar.method(
@@ -463,17 +551,15 @@ namespace detail
 
         using operator_base<binary_param_this_op, true>::operator();
 
-        template <typename Return, typename RegisterHelper>
-        void register_impl(RegisterHelper& ar, std::string_view ret_decl) const
+        template <typename Return, typename RegisterHelper, typename RetDecl>
+        void register_impl(RegisterHelper& ar, const RetDecl& ret_decl) const
         {
             using class_type = typename RegisterHelper::class_type;
             using R = this_arg_t<class_type, ThisConst>;
 
             // Reversed operator name: append "_r" suffix
-            auto rev_name = string_concat(OpTag::name, "_r");
-
-            auto decl = detail::gen_binary_param_decl<AutoDecl, Lhs>(
-                ret_decl, rev_name, this->param_type::get_decl(), ThisConst
+            auto decl = detail::gen_binary_param_decl<OpTag::name + util::fixed_string("_r"), ThisConst>(
+                ret_decl, static_cast<const param_type&>(*this)
             );
 
             ar.method(
@@ -498,8 +584,8 @@ namespace detail
     class cmp_this_this_op : public operator_base<cmp_this_this_op<LhsConst, RhsConst>, false>
     {
     public:
-        template <typename Return, typename RegisterHelper>
-        void register_impl(RegisterHelper& ar, std::string_view ret_decl) const
+        template <typename Return, typename RegisterHelper, typename RetDecl>
+        void register_impl(RegisterHelper& ar, const RetDecl& ret_decl) const
         {
             static_assert(std::same_as<Return, int>, "opCmp(_r) only returns int");
             using class_type = typename RegisterHelper::class_type;
@@ -535,15 +621,15 @@ namespace detail
 
         using operator_base<cmp_this_param_op, false>::operator();
 
-        template <typename Return, typename RegisterHelper>
-        void register_impl(RegisterHelper& ar, std::string_view) const
+        template <typename Return, typename RegisterHelper, typename RetDecl>
+        void register_impl(RegisterHelper& ar, const RetDecl&) const
         {
             static_assert(std::same_as<Return, int>, "opCmp(_r) only returns int");
             using class_type = typename RegisterHelper::class_type;
             using L = this_arg_t<class_type, ThisConst>;
 
-            auto decl = detail::gen_binary_param_decl<AutoDecl, Rhs>(
-                "int", op_cmp::name, this->param_type::get_decl(), ThisConst
+            auto decl = detail::gen_binary_param_decl<op_cmp::name, ThisConst>(
+                static_decl_t<util::fixed_string("int")>{}, static_cast<const param_type&>(*this)
             );
 
             ar.method(
@@ -571,15 +657,15 @@ namespace detail
 
         using operator_base<cmp_param_this_op, false>::operator();
 
-        template <typename Return, typename RegisterHelper>
-        void register_impl(RegisterHelper& ar, std::string_view) const
+        template <typename Return, typename RegisterHelper, typename RetDecl>
+        void register_impl(RegisterHelper& ar, const RetDecl&) const
         {
             static_assert(std::same_as<Return, int>, "opCmp(_r) only returns int");
             using class_type = typename RegisterHelper::class_type;
             using R = this_arg_t<class_type, ThisConst>;
 
-            auto decl = detail::gen_binary_param_decl<AutoDecl, Lhs>(
-                "int", string_concat(op_cmp::name, "_r"), this->param_type::get_decl(), ThisConst
+            auto decl = detail::gen_binary_param_decl<op_cmp::name + util::fixed_string("_r"), ThisConst>(
+                static_decl_t<util::fixed_string("int")>{}, static_cast<const param_type&>(*this)
             );
 
             ar.method(
@@ -601,8 +687,8 @@ namespace detail
     class index_this_op : public operator_base<index_this_op<ThisConst, IndexConst>, true>
     {
     public:
-        template <typename Return, typename RegisterHelper>
-        void register_impl(RegisterHelper& ar, std::string_view ret_decl) const
+        template <typename Return, typename RegisterHelper, typename RetDecl>
+        void register_impl(RegisterHelper& ar, const RetDecl& ret_decl) const
         {
             using class_type = typename RegisterHelper::class_type;
             using T = this_arg_t<class_type, ThisConst>;
@@ -638,14 +724,14 @@ namespace detail
 
         using operator_base<index_param_op, true>::operator();
 
-        template <typename Return, typename RegisterHelper>
-        void register_impl(RegisterHelper& ar, std::string_view ret_decl) const
+        template <typename Return, typename RegisterHelper, typename RetDecl>
+        void register_impl(RegisterHelper& ar, const RetDecl& ret_decl) const
         {
             using class_type = typename RegisterHelper::class_type;
             using T = this_arg_t<class_type, ThisConst>;
 
-            auto decl = detail::gen_index_param_decl<AutoDecl, Index>(
-                ret_decl, this->param_type::get_decl(), ThisConst
+            auto decl = detail::gen_index_param_decl<ThisConst>(
+                ret_decl, static_cast<const param_type&>(*this)
             );
 
             ar.method(
@@ -667,13 +753,13 @@ namespace detail
     class unary_prefix_op : public operator_base<unary_prefix_op<OpTag, ThisConst>, true>
     {
     public:
-        template <typename Return, typename RegisterHelper>
-        void register_impl(RegisterHelper& ar, std::string_view ret_decl) const
+        template <typename Return, typename RegisterHelper, typename RetDecl>
+        void register_impl(RegisterHelper& ar, const RetDecl& ret_decl) const
         {
             using class_type = typename RegisterHelper::class_type;
             using T = this_arg_t<class_type, ThisConst>;
 
-            auto decl = detail::gen_unary_decl(ret_decl, OpTag::name, ThisConst);
+            auto decl = detail::gen_unary_decl<OpTag::name, ThisConst>(ret_decl);
 
             ar.method(
                 decl,
@@ -694,13 +780,13 @@ namespace detail
     class unary_suffix_op : public operator_base<unary_suffix_op<OpTag, ThisConst>, true>
     {
     public:
-        template <typename Return, typename RegisterHelper>
-        void register_impl(RegisterHelper& ar, std::string_view ret_decl) const
+        template <typename Return, typename RegisterHelper, typename RetDecl>
+        void register_impl(RegisterHelper& ar, const RetDecl& ret_decl) const
         {
             using class_type = typename RegisterHelper::class_type;
             using T = this_arg_t<class_type, ThisConst>;
 
-            auto decl = detail::gen_unary_decl(ret_decl, OpTag::name, ThisConst);
+            auto decl = detail::gen_unary_decl<OpTag::name, ThisConst>(ret_decl);
 
             ar.method(
                 decl,
@@ -58,6 +58,26 @@ struct apply_to
 
         return result;
     }
+
+    /**
+     * @brief Generate the list pattern at compile time, e.g. `{int,int}` for `apply_to<2>` with `int`.
+     *
+     * @return Same pattern as `pattern()`, but as a `util::fixed_string`
+     */
+    template <has_static_name ListElementType>
+    requires(!std::is_void_v<ListElementType>)
+    static consteval auto fixed_pattern()
+    {
+        using util::fixed_string;
+
+        return [&]<std::size_t... Is>(std::index_sequence<Is...>)
+        {
+            return (
+                (fixed_string("{") + name_of<ListElementType>()) + ... +
+                ((void)Is, fixed_string(",") + name_of<ListElementType>())
+            ) + fixed_string("}");
+        }(std::make_index_sequence<Size - 1>());
+    }
 };
 
 /**
@@ -5,7 +5,7 @@
 
 #include <cstddef>
 #include <asbind20/asbind.hpp>
-#include <asbind20/concurrent/mutex.hpp>
+#include <asbind20/concurrent/template_cache.hpp>
 #include <asbind20/container/small_vector.hpp>
 #include <asbind20/operators.hpp>
 #include <asbind20/container/compare.hpp>
@@ -13,17 +13,6 @@
 
 namespace asbind_test
 {
-consteval auto default_script_array_user_id() noexcept
-    -> AS_NAMESPACE_QUALIFIER asPWORD
-{
-    return 2000;
-}
-
-// Implementation Note:
-// Keep the code related to script array in header file,
-// in order to support user customizing user data ID by defining macro.
-// It may cause ODR-violation to put code in a separated source file.
-
 namespace detail
 {
     class script_array_base
@@ -65,61 +54,29 @@ namespace detail
             array_cache& out, int subtype_id, AS_NAMESPACE_QUALIFIER asITypeInfo* ti
         );
 
+        using cache_type = asbind20::template_instance_cache<array_cache>;
+
         // Setups cached methods for script array.
         // This function must be called whenever a new script array has been constructed!
         // According to the author of AngelScript, the template callback is not meant for caching data.
         // See: https://www.gamedev.net/forums/topic/717709-about-caching-required-methods-in-template-callback/
-        template <AS_NAMESPACE_QUALIFIER asPWORD UserDataID>
-        static void setup_cache(
-            int subtype_id, AS_NAMESPACE_QUALIFIER asITypeInfo* ti
-        )
+        static void setup_cache(AS_NAMESPACE_QUALIFIER asITypeInfo* ti)
         {
-            array_cache* cache = static_cast<array_cache*>(
-                ti->GetUserData(UserDataID)
-            );
-            if(cache) [[likely]]
-                return;
-
-            std::unique_lock lk(asbind20::script_lock);
-
-            // Double-check to prevent cache from being created by another thread
-            cache = static_cast<array_cache*>(ti->GetUserData(UserDataID));
-            if(cache) [[unlikely]]
-                return;
-
-            cache = reinterpret_cast<array_cache*>(
-                AS_NAMESPACE_QUALIFIER asAllocMem(sizeof(array_cache))
+            cache_type::get_or_create(
+                ti,
+                [](AS_NAMESPACE_QUALIFIER asITypeInfo* ti)
+                {
+                    array_cache out{};
+                    generate_cache(out, ti->GetSubTypeId(), ti);
+                    return out;
+                }
             );
-            if(!cache) [[unlikely]]
-            {
-                asbind20::set_script_exception("out of memory");
-                return;
-            }
-
-            new(cache) array_cache{};
-            generate_cache(*cache, subtype_id, ti);
-
-            ti->SetUserData(cache, UserDataID);
-        }
-
-        template <AS_NAMESPACE_QUALIFIER asPWORD UserDataID>
-        static void cache_cleanup_callback(AS_NAMESPACE_QUALIFIER asITypeInfo* ti)
-        {
-            array_cache* mem = get_cache<UserDataID>(ti);
-            if(mem)
-            {
-                mem->~array_cache();
-                AS_NAMESPACE_QUALIFIER asFreeMem(mem);
-            }
         }
 
-        template <AS_NAMESPACE_QUALIFIER asPWORD UserDataID>
         static array_cache* get_cache(AS_NAMESPACE_QUALIFIER asITypeInfo* ti)
         {
             assert(ti != nullptr);
-            return static_cast<array_cache*>(
-                ti->GetUserData(UserDataID)
-            );
+            return cache_type::get(ti);
         }
     };
 } // namespace detail
@@ -130,17 +87,14 @@ class script_array : private detail::script_array_base
 
     using my_base = detail::script_array_base;
 
-    static constexpr AS_NAMESPACE_QUALIFIER asPWORD user_id = default_script_array_user_id();
-
     void setup_cache()
     {
-        AS_NAMESPACE_QUALIFIER asITypeInfo* ti = get_type_info();
-        my_base::setup_cache<user_id>(ti->GetSubTypeId(), ti);
+        my_base::setup_cache(get_type_info());
     }
 
     array_cache* get_cache() const
     {
-        return my_base::get_cache<user_id>(get_type_info());
+        return my_base::get_cache(get_type_info());
     }
 
 public:
@@ -1660,11 +1614,6 @@ inline void register_script_array(
         helper(std::true_type{});
     else
         helper(std::false_type{});
-
-    engine->SetTypeInfoUserDataCleanupCallback(
-        &array_t::template cache_cleanup_callback<array_t::user_id>,
-        array_t::user_id
-    );
 }
 
 template <std::size_t Size>
@@ -37,10 +37,18 @@ void setup_script_char(
 
 /**
  * @brief String factory for std::string
+ *
+ * Each engine has its own factory guarded by the lock of engine,
+ * so building modules on independent engines won't contend on the global lock.
  */
 class string_factory : public AS_NAMESPACE_QUALIFIER asIStringFactory
 {
 public:
+    static constexpr AS_NAMESPACE_QUALIFIER asPWORD user_id = 2001;
+
+    explicit string_factory(AS_NAMESPACE_QUALIFIER asIScriptEngine* engine)
+        : m_lock(&asbind20::engine_local_lock::get(engine)) {}
+
     struct string_hash
     {
         using is_transparent = void;
@@ -72,7 +80,7 @@ public:
         const char* data, AS_NAMESPACE_QUALIFIER asUINT length
     ) override
     {
-        std::unique_lock lk(asbind20::script_lock);
+        std::unique_lock lk(*m_lock);
 
         std::string_view view(data, length);
         auto it = m_cache.find(view);
@@ -114,7 +122,7 @@ public:
 
         int r = AS_NAMESPACE_QUALIFIER asSUCCESS;
 
-        std::unique_lock lk(asbind20::script_lock);
+        std::unique_lock lk(*m_lock);
 
         auto it = m_cache.find(*ptr);
 
@@ -140,7 +148,7 @@ public:
         if(ptr == nullptr)
             return AS_NAMESPACE_QUALIFIER asERROR;
 
-        std::shared_lock lk(asbind20::script_lock);
+        std::shared_lock lk(*m_lock);
 
         if(length)
             *length = static_cast<AS_NAMESPACE_QUALIFIER asUINT>(ptr->size());
@@ -149,13 +157,29 @@ public:
         return AS_NAMESPACE_QUALIFIER asSUCCESS;
     }
 
-    static string_factory& get()
+    /**
+     * @brief Get the string factory of an engine, creating it if it doesn't exist
+     */
+    static string_factory& get(AS_NAMESPACE_QUALIFIER asIScriptEngine* engine)
     {
-        static string_factory instance{};
-        return instance;
+        auto* existing = static_cast<string_factory*>(engine->GetUserData(user_id));
+        if(existing)
+            return *existing;
+
+        auto* created = new string_factory(engine);
+        engine->SetEngineUserDataCleanupCallback(
+            [](AS_NAMESPACE_QUALIFIER asIScriptEngine* engine)
+            {
+                delete static_cast<string_factory*>(engine->GetUserData(user_id));
+            },
+            user_id
+        );
+        engine->SetUserData(created, user_id);
+        return *created;
     }
 
 private:
+    asbind20::engine_local_lock* m_lock;
     container_type m_cache;
 };
 
@@ -348,7 +348,7 @@ static void setup_script_string_impl(
     }
 
     if(as_default)
-        c.as_string(&string_factory::get());
+        c.as_string(&string_factory::get(engine));
 }
 
 void setup_script_string(
@@ -25,9 +25,9 @@ public:
         asbind_test::setup_string_utils(m_engine, UseGeneric);
     }
 
-    static auto& get_str_factory()
+    auto& get_str_factory() const
     {
-        return asbind_test::string_factory::get();
+        return asbind_test::string_factory::get(m_engine.get());
     }
 
     auto get_engine() const
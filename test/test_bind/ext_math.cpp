@@ -0,0 +1,172 @@
+#include <gtest/gtest.h>
+#include <asbind_test/framework.hpp>
+#include <asbind_test/array.hpp>
+#include <asbind20/asbind.hpp>
+#include <asbind20/ext/math.hpp>
+#include <vector>
+
+namespace test_bind
+{
+static constexpr char ext_math_script[] = R"AngelScript(
+void test_vector()
+{
+    vec3 a(1, 2, 3);
+    vec3 b = {4, 5, 6};
+    assert(a + b == vec3(5, 7, 9));
+    assert(b - a == vec3(3));
+    assert(-a == vec3(-1, -2, -3));
+    assert(a * b == vec3(4, 10, 18));
+    assert(a * 2.0f == vec3(2, 4, 6));
+    assert(2.0f * a == vec3(2, 4, 6));
+    assert(b / 2.0f == vec3(2, 2.5f, 3));
+    assert(a.dot(b) == 32);
+    assert(vec3(1, 0, 0).cross(vec3(0, 1, 0)) == vec3(0, 0, 1));
+    assert(vec3(3, 4, 0).length() == 5);
+    assert(vec2(3, 4).length_sq() == 25);
+
+    a += b;
+    a *= 2.0f;
+    assert(a == vec3(10, 14, 18));
+    assert(a[2] == 18);
+    a.y = 0;
+    assert(a[1] == 0);
+
+    vec4 c(vec3(1, 2, 3), 4);
+    assert(c + vec4(1) == vec4(2, 3, 4, 5));
+    assert(c.dot(vec4(1, 1, 1, 1)) == 10);
+    assert(c.xyz() == vec3(1, 2, 3));
+    assert(c.w == 4);
+}
+
+void test_matrix()
+{
+    mat4 m = mat4_translation(vec3(1, 2, 3)) * mat4_scale(vec3(2));
+    assert(m * vec4(1, 1, 1, 1) == vec4(3, 4, 5, 1));
+    assert(m.transform_point(vec3(1, 0, 0)) == vec3(3, 2, 3));
+    assert(m.transform_direction(vec3(1, 0, 0)) == vec3(2, 0, 0));
+    assert(m[12] == 1);
+    assert(m.transposed()[3] == 1);
+
+    mat4 id;
+    assert(id * m == m);
+    id *= m;
+    assert(id == m);
+
+    quat q;
+    assert(q * vec3(1, 2, 3) == vec3(1, 2, 3));
+    quat half_turn = quat_from_axis_angle(vec3(0, 0, 1), 3.14159265f);
+    vec3 r = half_turn * vec3(1, 0, 0);
+    assert(r.x == -1);
+    assert((half_turn * half_turn.conjugate()).w == 1);
+}
+
+void test_batch()
+{
+    array<float> xyz = {1, 0, 0, 0, 1, 0};
+    transform_points(mat4_translation(vec3(1, 2, 3)), xyz);
+    assert(xyz[0] == 2 && xyz[1] == 2 && xyz[2] == 3);
+    assert(xyz[3] == 1 && xyz[4] == 3 && xyz[5] == 3);
+
+    transform_directions(mat4_translation(vec3(1, 2, 3)), xyz);
+    assert(xyz[0] == 2 && xyz[5] == 3);
+
+    array<float> xyzw = {1, 1, 1, 1, 0, 1, 0, 0};
+    transform(mat4_scale(vec3(2)), xyzw);
+    assert(xyzw[0] == 2 && xyzw[3] == 1);
+    assert(xyzw[5] == 2 && xyzw[7] == 0);
+}
+
+void test_bad_size()
+{
+    array<float> xyz = {1, 2};
+    transform_points(mat4(), xyz);
+}
+)AngelScript";
+
+static void run_ext_math_script(AS_NAMESPACE_QUALIFIER asIScriptEngine* engine)
+{
+    auto* m = engine->GetModule("test_ext_math", AS_NAMESPACE_QUALIFIER asGM_ALWAYS_CREATE);
+    m->AddScriptSection("test_ext_math.as", ext_math_script);
+    ASSERT_GE(m->Build(), 0);
+
+    for(const char* decl : {"void test_vector()", "void test_matrix()", "void test_batch()"})
+    {
+        asbind20::request_context ctx(engine);
+        auto result = asbind20::script_invoke<void>(ctx, m->GetFunctionByDecl(decl));
+        EXPECT_TRUE(asbind_test::result_has_value(result))
+            << decl;
+    }
+
+    asbind20::request_context ctx(engine);
+    auto result = asbind20::script_invoke<void>(ctx, m->GetFunctionByDecl("void test_bad_size()"));
+    EXPECT_FALSE(asbind_test::result_has_value(result));
+    EXPECT_EQ(result.error(), AS_NAMESPACE_QUALIFIER asEXECUTION_EXCEPTION);
+}
+} // namespace test_bind
+
+TEST(ExtMath, Kernels)
+{
+    using namespace asbind20::ext;
+
+    mat4 m = mat4::translation(vec3(1, 2, 3)) * mat4::rotation(quat::from_axis_angle(vec3(0, 1, 0), 0.5f));
+
+    std::vector<vec3> points{{1, 0, 0}, {0, 1, 0}, {0, 0, 1}, {1, 2, 3}, {-4, 5, -6}};
+    std::vector<vec3> out(points.size());
+    transform_points(m, points, out);
+    for(std::size_t i = 0; i < points.size(); ++i)
+    {
+        vec4 expected = m * vec4(points[i], 1.0f);
+        EXPECT_FLOAT_EQ(out[i].x, expected.x);
+        EXPECT_FLOAT_EQ(out[i].y, expected.y);
+        EXPECT_FLOAT_EQ(out[i].z, expected.z);
+    }
+
+    // In place
+    transform_directions(m, points);
+    EXPECT_EQ(points[3], m.transform_direction(vec3(1, 2, 3)));
+
+    std::vector<vec4> vectors{{1, 2, 3, 1}, {4, 5, 6, 0}};
+    transform(mat4::scale(vec3(2)), vectors);
+    EXPECT_EQ(vectors[0], vec4(2, 4, 6, 1));
+    EXPECT_EQ(vectors[1], vec4(8, 10, 12, 0));
+
+    // Empty spans
+    transform_points(m, std::span<vec3>());
+    transform_directions(m, std::span<const vec3>(), std::span<vec3>());
+    transform(m, std::span<vec4>());
+
+    quat q = quat::from_axis_angle(vec3(0, 0, 1), 1.0f);
+    vec3 by_quat = q * vec3(1, 2, 3);
+    vec3 by_mat = mat4::rotation(q).transform_direction(vec3(1, 2, 3));
+    EXPECT_NEAR(by_quat.x, by_mat.x, 1e-5f);
+    EXPECT_NEAR(by_quat.y, by_mat.y, 1e-5f);
+    EXPECT_NEAR(by_quat.z, by_mat.z, 1e-5f);
+}
+
+TEST(ExtMath, Native)
+{
+    ASBIND_TEST_SKIP_IF_MAX_PORTABILITY();
+
+    auto engine = asbind20::make_script_engine();
+    asbind_test::setup_message_callback(engine, true);
+    asbind_test::setup_script_assertion(engine);
+    asbind_test::register_script_array(engine, true, false);
+
+    asbind20::ext::register_math(engine);
+    asbind20::ext::register_math_batch<asbind_test::script_array>(engine);
+
+    test_bind::run_ext_math_script(engine);
+}
+
+TEST(ExtMath, Generic)
+{
+    auto engine = asbind20::make_script_engine();
+    asbind_test::setup_message_callback(engine, true);
+    asbind_test::setup_script_assertion(engine);
+    asbind_test::register_script_array(engine, true, true);
+
+    asbind20::ext::register_math<true>(engine);
+    asbind20::ext::register_math_batch<asbind_test::script_array, true>(engine);
+
+    test_bind::run_ext_math_script(engine);
+}
@@ -0,0 +1,225 @@
+#include <gtest/gtest.h>
+#include <asbind_test/framework.hpp>
+#include <asbind20/asbind.hpp>
+#include <asbind20/bind/lazy.hpp>
+#include <stdexcept>
+
+namespace test_bind
+{
+struct lazy_vec
+{
+    float x = 0.0f;
+
+    float length() const
+    {
+        return x < 0.0f ? -x : x;
+    }
+
+    lazy_vec negated() const
+    {
+        return lazy_vec{-x};
+    }
+};
+
+struct lazy_mat
+{
+    float det = 1.0f;
+
+    lazy_vec row() const
+    {
+        return lazy_vec{det};
+    }
+};
+
+static int lazy_vec_count = 0;
+static int lazy_mat_count = 0;
+
+static void declare_lazy_types(AS_NAMESPACE_QUALIFIER asIScriptEngine* engine)
+{
+    using namespace asbind20;
+
+    value_class<lazy_vec, true>(engine, "lazy_vec", AS_NAMESPACE_QUALIFIER asOBJ_APP_CLASS_ALLFLOATS)
+        .behaviours_by_traits();
+    value_class<lazy_mat, true>(engine, "lazy_mat", AS_NAMESPACE_QUALIFIER asOBJ_APP_CLASS_ALLFLOATS)
+        .behaviours_by_traits();
+}
+
+static void register_lazy_vec(AS_NAMESPACE_QUALIFIER asIScriptEngine* engine)
+{
+    using namespace asbind20;
+
+    ++lazy_vec_count;
+    value_class<lazy_vec, true>(appending, engine, "lazy_vec")
+        .method("float length() const", fp<&lazy_vec::length>)
+        .method("lazy_vec negated() const", fp<&lazy_vec::negated>)
+        .property("float x", &lazy_vec::x);
+}
+
+static void register_lazy_mat(AS_NAMESPACE_QUALIFIER asIScriptEngine* engine)
+{
+    using namespace asbind20;
+
+    ++lazy_mat_count;
+    value_class<lazy_mat, true>(appending, engine, "lazy_mat")
+        .method("lazy_vec row() const", fp<&lazy_mat::row>)
+        .property("float det", &lazy_mat::det);
+}
+
+static asbind20::lazy_registry& get_lazy_registry()
+{
+    static asbind20::lazy_registry reg;
+    if(reg.size() == 0)
+    {
+        reg.add("lazy_vec", &register_lazy_vec);
+        // Members of lazy_vec are needed by the returned value of row()
+        reg.add("lazy_mat", &register_lazy_mat, {"lazy_vec"});
+    }
+    return reg;
+}
+
+static constexpr char lazy_vec_script[] = R"AngelScript(
+// lazy_mat in comments should be ignored
+float test()
+{
+    lazy_vec v;
+    v.x = -2.0;
+    return v.negated().length();
+}
+)AngelScript";
+
+static constexpr char lazy_mat_script[] = R"AngelScript(
+float test()
+{
+    lazy_mat m;
+    m.det = 3.0;
+    return m.row().length();
+}
+)AngelScript";
+
+static void build_and_check(
+    AS_NAMESPACE_QUALIFIER asIScriptEngine* engine,
+    const char* code,
+    float expected
+)
+{
+    auto* m = engine->GetModule("test_lazy", AS_NAMESPACE_QUALIFIER asGM_ALWAYS_CREATE);
+    m->AddScriptSection("test_lazy.as", code);
+    ASSERT_GE(m->Build(), 0);
+
+    asbind20::request_context ctx(engine);
+    auto result = asbind20::script_invoke<float>(ctx, m->GetFunctionByDecl("float test()"));
+    ASSERT_TRUE(asbind_test::result_has_value(result));
+    EXPECT_FLOAT_EQ(result.value(), expected);
+}
+} // namespace test_bind
+
+TEST(LazyRegistry, Prepare)
+{
+    using namespace test_bind;
+
+    auto& reg = get_lazy_registry();
+    lazy_vec_count = 0;
+    lazy_mat_count = 0;
+
+    auto engine = asbind20::make_script_engine();
+    asbind_test::setup_message_callback(engine, true);
+    declare_lazy_types(engine);
+
+    EXPECT_EQ(reg.prepare(engine, lazy_vec_script), 1);
+    EXPECT_TRUE(reg.is_registered(engine, "lazy_vec"));
+    EXPECT_FALSE(reg.is_registered(engine, "lazy_mat"));
+    build_and_check(engine, lazy_vec_script, 2.0f);
+
+    // lazy_vec has been registered
+    EXPECT_EQ(reg.prepare(engine, lazy_mat_script), 1);
+    EXPECT_TRUE(reg.is_registered(engine, "lazy_mat"));
+    build_and_check(engine, lazy_mat_script, 3.0f);
+
+    EXPECT_EQ(reg.prepare(engine, lazy_mat_script), 0);
+    EXPECT_EQ(lazy_vec_count, 1);
+    EXPECT_EQ(lazy_mat_count, 1);
+}
+
+TEST(LazyRegistry, Require)
+{
+    using namespace test_bind;
+
+    auto& reg = get_lazy_registry();
+    lazy_vec_count = 0;
+    lazy_mat_count = 0;
+
+    auto engine = asbind20::make_script_engine();
+    asbind_test::setup_message_callback(engine, true);
+    declare_lazy_types(engine);
+
+    EXPECT_EQ(reg.require(engine, "unknown"), AS_NAMESPACE_QUALIFIER asNO_FUNCTION);
+
+    // Dependencies are registered as well
+    EXPECT_EQ(reg.require(engine, {"lazy_mat"}), 2);
+    EXPECT_TRUE(reg.is_registered(engine, "lazy_vec"));
+    build_and_check(engine, lazy_mat_script, 3.0f);
+
+    EXPECT_EQ(reg.require_all(engine), 0);
+    EXPECT_EQ(lazy_vec_count, 1);
+    EXPECT_EQ(lazy_mat_count, 1);
+
+    // Entries are recorded for each engine
+    auto other = asbind20::make_script_engine();
+    asbind_test::setup_message_callback(other, true);
+    declare_lazy_types(other);
+    EXPECT_FALSE(reg.is_registered(other, "lazy_vec"));
+    EXPECT_EQ(reg.require_all(other), 2);
+    build_and_check(other, lazy_vec_script, 2.0f);
+}
+
+namespace test_bind
+{
+static int lazy_flaky_calls = 0;
+static int lazy_cycle_calls = 0;
+} // namespace test_bind
+
+TEST(LazyRegistry, RetryAfterFailure)
+{
+    using namespace test_bind;
+
+    asbind20::lazy_registry reg;
+    reg.add(
+        "flaky",
+        [](AS_NAMESPACE_QUALIFIER asIScriptEngine*)
+        {
+            // Fail at the first time
+            if(lazy_flaky_calls++ == 0)
+                throw std::runtime_error("flaky");
+        }
+    );
+    // Circular dependencies are stopped by the "in progress" mark
+    reg.add(
+        "cycle_a",
+        [](AS_NAMESPACE_QUALIFIER asIScriptEngine*)
+        { ++lazy_cycle_calls; },
+        {"cycle_b"}
+    );
+    reg.add(
+        "cycle_b",
+        [](AS_NAMESPACE_QUALIFIER asIScriptEngine*)
+        { ++lazy_cycle_calls; },
+        {"cycle_a"}
+    );
+    lazy_flaky_calls = 0;
+    lazy_cycle_calls = 0;
+
+    auto engine = asbind20::make_script_engine();
+    asbind_test::setup_message_callback(engine, true);
+
+    EXPECT_THROW((void)reg.require(engine, {"flaky"}), std::runtime_error);
+    EXPECT_FALSE(reg.is_registered(engine, "flaky"));
+
+    EXPECT_EQ(reg.require(engine, {"flaky"}), 1);
+    EXPECT_TRUE(reg.is_registered(engine, "flaky"));
+    EXPECT_EQ(lazy_flaky_calls, 2);
+
+    EXPECT_EQ(reg.require(engine, {"cycle_a"}), 2);
+    EXPECT_TRUE(reg.is_registered(engine, "cycle_a"));
+    EXPECT_TRUE(reg.is_registered(engine, "cycle_b"));
+    EXPECT_EQ(lazy_cycle_calls, 2);
+}
@@ -0,0 +1,133 @@
+#include <gtest/gtest.h>
+#include <asbind_test/framework.hpp>
+#include <asbind20/asbind.hpp>
+
+namespace test_bind
+{
+class table_counter
+{
+public:
+    int get() const
+    {
+        return m_val;
+    }
+
+    // Same signature as get()
+    int get_doubled() const
+    {
+        return m_val * 2;
+    }
+
+    void set(int val)
+    {
+        m_val = val;
+    }
+
+    void add(int val)
+    {
+        m_val += val;
+    }
+
+private:
+    int m_val = 0;
+};
+
+static int table_counter_sub(const table_counter& c, int val)
+{
+    return c.get() - val;
+}
+
+static void table_counter_reset(table_counter& c)
+{
+    c.set(0);
+}
+
+static constexpr asbind20::method_entry<table_counter> table_counter_methods[]{
+    {"int get() const", asbind20::fp<&table_counter::get>},
+    {"int get_doubled() const", asbind20::fp<&table_counter::get_doubled>},
+    {"void set(int val)", asbind20::fp<&table_counter::set>},
+    {"void add(int val)", asbind20::fp<&table_counter::add>},
+    {"int sub(int val) const", asbind20::fp<&table_counter_sub>},
+    {"void reset()", asbind20::fp<&table_counter_reset>},
+};
+
+template <bool UseGeneric>
+static void register_table_counter(AS_NAMESPACE_QUALIFIER asIScriptEngine* engine)
+{
+    using namespace asbind20;
+
+    value_class<table_counter, UseGeneric>(engine, "table_counter", AS_NAMESPACE_QUALIFIER asOBJ_APP_CLASS_ALLINTS)
+        .behaviours_by_traits()
+        .methods(table_counter_methods);
+}
+
+static constexpr char method_table_script[] = R"AngelScript(
+void test()
+{
+    table_counter c;
+    assert(c.get() == 0);
+    c.set(2);
+    c.add(3);
+    assert(c.get() == 5);
+    assert(c.get_doubled() == 10);
+    assert(c.sub(1) == 4);
+    c.reset();
+    assert(c.get() == 0);
+}
+)AngelScript";
+
+template <bool UseGeneric>
+static void test_method_table(AS_NAMESPACE_QUALIFIER asIScriptEngine* engine)
+{
+    using namespace asbind20;
+
+    register_table_counter<UseGeneric>(engine);
+
+    auto* ti = engine->GetTypeInfoByName("table_counter");
+    ASSERT_TRUE(ti);
+    EXPECT_EQ(ti->GetMethodCount(), std::size(table_counter_methods));
+
+    auto* m = engine->GetModule("test_method_table", AS_NAMESPACE_QUALIFIER asGM_ALWAYS_CREATE);
+    m->AddScriptSection("test_method_table.as", method_table_script);
+    ASSERT_GE(m->Build(), 0);
+
+    request_context ctx(engine);
+    auto result = script_invoke<void>(ctx, m->GetFunctionByDecl("void test()"));
+    EXPECT_TRUE(asbind_test::result_has_value(result));
+}
+} // namespace test_bind
+
+TEST(MethodTable, SharedWrappers)
+{
+    using namespace asbind20;
+    using test_bind::table_counter_methods;
+
+    // Methods of the same signature share the generic wrapper
+    static_assert(table_counter_methods[0].generic == table_counter_methods[1].generic);
+    static_assert(table_counter_methods[2].generic == table_counter_methods[3].generic);
+    static_assert(table_counter_methods[0].generic != table_counter_methods[2].generic);
+
+    static_assert(table_counter_methods[0].conv == AS_NAMESPACE_QUALIFIER asCALL_THISCALL);
+    static_assert(table_counter_methods[4].conv == AS_NAMESPACE_QUALIFIER asCALL_CDECL_OBJFIRST);
+    static_assert(table_counter_methods[5].conv == AS_NAMESPACE_QUALIFIER asCALL_CDECL_OBJLAST);
+}
+
+TEST(MethodTable, Native)
+{
+    ASBIND_TEST_SKIP_IF_MAX_PORTABILITY();
+
+    auto engine = asbind20::make_script_engine();
+    asbind_test::setup_message_callback(engine, true);
+    asbind_test::setup_script_assertion(engine);
+
+    test_bind::test_method_table<false>(engine);
+}
+
+TEST(MethodTable, Generic)
+{
+    auto engine = asbind20::make_script_engine();
+    asbind_test::setup_message_callback(engine, true);
+    asbind_test::setup_script_assertion(engine);
+
+    test_bind::test_method_table<true>(engine);
+}
@@ -0,0 +1,108 @@
+#include <gtest/gtest.h>
+#include <asbind_test/framework.hpp>
+#include <asbind20/asbind.hpp>
+
+namespace test_bind
+{
+static float shared_scale(float val, int factor)
+{
+    return val * static_cast<float>(factor);
+}
+
+static float shared_offset(float val, int offset)
+{
+    return val + static_cast<float>(offset);
+}
+
+class shared_vec
+{
+public:
+    float x = 0.0f;
+
+    void scale(float factor)
+    {
+        x *= factor;
+    }
+
+    void translate(float delta)
+    {
+        x += delta;
+    }
+};
+
+static void shared_vec_set(shared_vec& v, float val)
+{
+    v.x = val;
+}
+
+static void register_shared_generic(AS_NAMESPACE_QUALIFIER asIScriptEngine* engine)
+{
+    using namespace asbind20;
+
+    global<true>(engine)
+        .function(use_shared_generic, "float scale(float val, int factor)", fp<&shared_scale>)
+        .function(use_shared_generic, "float offset(float val, int offset)", fp<&shared_offset>);
+
+    value_class<shared_vec, true>(engine, "shared_vec", AS_NAMESPACE_QUALIFIER asOBJ_APP_CLASS_ALLFLOATS)
+        .behaviours_by_traits()
+        .method(use_shared_generic, "void scale(float factor)", fp<&shared_vec::scale>)
+        .method(use_shared_generic, "void translate(float delta)", fp<&shared_vec::translate>)
+        .method(use_shared_generic, "void set(float val)", fp<&shared_vec_set>)
+        .property("float x", &shared_vec::x);
+}
+
+static constexpr char shared_generic_script[] = R"AngelScript(
+void test()
+{
+    assert(scale(1.5, 2) == 3.0);
+    assert(offset(1.5, 2) == 3.5);
+
+    shared_vec v;
+    v.set(2.0);
+    v.scale(3.0);
+    v.translate(1.0);
+    assert(v.x == 7.0);
+}
+)AngelScript";
+} // namespace test_bind
+
+TEST(SharedGeneric, Wrappers)
+{
+    using namespace asbind20;
+    using detail::cc;
+    using detail::to_shared_asGENFUNC_t;
+    using test_bind::shared_vec;
+
+    // Functions of the same signature share the wrapper
+    static_assert(
+        to_shared_asGENFUNC_t(fp<&test_bind::shared_scale>, cc<AS_NAMESPACE_QUALIFIER asCALL_CDECL>) ==
+        to_shared_asGENFUNC_t(fp<&test_bind::shared_offset>, cc<AS_NAMESPACE_QUALIFIER asCALL_CDECL>)
+    );
+    static_assert(
+        to_shared_asGENFUNC_t(fp<&shared_vec::scale>, cc<AS_NAMESPACE_QUALIFIER asCALL_THISCALL>) ==
+        to_shared_asGENFUNC_t(fp<&shared_vec::translate>, cc<AS_NAMESPACE_QUALIFIER asCALL_THISCALL>)
+    );
+
+    // The auxiliary pointers are different
+    EXPECT_NE(
+        detail::shared_generic_aux(fp<&test_bind::shared_scale>),
+        detail::shared_generic_aux(fp<&test_bind::shared_offset>)
+    );
+}
+
+TEST(SharedGeneric, Register)
+{
+    auto engine = asbind20::make_script_engine();
+    asbind_test::setup_message_callback(engine, true);
+    asbind_test::setup_script_assertion(engine);
+
+    test_bind::register_shared_generic(engine);
+
+    auto* m = engine->GetModule("test_shared_generic", AS_NAMESPACE_QUALIFIER asGM_ALWAYS_CREATE);
+    m->AddScriptSection("test_shared_generic.as", test_bind::shared_generic_script);
+    ASSERT_GE(m->Build(), 0);
+
+    asbind20::request_context ctx(engine);
+    auto result = asbind20::script_invoke<void>(ctx, m->GetFunctionByDecl("void test()"));
+    EXPECT_TRUE(asbind_test::result_has_value(result));
+}
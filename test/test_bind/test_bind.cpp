@@ -46,6 +46,18 @@ TEST(Detail, GenerateMemberFuncdef)
     );
 }
 
+TEST(Detail, FixedDeclarations)
+{
+    using namespace asbind20;
+
+    static_assert(detail::fixed_decl_opConv<int, false>() == util::fixed_string("int opConv() const"));
+    static_assert(detail::fixed_decl_opConv<double, true>() == util::fixed_string("double opImplConv() const"));
+
+    static_assert(policies::apply_to<1>::fixed_pattern<float>() == util::fixed_string("{float}"));
+    static_assert(policies::apply_to<3>::fixed_pattern<int>() == util::fixed_string("{int,int,int}"));
+    EXPECT_EQ(policies::apply_to<3>::pattern<int>(), "{int,int,int}");
+}
+
 TEST(TestBind, Interface)
 {
     auto engine = asbind20::make_script_engine();
@@ -296,8 +308,8 @@ consteval void test_detail_arg_idx()
         static_assert(!var_type_tag<var_type_t<0, 2>, 0>{});
         static_assert(var_type_tag<var_type_t<0, 2>, 1>{});
         static_assert(!var_type_tag<var_type_t<0, 2>, 2>{});
-        static_assert(var_type_tag<var_type_t<0, 2>, 3>{});
-        static_assert(!var_type_tag<var_type_t<0, 2>, 4>{});
+        static_assert(!var_type_tag<var_type_t<0, 2>, 3>{});
+        static_assert(var_type_tag<var_type_t<0, 2>, 4>{});
     }
 }
 } // namespace test_bind
@@ -407,6 +419,141 @@ TEST(Detail, GenericWrapper)
     m->Discard();
 }
 
+namespace test_bind
+{
+static double mixed_args(
+    std::int8_t a, std::int64_t b, float c, double d, const std::string& s, bool e
+)
+{
+    return a + static_cast<double>(b) + c + d + static_cast<double>(s.size()) + (e ? 1000 : 0);
+}
+
+struct direct_args_obj
+{
+    int value = 0;
+
+    int add_to(std::int64_t a, direct_args_obj other, int& out) const
+    {
+        out = static_cast<int>(value + a + other.value);
+        return out;
+    }
+};
+
+static int direct_args_objlast(double a, std::int8_t b, direct_args_obj& obj)
+{
+    return obj.value + static_cast<int>(a) + b;
+}
+
+static int direct_var_args(int a, void* ref, int type_id, float b)
+{
+    if(type_id != AS_NAMESPACE_QUALIFIER asTYPEID_INT32)
+        return -1;
+    return a + *static_cast<int*>(ref) + static_cast<int>(b);
+}
+} // namespace test_bind
+
+TEST(Detail, GenericDirectArgs)
+{
+    using namespace asbind20;
+    using detail::gen_arg_reader;
+    using detail::gen_ptr_size;
+
+    {
+        using reader = gen_arg_reader<std::int8_t, std::int64_t, float, double, const std::string&, bool>;
+#ifndef ASBIND20_CONFIG_NO_DIRECT_GENERIC_ARGS
+        static_assert(reader::direct);
+#endif
+        static_assert(reader::offsets[0] == 0);
+        static_assert(reader::offsets[1] == 1);
+        static_assert(reader::offsets[2] == 3);
+        static_assert(reader::offsets[3] == 4);
+        static_assert(reader::offsets[4] == 6);
+        static_assert(reader::offsets[5] == 6 + gen_ptr_size);
+    }
+
+    {
+        // (int, ?&in, float) in script
+        using reader = detail::basic_gen_arg_reader<var_type_t<1>, int, void*, int, float>;
+#ifndef ASBIND20_CONFIG_NO_DIRECT_GENERIC_ARGS
+        static_assert(reader::direct);
+#endif
+        static_assert(reader::offsets[1] == 1);
+        static_assert(reader::offsets[2] == 1 + gen_ptr_size);
+        static_assert(reader::offsets[3] == 2 + gen_ptr_size);
+    }
+
+    // Objects passed by value cannot be the first argument of the direct access
+    static_assert(!gen_arg_reader<test_bind::direct_args_obj, int>::direct);
+    // Types with customized type traits
+    static_assert(!gen_arg_reader<int, std::byte>::direct);
+    static_assert(!gen_arg_reader<int, script_object>::direct);
+
+    auto engine = asbind20::make_script_engine();
+    asbind_test::setup_script_string(engine, true);
+    asbind_test::setup_script_assertion(engine);
+
+    value_class<test_bind::direct_args_obj, true>(
+        engine, "direct_args_obj", AS_NAMESPACE_QUALIFIER asOBJ_APP_CLASS_ALLINTS
+    )
+        .behaviours_by_traits()
+        .constructor_function(
+            "int value, int8 offset",
+            [](void* mem, int value, std::int8_t offset)
+            {
+                new(mem) test_bind::direct_args_obj{value + offset};
+            }
+        )
+        .property("int value", &test_bind::direct_args_obj::value)
+        .method("int add_to(int64 a, direct_args_obj other, int&out) const", fp<&test_bind::direct_args_obj::add_to>)
+        .method("int objlast(double a, int8 b)", fp<&test_bind::direct_args_objlast>);
+
+    global<true>(engine)
+        .function(
+            "double mixed_args(int8 a, int64 b, float c, double d, const string&in s, bool e)",
+            fp<&test_bind::mixed_args>
+        )
+        .function(
+            "int direct_var_args(int a, const ?&in, float b)",
+            detail::to_asGENFUNC_t(
+                fp<&test_bind::direct_var_args>, detail::cc<AS_NAMESPACE_QUALIFIER asCALL_CDECL>, var_type<1>
+            )
+        );
+
+    auto* m = engine->GetModule(
+        "test_direct_args", AS_NAMESPACE_QUALIFIER asGM_ALWAYS_CREATE
+    );
+
+    m->AddScriptSection(
+        "test_direct_args.as",
+        "void main()\n"
+        "{\n"
+        "    assert(mixed_args(-2, 10000000000, 0.5f, 0.25, \"abc\", true) == 10000001001.75);\n"
+        "    assert(mixed_args(1, 2, 3.0f, 4.0, \"\", false) == 10.0);\n"
+        "    direct_args_obj a;\n"
+        "    a.value = 1;\n"
+        "    direct_args_obj b;\n"
+        "    b.value = 10;\n"
+        "    int out = 0;\n"
+        "    assert(a.add_to(100, b, out) == 111);\n"
+        "    assert(out == 111);\n"
+        "    assert(a.objlast(2.5, -3) == 0);\n"
+        "    direct_args_obj c(10, -1);\n"
+        "    assert(c.value == 9);\n"
+        "    assert(direct_var_args(1, 20, 300.5f) == 321);\n"
+        "    assert(direct_var_args(1, 2.0, 3.0f) == -1);\n"
+        "}"
+    );
+    ASSERT_GE(m->Build(), 0);
+
+    request_context ctx(engine);
+    auto* func = m->GetFunctionByDecl("void main()");
+    ASSERT_TRUE(func);
+    auto result = script_invoke<void>(ctx, func);
+    EXPECT_TRUE(result_has_value(result));
+
+    m->Discard();
+}
+
 namespace test_bind
 {
 enum class my_enum : int
@@ -532,6 +679,62 @@ TEST(TestBind, EnumUInt64)
     }
 }
 
+namespace test_bind
+{
+// No customized type traits, so the generic wrapper reads it from the stack directly
+enum class enum_int64 : std::int64_t
+{
+    big = 0x100000000LL,
+    neg = -2
+};
+
+static std::int64_t enum_int64_sum(enum_int64 e, int x, enum_int64 e2, std::int8_t y)
+{
+    return static_cast<std::int64_t>(e) + x + static_cast<std::int64_t>(e2) + y;
+}
+} // namespace test_bind
+
+TEST(TestBind, EnumInt64GenericArgs)
+{
+    using namespace asbind20;
+    using test_bind::enum_int64;
+
+    using reader = detail::gen_arg_reader<enum_int64, int, enum_int64, std::int8_t>;
+    static_assert(reader::offsets[1] == 2);
+    static_assert(reader::offsets[2] == 3);
+    static_assert(reader::offsets[3] == 5);
+
+    auto engine = make_script_engine();
+    asbind_test::setup_message_callback(engine, true);
+    asbind_test::setup_script_assertion(engine);
+
+    enum_underlying<enum_int64>(engine, "enum_int64")
+        .value("big", enum_int64::big)
+        .value("neg", enum_int64::neg);
+    global<true>(engine)
+        .function(
+            "int64 enum_int64_sum(enum_int64 e, int x, enum_int64 e2, int8 y)",
+            fp<&test_bind::enum_int64_sum>
+        );
+
+    auto* m = engine->GetModule(
+        "test_enum_int64", AS_NAMESPACE_QUALIFIER asGM_ALWAYS_CREATE
+    );
+    m->AddScriptSection(
+        "test_enum_int64.as",
+        "void main()\n"
+        "{\n"
+        "    assert(enum_int64_sum(enum_int64::big, 7, enum_int64::neg, -1) == 0x100000000 + 4);\n"
+        "    assert(enum_int64_sum(enum_int64::neg, 1, enum_int64::big, 3) == 0x100000000 + 2);\n"
+        "}"
+    );
+    ASSERT_GE(m->Build(), 0);
+
+    request_context ctx(engine);
+    auto result = script_invoke<void>(ctx, m->GetFunctionByDecl("void main()"));
+    EXPECT_TRUE(asbind_test::result_has_value(result));
+}
+
 #endif
 
 static void output_info(std::ostream& os)
@@ -252,3 +252,37 @@ TEST(BindVec2, Generic)
 
     test_bind::run_vec2_test_script(engine);
 }
+
+TEST(BindVec2, ListConstructorWithoutPattern)
+{
+    using namespace asbind20;
+
+    auto engine = make_script_engine();
+    asbind_test::setup_message_callback(engine);
+    asbind_test::setup_script_assertion(engine);
+
+    // The pattern is generated from the apply_to policy
+    value_class<test_bind::vec2, true>(
+        engine, "vec2f", test_bind::vec2_type_flags
+    )
+        .behaviours_by_traits(test_bind::vec2_type_flags | AS_NAMESPACE_QUALIFIER asGetTypeTraits<test_bind::vec2>())
+        .list_constructor<float>(use_policy<policies::apply_to<2>>)
+        .property("float x", 0)
+        .property("float y", sizeof(float));
+
+    auto* m = engine->GetModule("vec2f_test", AS_NAMESPACE_QUALIFIER asGM_ALWAYS_CREATE);
+    m->AddScriptSection(
+        "vec2f_test.as",
+        "void main()\n"
+        "{\n"
+        "    vec2f v = {1, 2};\n"
+        "    assert(v.x == 1);\n"
+        "    assert(v.y == 2);\n"
+        "}"
+    );
+    ASSERT_GE(m->Build(), 0);
+
+    request_context ctx(engine);
+    auto result = script_invoke<void>(ctx, m->GetFunctionByDecl("void main()"));
+    EXPECT_TRUE(asbind_test::result_has_value(result));
+}
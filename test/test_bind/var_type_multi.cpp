@@ -0,0 +1,98 @@
+#include <sstream>
+#include <gtest/gtest.h>
+#include <asbind_test/framework.hpp>
+#include <asbind20/asbind.hpp>
+
+namespace test_bind
+{
+static std::string describe_var(const void* ref, int type_id)
+{
+    std::ostringstream ss;
+    switch(type_id)
+    {
+    case AS_NAMESPACE_QUALIFIER asTYPEID_BOOL:
+        ss << "bool:" << (*static_cast<const bool*>(ref) ? "true" : "false");
+        break;
+    case AS_NAMESPACE_QUALIFIER asTYPEID_INT32:
+        ss << "int:" << *static_cast<const int*>(ref);
+        break;
+    case AS_NAMESPACE_QUALIFIER asTYPEID_FLOAT:
+        ss << "float:" << *static_cast<const float*>(ref);
+        break;
+    default:
+        ss << "unknown:" << type_id;
+        break;
+    }
+    return std::move(ss).str();
+}
+
+// Script declaration: string var_pair(const ?&in, int, const ?&in)
+static std::string var_pair(void* lhs, int lhs_type_id, int sep, void* rhs, int rhs_type_id)
+{
+    return describe_var(lhs, lhs_type_id) + ',' + std::to_string(sep) + ',' + describe_var(rhs, rhs_type_id);
+}
+
+class var_pair_holder
+{
+public:
+    int offset = 10;
+
+    std::string pair(void* lhs, int lhs_type_id, int sep, void* rhs, int rhs_type_id) const
+    {
+        return var_pair(lhs, lhs_type_id, sep + offset, rhs, rhs_type_id);
+    }
+};
+
+// objfirst
+static std::string var_pair_objfirst(
+    const var_pair_holder& h, void* lhs, int lhs_type_id, int sep, void* rhs, int rhs_type_id
+)
+{
+    return var_pair(lhs, lhs_type_id, sep + h.offset * 2, rhs, rhs_type_id);
+}
+
+static constexpr char var_type_multi_script[] = R"AngelScript(
+void test()
+{
+    assert(var_pair(1, 2, true) == "int:1,2,bool:true");
+    assert(var_pair(1.5f, 3, 7) == "float:1.5,3,int:7");
+
+    var_pair_holder h;
+    assert(h.pair(false, 1, 2) == "bool:false,11,int:2");
+    assert(h.pair_objfirst(4, 1, 0.5f) == "int:4,21,float:0.5");
+}
+)AngelScript";
+} // namespace test_bind
+
+TEST(VarType, MultipleArgs)
+{
+    using namespace asbind20;
+    using detail::cc;
+    using test_bind::var_pair_holder;
+
+    auto engine = make_script_engine();
+    asbind_test::setup_message_callback(engine, true);
+    asbind_test::setup_script_string(engine, true);
+    asbind_test::setup_script_assertion(engine);
+
+    global<true>(engine)
+        .function(
+            "string var_pair(const ?&in, int, const ?&in)",
+            detail::to_asGENFUNC_t(fp<&test_bind::var_pair>, cc<AS_NAMESPACE_QUALIFIER asCALL_CDECL>, var_type<0, 2>)
+        );
+
+    value_class<var_pair_holder, true>(
+        engine, "var_pair_holder", AS_NAMESPACE_QUALIFIER asOBJ_APP_CLASS_ALLINTS
+    )
+        .behaviours_by_traits()
+        .method("string pair(const ?&in, int, const ?&in) const", fp<&var_pair_holder::pair>, var_type<0, 2>)
+        .method("string pair_objfirst(const ?&in, int, const ?&in) const", fp<&test_bind::var_pair_objfirst>, var_type<0, 2>);
+
+    auto* m = engine->GetModule("test_var_type_multi", AS_NAMESPACE_QUALIFIER asGM_ALWAYS_CREATE);
+    m->AddScriptSection("test_var_type_multi.as", test_bind::var_type_multi_script);
+    ASSERT_GE(m->Build(), 0);
+
+    request_context ctx(engine);
+    auto result = script_invoke<void>(ctx, m->GetFunctionByDecl("void test()"));
+    EXPECT_TRUE(asbind_test::result_has_value(result));
+}
@@ -0,0 +1,128 @@
+#include <gtest/gtest.h>
+#include <asbind_test/framework.hpp>
+#include <atomic>
+#include <thread>
+#include <vector>
+#include <asbind20/concurrent/threading.hpp>
+#include <asbind20/concurrent/template_cache.hpp>
+
+namespace test_concurrent
+{
+static std::atomic_int cached_info_init_count = 0;
+
+struct cached_info
+{
+    explicit cached_info(AS_NAMESPACE_QUALIFIER asITypeInfo* ti)
+        : subtype_id(ti->GetSubTypeId())
+    {
+        ++cached_info_init_count;
+    }
+
+    int subtype_id;
+};
+
+struct cached_flags
+{
+    AS_NAMESPACE_QUALIFIER asQWORD flags;
+};
+
+class cached_template
+{};
+
+static void register_cached_template(AS_NAMESPACE_QUALIFIER asIScriptEngine* engine)
+{
+    asbind20::template_ref_class<cached_template>(
+        engine, "cached<T>", AS_NAMESPACE_QUALIFIER asOBJ_NOCOUNT
+    );
+}
+} // namespace test_concurrent
+
+TEST(TemplateInstanceCache, GetOrCreate)
+{
+    using namespace asbind20;
+    using test_concurrent::cached_flags;
+    using test_concurrent::cached_info;
+    using info_cache = template_instance_cache<cached_info>;
+    using flags_cache = template_instance_cache<cached_flags>;
+
+    test_concurrent::cached_info_init_count = 0;
+
+    auto engine = make_script_engine();
+    asbind_test::setup_message_callback(engine, true);
+    test_concurrent::register_cached_template(engine);
+
+    auto* int_ti = engine->GetTypeInfoByDecl("cached<int>");
+    auto* float_ti = engine->GetTypeInfoByDecl("cached<float>");
+    ASSERT_NE(int_ti, nullptr);
+    ASSERT_NE(float_ti, nullptr);
+
+    EXPECT_NE(info_cache::user_data_type(), flags_cache::user_data_type());
+    EXPECT_EQ(info_cache::get(int_ti), nullptr);
+
+    cached_info& int_info = info_cache::get_or_create(int_ti);
+    EXPECT_EQ(int_info.subtype_id, AS_NAMESPACE_QUALIFIER asTYPEID_INT32);
+    EXPECT_EQ(&info_cache::get_or_create(int_ti), &int_info);
+    EXPECT_EQ(info_cache::get(int_ti), &int_info);
+
+    EXPECT_EQ(info_cache::get_or_create(float_ti).subtype_id, AS_NAMESPACE_QUALIFIER asTYPEID_FLOAT);
+    EXPECT_EQ(test_concurrent::cached_info_init_count, 2);
+
+    // Caches of different types are stored separately
+    cached_flags& flags = flags_cache::get_or_create(
+        int_ti,
+        [](AS_NAMESPACE_QUALIFIER asITypeInfo* ti)
+        {
+            return cached_flags{ti->GetFlags()};
+        }
+    );
+    EXPECT_EQ(flags.flags, int_ti->GetFlags());
+    EXPECT_EQ(info_cache::get(int_ti), &int_info);
+}
+
+TEST(TemplateInstanceCache, MultipleThreads)
+{
+    if(!asbind20::has_threads())
+        GTEST_SKIP() << "AS_NO_THREADS";
+
+    using namespace asbind20;
+    using test_concurrent::cached_info;
+    using info_cache = template_instance_cache<cached_info>;
+
+    concurrent::prepare_multithread();
+    test_concurrent::cached_info_init_count = 0;
+
+    auto engine = make_script_engine();
+    asbind_test::setup_message_callback(engine, true);
+    test_concurrent::register_cached_template(engine);
+
+    auto* ti = engine->GetTypeInfoByDecl("cached<double>");
+    ASSERT_NE(ti, nullptr);
+
+    constexpr std::size_t thread_count = 8;
+    std::vector<cached_info*> results(thread_count, nullptr);
+    std::atomic_bool start = false;
+
+    std::vector<std::thread> threads;
+    threads.reserve(thread_count);
+    for(std::size_t i = 0; i < thread_count; ++i)
+    {
+        threads.emplace_back(
+            [&, i]()
+            {
+                concurrent::auto_thread_cleanup();
+                while(!start.load())
+                    std::this_thread::yield();
+                results[i] = &info_cache::get_or_create(ti);
+            }
+        );
+    }
+
+    start = true;
+    for(auto& t : threads)
+        t.join();
+
+    EXPECT_EQ(test_concurrent::cached_info_init_count, 1);
+    for(cached_info* p : results)
+        EXPECT_EQ(p, info_cache::get(ti));
+    EXPECT_EQ(info_cache::get(ti)->subtype_id, AS_NAMESPACE_QUALIFIER asTYPEID_DOUBLE);
+}
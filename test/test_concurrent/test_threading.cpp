@@ -2,6 +2,7 @@
 #include <asbind_test/framework.hpp>
 #include <thread>
 #include <chrono>
+#include <vector>
 #include <asbind20/concurrent/threading.hpp>
 
 TEST(Threading, AutoCleanUp)
@@ -55,3 +56,53 @@ TEST(Threading, AutoCleanUp)
     }
     EXPECT_EQ(result, 20);
 }
+
+TEST(Threading, EngineLocalLock)
+{
+    using namespace asbind20;
+
+    auto engine = make_script_engine();
+    auto other = make_script_engine();
+
+    engine_local_lock& lk = engine_local_lock::get(engine);
+    EXPECT_EQ(&engine_local_lock::get(engine), &lk);
+    EXPECT_NE(&engine_local_lock::get(other), &lk);
+
+    {
+        std::unique_lock guard(lk);
+        // Locks of other engines are independent
+        std::unique_lock other_guard(engine_local_lock::get(other), std::try_to_lock);
+        EXPECT_TRUE(other_guard.owns_lock());
+    }
+
+    {
+        std::shared_lock guard(lk);
+        std::shared_lock another_guard(lk, std::try_to_lock);
+        EXPECT_TRUE(another_guard.owns_lock());
+    }
+
+    if(!has_threads())
+        return;
+
+    concurrent::prepare_multithread();
+
+    // Creating the lock of the same engine from multiple threads
+    auto sandbox = make_script_engine();
+    std::vector<engine_local_lock*> results(8, nullptr);
+    std::vector<std::thread> threads;
+    for(std::size_t i = 0; i < results.size(); ++i)
+    {
+        threads.emplace_back(
+            [&results, &sandbox, i]()
+            {
+                concurrent::auto_thread_cleanup();
+                results[i] = &engine_local_lock::get(sandbox);
+            }
+        );
+    }
+    for(auto& t : threads)
+        t.join();
+
+    for(engine_local_lock* p : results)
+        EXPECT_EQ(p, &engine_local_lock::get(sandbox));
+}
@@ -0,0 +1,84 @@
+#include <asbind_test/framework.hpp>
+#include <gmock/gmock-matchers.h>
+#include <sstream>
+#include <asbind20/debugging/analysis.hpp>
+
+static int native_twice(int val)
+{
+    return val * 2;
+}
+
+TEST(ByteCodeAnalysis, Module)
+{
+    using namespace asbind20;
+
+    auto engine = make_script_engine();
+    asbind_test::setup_message_callback(engine);
+    global<true>(engine)
+        .function("int native_twice(int)", fp<&native_twice>);
+
+    auto* m = engine->GetModule(
+        "test", AS_NAMESPACE_QUALIFIER asGM_ALWAYS_CREATE
+    );
+    m->AddScriptSection(
+        "analysis_test.as",
+        "int helper(int i) { return native_twice(i); }\n"
+        "int no_loop() { return 42; }\n"
+        "int nested()\n"
+        "{\n"
+        "    int sum = 0;\n"
+        "    for(int i = 0; i < 10; ++i)\n"
+        "    {\n"
+        "        for(int j = 0; j < 10; ++j)\n"
+        "            sum += helper(j);\n"
+        "    }\n"
+        "    return sum;\n"
+        "}"
+    );
+    ASSERT_GE(m->Build(), 0);
+
+    auto report = debugging::analyze_module(m);
+    ASSERT_EQ(report.functions.size(), 3);
+
+    auto find = [&](std::string_view decl) -> const debugging::function_analysis&
+    {
+        auto it = std::ranges::find(report.functions, decl, &debugging::function_analysis::declaration);
+        EXPECT_NE(it, report.functions.end()) << decl;
+        return *it;
+    };
+
+    const auto& helper = find("int helper(int)");
+    ASSERT_EQ(helper.calls.size(), 1);
+    EXPECT_EQ(helper.calls[0].kind, debugging::call_kind::native);
+    EXPECT_TRUE(helper.loops.empty());
+    EXPECT_EQ(helper.section, "analysis_test.as");
+
+    const auto& no_loop = find("int no_loop()");
+    EXPECT_TRUE(no_loop.calls.empty());
+    EXPECT_DOUBLE_EQ(no_loop.estimated_cost, static_cast<double>(no_loop.instructions));
+
+    const auto& nested = find("int nested()");
+    ASSERT_EQ(nested.loops.size(), 2);
+    EXPECT_THAT(
+        nested.loops,
+        ::testing::Contains(::testing::Field(&debugging::loop_info::depth, 1))
+    );
+    ASSERT_EQ(nested.calls.size(), 1);
+    EXPECT_EQ(nested.calls[0].kind, debugging::call_kind::script);
+    EXPECT_EQ(nested.calls[0].callee, m->GetFunctionByDecl("int helper(int)"));
+    EXPECT_GT(nested.estimated_cost, static_cast<double>(nested.instructions));
+
+    std::size_t total = 0;
+    for(std::size_t c : report.histogram)
+        total += c;
+    EXPECT_EQ(total, helper.instructions + no_loop.instructions + nested.instructions);
+
+    std::stringstream json;
+    report.write_json(json);
+    EXPECT_THAT(json.str(), ::testing::HasSubstr("\"declaration\":\"int nested()\""));
+    EXPECT_THAT(json.str(), ::testing::HasSubstr("\"kind\":\"native\""));
+
+    std::stringstream csv;
+    report.write_csv(csv);
+    EXPECT_THAT(csv.str(), ::testing::HasSubstr("\"int helper(int)\",\"analysis_test.as\""));
+}
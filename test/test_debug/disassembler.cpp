@@ -0,0 +1,130 @@
+#include <asbind_test/framework.hpp>
+#include <gmock/gmock-matchers.h>
+#include <sstream>
+#include <asbind20/debugging/disassembler.hpp>
+
+static int native_twice(int val)
+{
+    return val * 2;
+}
+
+namespace test_debug
+{
+static asbind20::script_engine make_disasm_engine()
+{
+    using namespace asbind20;
+
+    auto engine = make_script_engine();
+    asbind_test::setup_message_callback(engine);
+    global<true>(engine)
+        .function("int native_twice(int)", fp<&native_twice>);
+
+    return engine;
+}
+
+static constexpr char disasm_test_script[] =
+    "int counter = 0;\n"
+    "int helper(int val) { return native_twice(val); }\n"
+    "int loop(int n)\n"
+    "{\n"
+    "    int sum = 0;\n"
+    "    for(int i = 0; i < n; ++i)\n"
+    "        sum += helper(i);\n"
+    "    counter += sum;\n"
+    "    return sum;\n"
+    "}";
+} // namespace test_debug
+
+TEST(Disassembler, Function)
+{
+    using namespace asbind20;
+    using ::testing::HasSubstr;
+
+    auto engine = test_debug::make_disasm_engine();
+    auto* m = engine->GetModule("test", AS_NAMESPACE_QUALIFIER asGM_ALWAYS_CREATE);
+    m->AddScriptSection("disasm_test.as", test_debug::disasm_test_script);
+    ASSERT_GE(m->Build(), 0);
+
+    auto* f = m->GetFunctionByDecl("int loop(int)");
+    ASSERT_NE(f, nullptr);
+
+    debugging::function_symbols syms(f);
+    EXPECT_FALSE(syms.byte_code().empty());
+
+    std::string text;
+    std::size_t count = 0;
+    debugging::disassemble_function(
+        syms,
+        [&](std::string_view line)
+        {
+            text += line;
+            text += '\n';
+            ++count;
+        }
+    );
+    EXPECT_GT(count, 0);
+    EXPECT_THAT(text, HasSubstr("int helper(int)"));
+    EXPECT_THAT(text, HasSubstr("counter"));
+#if ANGELSCRIPT_VERSION >= 23800
+    EXPECT_THAT(text, HasSubstr(":sum"));
+    EXPECT_THAT(text, HasSubstr("; disasm_test.as:"));
+#endif
+
+    // Raw operands
+    debugging::disasm_options opts;
+    opts.symbolic = false;
+    opts.lines = false;
+    std::string raw;
+    debugging::disassemble_function(
+        syms,
+        [&](std::string_view line)
+        {
+            EXPECT_FALSE(line.starts_with(';'));
+            raw += line;
+            raw += '\n';
+        },
+        opts
+    );
+    EXPECT_THAT(raw, ::testing::Not(HasSubstr("int helper(int)")));
+    EXPECT_THAT(raw, HasSubstr("func#"));
+}
+
+TEST(Disassembler, Truncation)
+{
+    using namespace asbind20;
+
+    auto engine = test_debug::make_disasm_engine();
+    auto* m = engine->GetModule("test", AS_NAMESPACE_QUALIFIER asGM_ALWAYS_CREATE);
+    m->AddScriptSection("disasm_test.as", test_debug::disasm_test_script);
+    ASSERT_GE(m->Build(), 0);
+
+    debugging::function_symbols syms(m->GetFunctionByDecl("int helper(int)"));
+
+    char buf[8];
+    std::size_t n = debugging::disassemble_instruction(buf, syms, 0);
+    EXPECT_LE(n, sizeof(buf));
+    EXPECT_GT(n, 0);
+
+    // Out of range
+    EXPECT_EQ(debugging::disassemble_instruction(buf, syms, syms.byte_code().size()), 0);
+}
+
+TEST(Disassembler, Module)
+{
+    using namespace asbind20;
+    using ::testing::HasSubstr;
+
+    auto engine = test_debug::make_disasm_engine();
+    auto* m = engine->GetModule("test", AS_NAMESPACE_QUALIFIER asGM_ALWAYS_CREATE);
+    m->AddScriptSection("disasm_test.as", test_debug::disasm_test_script);
+    ASSERT_GE(m->Build(), 0);
+
+    std::stringstream serial;
+    debugging::disassemble_module(serial, m, 1);
+    std::stringstream parallel;
+    debugging::disassemble_module(parallel, m, 4);
+
+    EXPECT_EQ(serial.str(), parallel.str());
+    EXPECT_THAT(serial.str(), HasSubstr("// int helper(int val)"));
+    EXPECT_THAT(serial.str(), HasSubstr("// int loop(int n)"));
+}
@@ -0,0 +1,127 @@
+#include <asbind_test/framework.hpp>
+#include <sstream>
+#include <asbind20/asbind.hpp>
+#include <asbind20/debugging/heap_inspector.hpp>
+
+namespace test_debug
+{
+static const asbind20::debugging::heap_entry* find_heap_entry(
+    const asbind20::debugging::heap_snapshot& snapshot,
+    std::string_view type,
+    std::string_view site_substr = {}
+)
+{
+    for(const auto& e : snapshot.entries())
+    {
+        if(e.type == type && e.site.find(site_substr) != std::string::npos)
+            return &e;
+    }
+    return nullptr;
+}
+} // namespace test_debug
+
+TEST(HeapInspector, Snapshot)
+{
+    using namespace asbind20;
+
+    auto engine = make_script_engine();
+    asbind_test::setup_message_callback(engine, true);
+    engine->SetEngineProperty(AS_NAMESPACE_QUALIFIER asEP_AUTO_GARBAGE_COLLECT, false);
+
+    auto* m = engine->GetModule("test_heap", AS_NAMESPACE_QUALIFIER asGM_ALWAYS_CREATE);
+    m->AddScriptSection(
+        "heap_test.as",
+        "class node { node@ next; }\n"
+        "void make_a(int n)\n"
+        "{\n"
+        "    for(int i = 0; i < n; ++i)\n"
+        "    {\n"
+        "        node a; @a.next = a;\n"
+        "    }\n"
+        "}\n"
+        "void make_b(int n)\n"
+        "{\n"
+        "    for(int i = 0; i < n; ++i)\n"
+        "    {\n"
+        "        node b; @b.next = b;\n"
+        "    }\n"
+        "}"
+    );
+    ASSERT_GE(m->Build(), 0);
+
+    debugging::allocation_tracker tracker;
+    auto before = debugging::take_heap_snapshot(engine, &tracker);
+
+    {
+        request_context ctx(engine);
+        ASSERT_GE(tracker.attach(ctx), 0);
+        EXPECT_EQ(tracker.attach(ctx), AS_NAMESPACE_QUALIFIER asALREADY_REGISTERED);
+
+        auto r1 = script_invoke<void>(ctx, m->GetFunctionByDecl("void make_a(int)"), 3);
+        ASSERT_TRUE(asbind_test::result_has_value(r1));
+        auto r2 = script_invoke<void>(ctx, m->GetFunctionByDecl("void make_b(int)"), 5);
+        ASSERT_TRUE(asbind_test::result_has_value(r2));
+
+        tracker.detach(ctx);
+    }
+
+    auto after = debugging::take_heap_snapshot(engine, &tracker);
+    EXPECT_EQ(after.total_count() - before.total_count(), 8);
+
+    const auto* a = test_debug::find_heap_entry(after, "node", "heap_test.as:6");
+    ASSERT_NE(a, nullptr);
+    EXPECT_EQ(a->count, 3);
+    EXPECT_EQ(a->module, "test_heap");
+    EXPECT_NE(a->site.find("make_a"), std::string::npos);
+    EXPECT_GT(a->bytes, 0);
+
+    const auto* b = test_debug::find_heap_entry(after, "node", "heap_test.as:13");
+    ASSERT_NE(b, nullptr);
+    EXPECT_EQ(b->count, 5);
+
+    auto by_module = after.aggregate(&debugging::heap_entry::module);
+    auto it = std::ranges::find(by_module, "test_heap", &debugging::heap_entry::module);
+    ASSERT_NE(it, by_module.end());
+    EXPECT_EQ(it->count, 8);
+
+    auto changes = diff(before, after);
+    ASSERT_EQ(changes.size(), 2);
+    EXPECT_EQ(changes[0].count, 5);
+    EXPECT_EQ(changes[1].count, 3);
+
+    // Round trip
+    std::stringstream ss;
+    after.write_csv(ss);
+    auto loaded = debugging::heap_snapshot::read_csv(ss);
+    EXPECT_TRUE(diff(after, loaded).empty());
+    EXPECT_EQ(loaded.total_bytes(), after.total_bytes());
+
+    engine->GarbageCollect();
+    auto collected = debugging::take_heap_snapshot(engine, &tracker);
+    EXPECT_EQ(test_debug::find_heap_entry(collected, "node"), nullptr);
+}
+
+TEST(HeapInspector, MalformedCsv)
+{
+    namespace debugging = asbind20::debugging;
+
+    const char* inputs[] = {
+        "module,type,site,count,bytes\nm,node,,abc,16\n",
+        "module,type,site,count,bytes\nm,node,,1,\n",
+        "module,type,site,count,bytes\nm,node,,-1,16\n",
+        "module,type,site,count,bytes\nm,node,,1x,16\n",
+        "module,type,site,count,bytes\nm,node,,99999999999999999999999,16\n"
+    };
+    for(const char* str : inputs)
+    {
+        std::stringstream ss(str);
+        auto snapshot = debugging::heap_snapshot::read_csv(ss);
+        EXPECT_TRUE(snapshot.entries().empty()) << str;
+    }
+
+    std::stringstream ss("module,type,site,count,bytes\nm,node,,2,16\n");
+    auto snapshot = debugging::heap_snapshot::read_csv(ss);
+    ASSERT_EQ(snapshot.entries().size(), 1);
+    EXPECT_EQ(snapshot.entries()[0].count, 2);
+    EXPECT_EQ(snapshot.entries()[0].bytes, 16);
+}
@@ -0,0 +1,63 @@
+#include <asbind_test/framework.hpp>
+#include <gmock/gmock-matchers.h>
+#include <sstream>
+#include <asbind20/debugging/profiler.hpp>
+
+TEST(SamplingProfiler, LinePeriod)
+{
+    using namespace asbind20;
+
+    auto engine = make_script_engine();
+    asbind_test::setup_message_callback(engine);
+    auto* m = engine->GetModule(
+        "test", AS_NAMESPACE_QUALIFIER asGM_ALWAYS_CREATE
+    );
+    m->AddScriptSection(
+        "profiler_test.as",
+        "int hot(int i)\n"
+        "{\n"
+        "    return i * 2;\n"
+        "}\n"
+        "int f()\n"
+        "{\n"
+        "    int sum = 0;\n"
+        "    for(int i = 0; i < 100; ++i)\n"
+        "        sum += hot(i);\n"
+        "    return sum;\n"
+        "}"
+    );
+    ASSERT_GE(m->Build(), 0);
+    auto* f = m->GetFunctionByDecl("int f()");
+    ASSERT_NE(f, nullptr);
+
+    debugging::sampling_profiler profiler(1);
+
+    {
+        request_context ctx(engine);
+        ASSERT_GE(profiler.attach(ctx), 0);
+        EXPECT_EQ(profiler.attach(ctx), AS_NAMESPACE_QUALIFIER asALREADY_REGISTERED);
+
+        auto result = script_invoke<int>(ctx, f);
+        ASSERT_TRUE(asbind_test::result_has_value(result));
+        EXPECT_EQ(result.value(), 9900);
+
+        profiler.detach(ctx);
+    }
+
+    EXPECT_GT(profiler.total_samples(), 100);
+
+    std::stringstream folded;
+    profiler.write_folded(folded, false);
+    EXPECT_THAT(
+        folded.str(),
+        ::testing::HasSubstr("profiler_test.as:int f();profiler_test.as:int hot(int)")
+    );
+
+    std::stringstream trace;
+    profiler.write_chrome_trace(trace);
+    EXPECT_THAT(trace.str(), ::testing::StartsWith("{\"traceEvents\":[{"));
+    EXPECT_THAT(trace.str(), ::testing::HasSubstr("\"ph\":\"X\""));
+
+    profiler.clear();
+    EXPECT_EQ(profiler.total_samples(), 0);
+}
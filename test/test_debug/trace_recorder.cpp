@@ -0,0 +1,174 @@
+#include <asbind_test/framework.hpp>
+#include <gmock/gmock-matchers.h>
+#include <sstream>
+#include <asbind20/asbind.hpp>
+#include <asbind20/debugging/trace_recorder.hpp>
+
+static int traced_twice(int val)
+{
+    return val * 2;
+}
+
+namespace test_debug
+{
+static std::vector<asbind20::debugging::trace_event_kind> trace_kinds(
+    const std::vector<asbind20::debugging::trace_event>& events
+)
+{
+    std::vector<asbind20::debugging::trace_event_kind> result;
+    for(const auto& e : events)
+        result.push_back(e.kind);
+    return result;
+}
+} // namespace test_debug
+
+TEST(TraceRecorder, Calls)
+{
+    using namespace asbind20;
+    using kind = debugging::trace_event_kind;
+
+    auto engine = make_script_engine();
+    asbind_test::setup_message_callback(engine, true);
+
+    auto& recorder = debugging::trace_recorder::get_or_create(engine);
+    EXPECT_EQ(debugging::trace_recorder::get(engine), &recorder);
+
+    global<true, debugging::tracing_listener>(engine)
+        .function("int traced_twice(int)", fp<&traced_twice>);
+
+    auto* m = engine->GetModule("test", AS_NAMESPACE_QUALIFIER asGM_ALWAYS_CREATE);
+    m->AddScriptSection(
+        "trace_test.as",
+        "int helper(int val)\n"
+        "{\n"
+        "    return traced_twice(val);\n"
+        "}\n"
+        "int run()\n"
+        "{\n"
+        "    int result = helper(21);\n"
+        "    return result;\n"
+        "}"
+    );
+    ASSERT_GE(m->Build(), 0);
+
+    auto* run = m->GetFunctionByDecl("int run()");
+    auto* helper = m->GetFunctionByDecl("int helper(int)");
+
+    request_context ctx(engine);
+    ASSERT_GE(recorder.attach(ctx), 0);
+    ASSERT_GE(ctx->Prepare(run), 0);
+    ASSERT_EQ(recorder.execute(ctx), AS_NAMESPACE_QUALIFIER asEXECUTION_FINISHED);
+    EXPECT_EQ(ctx->GetReturnDWord(), 42);
+
+    std::vector<debugging::trace_event> events;
+    recorder.drain(events);
+    EXPECT_THAT(
+        test_debug::trace_kinds(events),
+        ::testing::ElementsAre(
+            kind::script_enter,
+            kind::script_enter,
+            kind::native_enter,
+            kind::native_exit,
+            kind::script_exit,
+            kind::script_exit
+        )
+    );
+    ASSERT_EQ(events.size(), 6);
+    EXPECT_EQ(events[0].id, run->GetId());
+    EXPECT_EQ(events[1].id, helper->GetId());
+    EXPECT_EQ(events[4].id, helper->GetId());
+    EXPECT_EQ(events[5].id, run->GetId());
+    for(std::size_t i = 1; i < events.size(); ++i)
+        EXPECT_LE(events[i - 1].timestamp_ns, events[i].timestamp_ns);
+    EXPECT_EQ(recorder.dropped(), 0);
+
+    // Already drained
+    events.clear();
+    EXPECT_EQ(recorder.drain(events), 0);
+
+    recorder.set_enabled(false);
+    ASSERT_GE(ctx->Prepare(run), 0);
+    recorder.execute(ctx);
+    EXPECT_EQ(recorder.drain(events), 0);
+
+    recorder.detach(ctx);
+}
+
+TEST(TraceRecorder, ExceptionAndChromeTrace)
+{
+    using namespace asbind20;
+    using ::testing::HasSubstr;
+
+    auto engine = make_script_engine();
+    asbind_test::setup_message_callback(engine, true);
+
+    debugging::trace_recorder recorder(engine);
+
+    auto* m = engine->GetModule("test", AS_NAMESPACE_QUALIFIER asGM_ALWAYS_CREATE);
+    m->AddScriptSection(
+        "trace_test.as",
+        "void fail()\n"
+        "{\n"
+        "    int zero = 0;\n"
+        "    int val = 1 / zero;\n"
+        "}"
+    );
+    ASSERT_GE(m->Build(), 0);
+
+    std::stringstream flushed;
+    recorder.start(flushed, std::chrono::milliseconds(1));
+    EXPECT_TRUE(recorder.running());
+
+    request_context ctx(engine);
+    ASSERT_GE(recorder.attach(ctx), 0);
+    ASSERT_GE(ctx->Prepare(m->GetFunctionByDecl("void fail()")), 0);
+    EXPECT_EQ(recorder.execute(ctx), AS_NAMESPACE_QUALIFIER asEXECUTION_EXCEPTION);
+    recorder.detach(ctx);
+
+    recorder.stop();
+    EXPECT_FALSE(recorder.running());
+
+    const std::string json = flushed.str();
+    EXPECT_TRUE(json.starts_with('['));
+    EXPECT_THAT(json, HasSubstr("\"name\":\"void fail()\""));
+    EXPECT_THAT(json, HasSubstr("Divide by zero"));
+    EXPECT_THAT(json, HasSubstr("\"ph\":\"i\""));
+
+    std::stringstream complete;
+    recorder.write_chrome_trace(complete);
+    EXPECT_THAT(complete.str(), HasSubstr("traceEvents"));
+}
+
+TEST(TraceRecorder, DestroyEngineWithoutDetaching)
+{
+    using namespace asbind20;
+
+    auto engine = make_script_engine();
+    asbind_test::setup_message_callback(engine, true);
+
+    auto& recorder = debugging::trace_recorder::get_or_create(engine);
+
+    auto* m = engine->GetModule("test", AS_NAMESPACE_QUALIFIER asGM_ALWAYS_CREATE);
+    m->AddScriptSection(
+        "trace_test.as",
+        "int run() { return 42; }"
+    );
+    ASSERT_GE(m->Build(), 0);
+
+    {
+        request_context ctx(engine);
+        ASSERT_GE(recorder.attach(ctx), 0);
+        ASSERT_GE(ctx->Prepare(m->GetFunctionByDecl("int run()")), 0);
+        ASSERT_EQ(recorder.execute(ctx), AS_NAMESPACE_QUALIFIER asEXECUTION_FINISHED);
+    }
+
+    {
+        auto* ctx = engine->CreateContext();
+        ASSERT_GE(recorder.attach(ctx), 0);
+        ctx->Release();
+    }
+
+    // The recorder is destroyed after the contexts, and it shouldn't access them
+    engine.reset();
+    EXPECT_EQ(engine.get(), nullptr);
+}
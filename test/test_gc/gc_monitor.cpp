@@ -0,0 +1,108 @@
+#include <algorithm>
+#include <cstring>
+#include <asbind_test/framework.hpp>
+#include <asbind20/asbind.hpp>
+#include <asbind20/debugging/gc_monitor.hpp>
+
+TEST(PauseHistogram, Percentile)
+{
+    asbind20::debugging::pause_histogram h;
+    EXPECT_EQ(h.count(), 0);
+    EXPECT_EQ(h.percentile(50), 0);
+
+    for(std::uint64_t i = 1; i <= 1000; ++i)
+        h.record(i * 1000);
+
+    EXPECT_EQ(h.count(), 1000);
+    EXPECT_EQ(h.min(), 1000);
+    EXPECT_EQ(h.max(), 1000000);
+    EXPECT_DOUBLE_EQ(h.mean(), 500500.0);
+
+    // Relative error is bounded by 1/16
+    auto p50 = static_cast<double>(h.percentile(50));
+    EXPECT_NEAR(p50, 500000.0, 500000.0 / 16);
+    auto p99 = static_cast<double>(h.percentile(99));
+    EXPECT_NEAR(p99, 990000.0, 990000.0 / 16);
+    EXPECT_EQ(h.percentile(100), 1000000);
+
+    std::uint64_t total = 0;
+    h.for_each_bucket(
+        [&](std::uint64_t lower, std::uint64_t upper, std::uint64_t count)
+        {
+            EXPECT_LE(lower, upper);
+            total += count;
+        }
+    );
+    EXPECT_EQ(total, 1000);
+
+    h.clear();
+    EXPECT_EQ(h.count(), 0);
+    EXPECT_EQ(h.max(), 0);
+}
+
+TEST(GCMonitor, Collect)
+{
+    auto engine = asbind20::make_script_engine();
+    asbind_test::setup_message_callback(engine, true);
+    // Control the timing of collection manually
+    engine->SetEngineProperty(AS_NAMESPACE_QUALIFIER asEP_AUTO_GARBAGE_COLLECT, false);
+
+    auto* m = engine->GetModule("test", AS_NAMESPACE_QUALIFIER asGM_ALWAYS_CREATE);
+    m->AddScriptSection(
+        "test_gc_monitor",
+        "class node { node@ next; }\n"
+        "void make_cycles(int n)\n"
+        "{\n"
+        "    for(int i = 0; i < n; ++i)\n"
+        "    {\n"
+        "        node a; node b;\n"
+        "        @a.next = b; @b.next = a;\n"
+        "    }\n"
+        "}"
+    );
+    ASSERT_GE(m->Build(), 0);
+
+    asbind20::debugging::gc_monitor monitor(engine, 4);
+
+    {
+        asbind20::request_context ctx(engine);
+        auto result = asbind20::script_invoke<void>(
+            ctx, m->GetFunctionByDecl("void make_cycles(int)"), 10
+        );
+        ASSERT_TRUE(asbind_test::result_has_value(result));
+    }
+
+    const auto& before = monitor.sample();
+    EXPECT_GE(before.births, 20);
+    EXPECT_EQ(before.pause.count(), 0);
+
+    auto find_node = [](const auto& live)
+    {
+        return std::ranges::find_if(
+            live,
+            [](const auto& p)
+            { return std::strcmp(p.first->GetName(), "node") == 0; }
+        );
+    };
+
+    auto live = monitor.live_objects_by_type();
+    auto it = find_node(live);
+    ASSERT_NE(it, live.end());
+    EXPECT_EQ(it->second, 20);
+
+    EXPECT_GE(monitor.collect(), 0);
+    const auto& after = monitor.samples().back();
+    EXPECT_GE(after.deaths, 20);
+    EXPECT_EQ(monitor.pauses().count(), 1);
+    live = monitor.live_objects_by_type();
+    EXPECT_EQ(find_node(live), live.end());
+
+    // The time series is bounded
+    for(int i = 0; i < 10; ++i)
+        monitor.sample();
+    EXPECT_EQ(monitor.samples().size(), 4);
+
+    monitor.reset();
+    EXPECT_TRUE(monitor.samples().empty());
+    EXPECT_EQ(monitor.pauses().count(), 0);
+}
@@ -0,0 +1,161 @@
+#include <asbind_test/framework.hpp>
+#include <asbind20/asbind.hpp>
+#include <asbind20/gc_scheduler.hpp>
+
+namespace test_gc
+{
+class gc_scheduler_suite : public ::testing::Test
+{
+public:
+    void SetUp() override
+    {
+        m_engine = asbind20::make_script_engine();
+        asbind_test::setup_message_callback(m_engine, true);
+
+        auto* m = m_engine->GetModule("test", AS_NAMESPACE_QUALIFIER asGM_ALWAYS_CREATE);
+        m->AddScriptSection(
+            "test_gc_scheduler",
+            "class node { node@ next; }\n"
+            "void make_cycles(int n)\n"
+            "{\n"
+            "    for(int i = 0; i < n; ++i)\n"
+            "    {\n"
+            "        node a; node b;\n"
+            "        @a.next = b; @b.next = a;\n"
+            "    }\n"
+            "}"
+        );
+        ASSERT_GE(m->Build(), 0);
+    }
+
+    void TearDown() override
+    {
+        m_engine.reset();
+    }
+
+    void make_cycles(int n)
+    {
+        auto* m = m_engine->GetModule("test");
+        asbind20::request_context ctx(m_engine);
+        auto result = asbind20::script_invoke<void>(
+            ctx, m->GetFunctionByDecl("void make_cycles(int)"), n
+        );
+        ASSERT_TRUE(asbind_test::result_has_value(result));
+    }
+
+    auto get_engine() const
+    {
+        return m_engine.get();
+    }
+
+private:
+    asbind20::script_engine m_engine;
+};
+} // namespace test_gc
+
+using test_gc::gc_scheduler_suite;
+
+TEST_F(gc_scheduler_suite, incremental)
+{
+    asbind20::gc_scheduler_options opts;
+    opts.new_objects_threshold = 0;
+    opts.growth_factor = 0;
+
+    asbind20::gc_scheduler scheduler(get_engine(), opts);
+    EXPECT_FALSE(get_engine()->GetEngineProperty(AS_NAMESPACE_QUALIFIER asEP_AUTO_GARBAGE_COLLECT));
+
+    make_cycles(50);
+    EXPECT_FALSE(scheduler.should_escalate());
+
+    std::size_t destroyed = 0;
+    for(int i = 0; i < 1000 && destroyed < 100; ++i)
+    {
+        auto result = scheduler.run_frame(std::chrono::microseconds(100));
+        EXPECT_FALSE(result.full_cycle);
+        EXPECT_GE(result.steps, 1);
+        destroyed += result.destroyed;
+    }
+    EXPECT_EQ(destroyed, 100);
+    EXPECT_GT(scheduler.estimated_step_cost().count(), 0);
+    EXPECT_GT(scheduler.frame_times().count(), 0);
+}
+
+TEST_F(gc_scheduler_suite, escalation)
+{
+    asbind20::gc_scheduler_options opts;
+    opts.new_objects_threshold = 10;
+
+    {
+        asbind20::gc_scheduler scheduler(get_engine(), opts);
+
+        make_cycles(20);
+        EXPECT_TRUE(scheduler.should_escalate());
+
+        auto result = scheduler.run_frame();
+        EXPECT_TRUE(result.full_cycle);
+        EXPECT_FALSE(result.deferred);
+        EXPECT_EQ(result.destroyed, 40);
+        EXPECT_FALSE(scheduler.should_escalate());
+    }
+
+    // The property is restored
+    EXPECT_TRUE(get_engine()->GetEngineProperty(AS_NAMESPACE_QUALIFIER asEP_AUTO_GARBAGE_COLLECT));
+}
+
+TEST_F(gc_scheduler_suite, background_detection)
+{
+    if(!asbind20::has_threads())
+        GTEST_SKIP() << "AS_NO_THREADS";
+
+    asbind20::gc_scheduler_options opts;
+    opts.new_objects_threshold = 0;
+    opts.growth_factor = 0;
+    opts.background_detection = true;
+    opts.background_interval = std::chrono::milliseconds(1);
+
+    asbind20::gc_scheduler scheduler(get_engine(), opts);
+    EXPECT_TRUE(scheduler.background_running());
+
+    make_cycles(10);
+
+    std::size_t destroyed = 0;
+    for(int i = 0; i < 1000 && destroyed < 20; ++i)
+    {
+        destroyed += scheduler.run_frame().destroyed;
+        std::this_thread::sleep_for(std::chrono::milliseconds(1));
+    }
+    EXPECT_EQ(destroyed, 20);
+}
+
+TEST_F(gc_scheduler_suite, background_escalation)
+{
+    if(!asbind20::has_threads())
+        GTEST_SKIP() << "AS_NO_THREADS";
+
+    asbind20::gc_scheduler_options opts;
+    opts.new_objects_threshold = 10;
+    opts.background_detection = true;
+    opts.background_interval = std::chrono::milliseconds(1);
+
+    asbind20::gc_scheduler scheduler(get_engine(), opts);
+    EXPECT_TRUE(scheduler.background_running());
+
+    make_cycles(20);
+    EXPECT_TRUE(scheduler.should_escalate());
+
+    // The escalation is kept until the full cycle actually runs
+    std::size_t destroyed = 0;
+    bool completed = false;
+    for(int i = 0; i < 1000 && !completed; ++i)
+    {
+        auto result = scheduler.run_frame();
+        destroyed += result.destroyed;
+        if(result.full_cycle && !result.deferred)
+            completed = true;
+        else
+            EXPECT_TRUE(scheduler.should_escalate());
+    }
+    EXPECT_TRUE(completed);
+    EXPECT_EQ(destroyed, 40);
+    EXPECT_FALSE(scheduler.should_escalate());
+}
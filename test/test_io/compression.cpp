@@ -0,0 +1,182 @@
+#include <asbind_test/framework.hpp>
+#include <asbind20/io/compression.hpp>
+#include <sstream>
+#include <random>
+
+namespace test_io
+{
+static std::vector<std::byte> make_test_data(std::size_t size, unsigned int alphabet)
+{
+    std::mt19937 rng(42);
+    std::vector<std::byte> result(size);
+    for(auto& b : result)
+        b = static_cast<std::byte>(rng() % alphabet);
+    return result;
+}
+
+static auto build_test_module(AS_NAMESPACE_QUALIFIER asIScriptEngine* engine)
+    -> AS_NAMESPACE_QUALIFIER asIScriptModule*
+{
+    auto* m = engine->GetModule("test", AS_NAMESPACE_QUALIFIER asGM_ALWAYS_CREATE);
+    m->AddScriptSection(
+        "test.as",
+        "int f(int add) { return 1000 + add; }\n"
+        "int g(int add) { return 1000 + add; }\n"
+        "int h(int add) { return 1000 + add; }"
+    );
+    if(m->Build() < 0)
+    {
+        ADD_FAILURE() << "Build failed";
+        return nullptr;
+    }
+
+    return m;
+}
+
+static void check_test_module(AS_NAMESPACE_QUALIFIER asIScriptModule* m)
+{
+    auto* f = m->GetFunctionByDecl("int f(int)");
+    ASSERT_NE(f, nullptr);
+
+    asbind20::request_context ctx(m->GetEngine());
+    auto result = asbind20::script_invoke<int>(ctx, f, 13);
+    ASSERT_TRUE(asbind_test::result_has_value(result));
+    EXPECT_EQ(result.value(), 1013);
+}
+} // namespace test_io
+
+TEST(TestLZ, RoundTrip)
+{
+    using namespace asbind20::io;
+
+    for(std::size_t size : {0, 1, 12, 13, 100, 4096, 70000})
+    {
+        for(unsigned int alphabet : {2u, 16u, 256u})
+        {
+            auto src = test_io::make_test_data(size, alphabet);
+            std::vector<std::byte> packed(lz::compress_bound(src.size()));
+            packed.resize(lz::compress(src, packed));
+
+            std::vector<std::byte> unpacked(src.size());
+            EXPECT_TRUE(lz::decompress(packed, unpacked))
+                << "size = " << size << ", alphabet = " << alphabet;
+            EXPECT_EQ(src, unpacked)
+                << "size = " << size << ", alphabet = " << alphabet;
+
+            if(alphabet == 2u && size >= 4096)
+            {
+                EXPECT_LT(packed.size(), src.size());
+            }
+        }
+    }
+}
+
+TEST(TestLZ, InvalidInput)
+{
+    using namespace asbind20::io;
+
+    auto src = test_io::make_test_data(1000, 4);
+    std::vector<std::byte> packed(lz::compress_bound(src.size()));
+    packed.resize(lz::compress(src, packed));
+
+    // Wrong output size
+    std::vector<std::byte> unpacked(src.size() - 1);
+    EXPECT_FALSE(lz::decompress(packed, unpacked));
+
+    // Truncated input
+    unpacked.resize(src.size());
+    EXPECT_FALSE(lz::decompress(std::span(packed).first(packed.size() / 2), unpacked));
+}
+
+TEST(TestIO, BufferedStreamWrapper)
+{
+    using namespace asbind20;
+
+    std::stringstream ss;
+
+    {
+        auto engine = make_script_engine();
+        asbind_test::setup_message_callback(engine);
+
+        auto* m = test_io::build_test_module(engine);
+        ASSERT_NE(m, nullptr);
+
+        io::buffered_ostream_wrapper<16> wrapper(ss);
+        ASSERT_GE(m->SaveByteCode(&wrapper), 0);
+        ASSERT_GE(wrapper.flush(), 0);
+    }
+    ss << "tail";
+
+    {
+        auto engine = make_script_engine();
+        asbind_test::setup_message_callback(engine);
+
+        auto* m = engine->GetModule("test", AS_NAMESPACE_QUALIFIER asGM_ALWAYS_CREATE);
+        io::buffered_istream_wrapper<16> wrapper(ss);
+        ASSERT_GE(m->LoadByteCode(&wrapper), 0);
+        ASSERT_GE(wrapper.sync(), 0);
+
+        test_io::check_test_module(m);
+
+        std::string tail;
+        ss >> tail;
+        EXPECT_EQ(tail, "tail");
+    }
+}
+
+TEST(TestIO, CompressedByteCode)
+{
+    using namespace asbind20;
+
+    for(auto method : {io::compression::none, io::compression::lz})
+    {
+        std::stringstream ss;
+        std::vector<std::byte> buf;
+
+        {
+            auto engine = make_script_engine();
+            asbind_test::setup_message_callback(engine);
+
+            auto* m = test_io::build_test_module(engine);
+            ASSERT_NE(m, nullptr);
+
+            ASSERT_GE(save_byte_code_compressed(ss, m, false, method), 0);
+            ASSERT_GE(save_byte_code_compressed(std::back_inserter(buf), m, true, method), 0);
+        }
+
+        {
+            auto engine = make_script_engine();
+            asbind_test::setup_message_callback(engine);
+
+            auto* m = engine->GetModule("test", AS_NAMESPACE_QUALIFIER asGM_ALWAYS_CREATE);
+            auto [r, debug_info_stripped] = load_byte_code_compressed(ss, m);
+            ASSERT_GE(r, 0);
+            EXPECT_FALSE(debug_info_stripped);
+            test_io::check_test_module(m);
+        }
+
+        {
+            auto engine = make_script_engine();
+            asbind_test::setup_message_callback(engine);
+
+            auto* m = engine->GetModule("test", AS_NAMESPACE_QUALIFIER asGM_ALWAYS_CREATE);
+            auto [r, debug_info_stripped] = load_byte_code_compressed(buf, m);
+            ASSERT_GE(r, 0);
+            EXPECT_TRUE(debug_info_stripped);
+            test_io::check_test_module(m);
+        }
+    }
+}
+
+TEST(TestIO, CompressedByteCodeInvalidHeader)
+{
+    using namespace asbind20;
+
+    auto engine = make_script_engine();
+    asbind_test::setup_message_callback(engine);
+
+    auto* m = engine->GetModule("test", AS_NAMESPACE_QUALIFIER asGM_ALWAYS_CREATE);
+    std::stringstream ss("not compressed byte code");
+    auto result = load_byte_code_compressed(ss, m);
+    EXPECT_FALSE(result);
+}
@@ -0,0 +1,104 @@
+#include <asbind_test/framework.hpp>
+#include <asbind20/io/module_builder.hpp>
+#include <asbind20/concurrent/threading.hpp>
+#include <filesystem>
+#include <fstream>
+
+namespace test_io
+{
+class module_builder_suite : public ::testing::Test
+{
+public:
+    void SetUp() override
+    {
+        m_dir = std::filesystem::temp_directory_path() / "asbind20_test_module_builder";
+        std::filesystem::remove_all(m_dir);
+        std::filesystem::create_directories(m_dir);
+    }
+
+    void TearDown() override
+    {
+        std::error_code ec;
+        std::filesystem::remove_all(m_dir, ec);
+    }
+
+    std::filesystem::path write_file(const std::string& name, std::string_view code)
+    {
+        auto p = m_dir / name;
+        std::ofstream ofs(p, std::ios_base::binary | std::ios_base::trunc);
+        ofs << code;
+        return p;
+    }
+
+    const std::filesystem::path& dir() const noexcept
+    {
+        return m_dir;
+    }
+
+private:
+    std::filesystem::path m_dir;
+};
+
+static int call_f(AS_NAMESPACE_QUALIFIER asIScriptModule* m)
+{
+    auto* f = m->GetFunctionByDecl("int f()");
+    if(!f)
+    {
+        ADD_FAILURE() << "\"int f()\" not found";
+        return -1;
+    }
+
+    asbind20::request_context ctx(m->GetEngine());
+    auto result = asbind20::script_invoke<int>(ctx, f);
+    EXPECT_TRUE(asbind_test::result_has_value(result));
+    return result.value_or(-1);
+}
+} // namespace test_io
+
+using ModuleBuilder = test_io::module_builder_suite;
+
+TEST_F(ModuleBuilder, BuildModules)
+{
+    unsigned int thread_count = 4;
+    if(!asbind20::has_threads())
+        thread_count = 1;
+    else
+        asbind20::concurrent::prepare_multithread();
+
+    auto engine = asbind20::make_script_engine();
+
+    auto common = write_file("common.as", "int g() { return 1000; }");
+    std::vector<asbind20::io::module_spec> specs;
+    for(int i = 0; i < 16; ++i)
+    {
+        auto file = write_file(
+            "m" + std::to_string(i) + ".as",
+            "int f() { return g() + " + std::to_string(i) + "; }"
+        );
+        specs.push_back({"m" + std::to_string(i), {common, file}});
+    }
+    specs.push_back({"bad", {write_file("bad.as", "int f() { return not_exist(); }")}});
+    specs.push_back({"missing", {dir() / "not_exist.as"}});
+
+    auto results = asbind20::io::build_modules(engine, specs, thread_count);
+    ASSERT_EQ(results.size(), specs.size());
+
+    for(int i = 0; i < 16; ++i)
+    {
+        const auto& r = results[i];
+        ASSERT_TRUE(r) << specs[i].name;
+        EXPECT_EQ(r.error_count(), 0);
+        EXPECT_EQ(r.module, engine->GetModule(specs[i].name.c_str()));
+        EXPECT_EQ(test_io::call_f(r.module), 1000 + i);
+    }
+
+    const auto& bad = results[16];
+    EXPECT_FALSE(bad);
+    EXPECT_GT(bad.error_count(), 0);
+    EXPECT_EQ(bad.diagnostics.front().section, specs[16].files[0].string());
+
+    const auto& missing = results[17];
+    EXPECT_FALSE(missing);
+    EXPECT_EQ(missing.module, nullptr);
+    EXPECT_EQ(missing.error_count(), 1);
+}
@@ -0,0 +1,280 @@
+#include <asbind_test/framework.hpp>
+#include <asbind20/io/module_cache.hpp>
+#include <filesystem>
+
+namespace test_io
+{
+static int add_one(int val)
+{
+    return val + 1;
+}
+
+static int call_f(AS_NAMESPACE_QUALIFIER asIScriptModule* m)
+{
+    auto* f = m->GetFunctionByDecl("int f()");
+    if(!f)
+    {
+        ADD_FAILURE() << "\"int f()\" not found";
+        return -1;
+    }
+
+    asbind20::request_context ctx(m->GetEngine());
+    auto result = asbind20::script_invoke<int>(ctx, f);
+    EXPECT_TRUE(asbind_test::result_has_value(result));
+    return result.value();
+}
+
+class module_cache_suite : public ::testing::Test
+{
+public:
+    void SetUp() override
+    {
+        m_dir = std::filesystem::temp_directory_path() / "asbind20_test_module_cache";
+        std::filesystem::remove_all(m_dir);
+    }
+
+    void TearDown() override
+    {
+        std::error_code ec;
+        std::filesystem::remove_all(m_dir, ec);
+    }
+
+    const std::filesystem::path& cache_dir() const noexcept
+    {
+        return m_dir;
+    }
+
+    static asbind20::script_engine make_engine(bool register_extra = false)
+    {
+        auto engine = asbind20::make_script_engine();
+        asbind_test::setup_message_callback(engine);
+        asbind20::global<true>(engine)
+            .function("int add_one(int val)", asbind20::fp<&add_one>);
+        if(register_extra)
+        {
+            asbind20::global<true>(engine)
+                .function("int add_two(int val)", [](int val)
+                          { return val + 2; });
+        }
+        return engine;
+    }
+
+private:
+    std::filesystem::path m_dir;
+};
+} // namespace test_io
+
+using ModuleCache = test_io::module_cache_suite;
+
+TEST_F(ModuleCache, HitAndMiss)
+{
+    const asbind20::io::script_section sections[] = {
+        {"a.as", "int g() { return add_one(1012); }"},
+        {"b.as", "int f() { return g(); }"}
+    };
+
+    {
+        auto engine = make_engine();
+        asbind20::io::module_cache cache(cache_dir());
+
+        auto* m = engine->GetModule("test", AS_NAMESPACE_QUALIFIER asGM_ALWAYS_CREATE);
+        auto result = cache.build(m, sections);
+        ASSERT_TRUE(result);
+        EXPECT_FALSE(result.cache_hit);
+        EXPECT_EQ(test_io::call_f(m), 1013);
+    }
+
+    {
+        auto engine = make_engine();
+        asbind20::io::module_cache cache(cache_dir());
+
+        auto* m = engine->GetModule("test", AS_NAMESPACE_QUALIFIER asGM_ALWAYS_CREATE);
+        auto result = cache.build(m, sections);
+        ASSERT_TRUE(result);
+        EXPECT_TRUE(result.cache_hit);
+        EXPECT_EQ(test_io::call_f(m), 1013);
+    }
+
+    // Changed source
+    {
+        auto engine = make_engine();
+        asbind20::io::module_cache cache(cache_dir());
+
+        const asbind20::io::script_section changed[] = {
+            {"a.as", "int g() { return add_one(41); }"},
+            {"b.as", "int f() { return g(); }"}
+        };
+
+        auto* m = engine->GetModule("test", AS_NAMESPACE_QUALIFIER asGM_ALWAYS_CREATE);
+        auto result = cache.build(m, changed);
+        ASSERT_TRUE(result);
+        EXPECT_FALSE(result.cache_hit);
+        EXPECT_EQ(test_io::call_f(m), 42);
+    }
+}
+
+TEST_F(ModuleCache, InterfaceChanged)
+{
+    const asbind20::io::script_section sections[] = {
+        {"test.as", "int f() { return add_one(1012); }"}
+    };
+
+    auto engine = make_engine();
+    auto engine_extra = make_engine(true);
+    EXPECT_NE(
+        asbind20::io::interface_digest(engine),
+        asbind20::io::interface_digest(engine_extra)
+    );
+
+    asbind20::io::module_cache cache(cache_dir());
+    EXPECT_NE(
+        cache.compute_key(engine, sections),
+        cache.compute_key(engine_extra, sections)
+    );
+
+    {
+        auto* m = engine->GetModule("test", AS_NAMESPACE_QUALIFIER asGM_ALWAYS_CREATE);
+        auto result = cache.build(m, sections);
+        ASSERT_TRUE(result);
+        EXPECT_FALSE(result.cache_hit);
+    }
+
+    {
+        auto* m = engine_extra->GetModule("test", AS_NAMESPACE_QUALIFIER asGM_ALWAYS_CREATE);
+        auto result = cache.build(m, sections);
+        ASSERT_TRUE(result);
+        EXPECT_FALSE(result.cache_hit);
+        EXPECT_EQ(test_io::call_f(m), 1013);
+    }
+
+    // Registering after the first build
+    auto key_before = cache.compute_key(engine, sections);
+    asbind20::global<true>(engine)
+        .function("int add_two(int val)", [](int val)
+                  { return val + 2; });
+    EXPECT_NE(key_before, cache.compute_key(engine, sections));
+}
+
+TEST_F(ModuleCache, CorruptedCache)
+{
+    const asbind20::io::script_section sections[] = {
+        {"test.as", "int f() { return add_one(1012); }"}
+    };
+
+    auto engine = make_engine();
+    asbind20::io::module_cache cache(cache_dir());
+
+    std::filesystem::create_directories(cache_dir());
+    {
+        std::ofstream ofs(
+            cache.cache_file(cache.compute_key(engine, sections)),
+            std::ios_base::binary
+        );
+        ofs << "not byte code";
+    }
+
+    auto* m = engine->GetModule("test", AS_NAMESPACE_QUALIFIER asGM_ALWAYS_CREATE);
+    auto result = cache.build(m, sections);
+    ASSERT_TRUE(result);
+    EXPECT_FALSE(result.cache_hit);
+    EXPECT_EQ(test_io::call_f(m), 1013);
+}
+
+TEST_F(ModuleCache, EngineProperties)
+{
+    const asbind20::io::script_section sections[] = {
+        {"test.as", "int f() { return add_one(1012); }"}
+    };
+
+    auto engine = make_engine();
+    asbind20::io::module_cache cache(cache_dir());
+    auto key = cache.compute_key(engine, sections);
+
+    // Properties only affecting the execution
+    engine->SetEngineProperty(AS_NAMESPACE_QUALIFIER asEP_AUTO_GARBAGE_COLLECT, false);
+    engine->SetEngineProperty(AS_NAMESPACE_QUALIFIER asEP_MAX_STACK_SIZE, 1024 * 1024);
+    engine->SetEngineProperty(AS_NAMESPACE_QUALIFIER asEP_INIT_CALL_STACK_SIZE, 32);
+    EXPECT_EQ(key, cache.compute_key(engine, sections));
+
+    // Properties affecting the compilation
+    engine->SetEngineProperty(AS_NAMESPACE_QUALIFIER asEP_REQUIRE_ENUM_SCOPE, true);
+    EXPECT_NE(key, cache.compute_key(engine, sections));
+}
+
+TEST_F(ModuleCache, PinInterface)
+{
+    const asbind20::io::script_section sections[] = {
+        {"test.as", "int f() { return add_one(1012); }"}
+    };
+
+    auto engine = make_engine();
+    asbind20::io::module_cache cache(cache_dir());
+
+    // Re-registering a config group with the same shape
+    engine->BeginConfigGroup("extra");
+    asbind20::global<true>(engine)
+        .function("int extra(int val)", [](int val)
+                  { return val + 2; });
+    engine->EndConfigGroup();
+    auto key_before = cache.compute_key(engine, sections);
+
+    engine->RemoveConfigGroup("extra");
+    engine->BeginConfigGroup("extra");
+    asbind20::global<true>(engine)
+        .function("float extra(float val)", [](float val)
+                  { return val + 2; });
+    engine->EndConfigGroup();
+    auto key_after = cache.compute_key(engine, sections);
+    EXPECT_NE(key_before, key_after);
+
+    cache.pin_interface(engine);
+    EXPECT_EQ(key_after, cache.compute_key(engine, sections));
+
+    // The pinned digest won't be updated until invalidated
+    asbind20::global<true>(engine)
+        .function("int add_two(int val)", [](int val)
+                  { return val + 2; });
+    EXPECT_EQ(key_after, cache.compute_key(engine, sections));
+    cache.invalidate_interface();
+    EXPECT_NE(key_after, cache.compute_key(engine, sections));
+}
+
+TEST_F(ModuleCache, TruncatedCache)
+{
+    const asbind20::io::script_section sections[] = {
+        {"test.as", "int f() { return add_one(1012); }"}
+    };
+
+    auto engine = make_engine();
+    asbind20::io::module_cache cache(cache_dir());
+    const auto filename = cache.cache_file(cache.compute_key(engine, sections));
+
+    {
+        auto* m = engine->GetModule("test", AS_NAMESPACE_QUALIFIER asGM_ALWAYS_CREATE);
+        auto result = cache.build(m, sections);
+        ASSERT_TRUE(result);
+        EXPECT_FALSE(result.cache_hit);
+    }
+
+    // No temporary file is left
+    for(const auto& entry : std::filesystem::directory_iterator(cache_dir()))
+        EXPECT_EQ(entry.path(), filename);
+
+    std::filesystem::resize_file(filename, std::filesystem::file_size(filename) / 2);
+    {
+        auto* m = engine->GetModule("test", AS_NAMESPACE_QUALIFIER asGM_ALWAYS_CREATE);
+        auto result = cache.build(m, sections);
+        ASSERT_TRUE(result);
+        EXPECT_FALSE(result.cache_hit);
+        EXPECT_EQ(test_io::call_f(m), 1013);
+    }
+
+    // The entry is written again
+    {
+        auto* m = engine->GetModule("test", AS_NAMESPACE_QUALIFIER asGM_ALWAYS_CREATE);
+        auto result = cache.build(m, sections);
+        ASSERT_TRUE(result);
+        EXPECT_TRUE(result.cache_hit);
+        EXPECT_EQ(test_io::call_f(m), 1013);
+    }
+}
@@ -0,0 +1,128 @@
+#include <asbind_test/framework.hpp>
+#include <asbind20/io/module_reloader.hpp>
+#include <filesystem>
+#include <fstream>
+
+namespace test_io
+{
+static int invoke_value(
+    asbind20::io::reloadable_function<int()>& f, AS_NAMESPACE_QUALIFIER asIScriptContext* ctx
+)
+{
+    auto result = f(ctx);
+    EXPECT_TRUE(asbind_test::result_has_value(result));
+    return result.value_or(-1);
+}
+
+class module_reloader_suite : public ::testing::Test
+{
+public:
+    void SetUp() override
+    {
+        m_dir = std::filesystem::temp_directory_path() / "asbind20_test_module_reloader";
+        std::filesystem::remove_all(m_dir);
+        std::filesystem::create_directories(m_dir);
+
+        m_engine = asbind20::make_script_engine();
+        asbind_test::setup_message_callback(m_engine);
+    }
+
+    void TearDown() override
+    {
+        m_engine.reset();
+
+        std::error_code ec;
+        std::filesystem::remove_all(m_dir, ec);
+    }
+
+    std::filesystem::path write_file(const std::string& name, std::string_view code)
+    {
+        auto p = m_dir / name;
+        std::ofstream ofs(p, std::ios_base::binary | std::ios_base::trunc);
+        ofs << code;
+        return p;
+    }
+
+    AS_NAMESPACE_QUALIFIER asIScriptEngine* get_engine() const noexcept
+    {
+        return m_engine.get();
+    }
+
+private:
+    std::filesystem::path m_dir;
+    asbind20::script_engine m_engine;
+};
+} // namespace test_io
+
+using ModuleReloader = test_io::module_reloader_suite;
+
+TEST_F(ModuleReloader, ReloadChangedModule)
+{
+    auto common = write_file("common.as", "int g() { return 1; }");
+    auto a = write_file("a.as", "int f() { return g(); }");
+    auto b = write_file("b.as", "int f() { return g() + 1; }");
+
+    asbind20::io::module_reloader reloader(get_engine());
+    ASSERT_GE(reloader.add_module("a", {common, a}), 0);
+    ASSERT_GE(reloader.add_module("b", {common, b}), 0);
+
+    auto handle_a = reloader.get_handle("a");
+    auto handle_b = reloader.get_handle("b");
+    ASSERT_TRUE(handle_a);
+    ASSERT_TRUE(handle_b);
+    EXPECT_EQ(handle_a.generation(), 1);
+    EXPECT_EQ(handle_b.generation(), 1);
+    EXPECT_FALSE(reloader.get_handle("c"));
+
+    asbind20::io::reloadable_function<int()> fa(handle_a, "int f()");
+    asbind20::io::reloadable_function<int()> fb(handle_b, "int f()");
+
+    asbind20::request_context ctx(get_engine());
+    EXPECT_EQ(test_io::invoke_value(fa, ctx), 1);
+    EXPECT_EQ(test_io::invoke_value(fb, ctx), 2);
+
+    // Nothing changed
+    EXPECT_EQ(reloader.poll(), 0);
+
+    // Only module "b" uses this file
+    write_file("b.as", "int f() { return g() + 1000; }");
+    EXPECT_EQ(reloader.poll(), 1);
+    EXPECT_EQ(handle_a.generation(), 1);
+    EXPECT_EQ(handle_b.generation(), 2);
+    EXPECT_EQ(test_io::invoke_value(fa, ctx), 1);
+    EXPECT_EQ(test_io::invoke_value(fb, ctx), 1001);
+    EXPECT_EQ(get_engine()->GetModule("b"), handle_b.get());
+
+    // Both modules use this file
+    write_file("common.as", "int g() { return 10; }");
+    EXPECT_EQ(reloader.poll(), 2);
+    EXPECT_EQ(test_io::invoke_value(fa, ctx), 10);
+    EXPECT_EQ(test_io::invoke_value(fb, ctx), 1010);
+}
+
+TEST_F(ModuleReloader, KeepModuleOnError)
+{
+    auto a = write_file("a.as", "int f() { return 42; }");
+
+    asbind20::io::module_reloader reloader(get_engine());
+    ASSERT_GE(reloader.add_module("a", {a}), 0);
+
+    auto handle = reloader.get_handle("a");
+    auto* old_module = handle.get();
+    asbind20::io::reloadable_function<int()> f(handle, "int f()");
+
+    asbind20::request_context ctx(get_engine());
+    EXPECT_EQ(test_io::invoke_value(f, ctx), 42);
+
+    write_file("a.as", "int f() { return not_exist(); }");
+    EXPECT_EQ(reloader.poll(), 0);
+    EXPECT_LT(handle.last_result(), 0);
+    EXPECT_EQ(handle.get(), old_module);
+    EXPECT_EQ(handle.generation(), 1);
+    EXPECT_EQ(test_io::invoke_value(f, ctx), 42);
+
+    write_file("a.as", "int f() { return 1013; }");
+    EXPECT_EQ(reloader.poll(), 1);
+    EXPECT_GE(handle.last_result(), 0);
+    EXPECT_EQ(test_io::invoke_value(f, ctx), 1013);
+}
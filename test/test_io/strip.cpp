@@ -0,0 +1,113 @@
+#include <asbind_test/framework.hpp>
+#include <asbind20/io/strip.hpp>
+
+TEST(TestIO, SaveByteCodeStripped)
+{
+    std::vector<std::byte> bc;
+
+    {
+        auto engine = asbind20::make_script_engine();
+        asbind_test::setup_message_callback(engine);
+
+        auto* m = engine->GetModule("test", AS_NAMESPACE_QUALIFIER asGM_ALWAYS_CREATE);
+        m->AddScriptSection(
+            "test.as",
+            "int used_var = 1000;\n"
+            "int unused_var = 42;\n"
+            "int init_helper() { return 10; }\n"
+            "int init_var = init_helper();\n"
+            "int side_effect_var = init_helper();\n"
+            "class foo { int get() { return helper_method(); } }\n"
+            "int helper_method() { return 3; }\n"
+            "int helper() { return used_var; }\n"
+            "int unused_1() { return unused_2() + unused_var; }\n"
+            "int unused_2() { return 2; }\n"
+            "int exported() { return 1; }\n"
+            "int f() { foo obj; return helper() + obj.get() + init_var; }"
+        );
+        ASSERT_GE(m->Build(), 0);
+
+        asbind20::io::strip_options opts;
+        opts.entry_points = {"int f()"};
+        opts.exports = {"int exported()"};
+        auto result = asbind20::save_byte_code_stripped(bc, m, opts);
+        ASSERT_TRUE(result);
+        EXPECT_FALSE(result.fallback);
+        EXPECT_EQ(result.removed_functions, 2);
+        EXPECT_EQ(result.removed_variables, 1);
+        EXPECT_LT(result.stripped_size, result.original_size);
+        EXPECT_EQ(result.stripped_size, bc.size());
+
+        // The original module is untouched
+        EXPECT_NE(m->GetFunctionByDecl("int unused_1()"), nullptr);
+
+        opts.entry_points = {"int not_exist()"};
+        std::vector<std::byte> dummy;
+        EXPECT_EQ(
+            asbind20::save_byte_code_stripped(dummy, m, opts).r,
+            AS_NAMESPACE_QUALIFIER asNO_FUNCTION
+        );
+    }
+
+    {
+        auto engine = asbind20::make_script_engine();
+        asbind_test::setup_message_callback(engine);
+
+        auto* m = engine->GetModule("test", AS_NAMESPACE_QUALIFIER asGM_ALWAYS_CREATE);
+        ASSERT_GE(asbind20::load_byte_code(bc, m).r, 0);
+
+        EXPECT_EQ(m->GetFunctionByDecl("int unused_1()"), nullptr);
+        EXPECT_EQ(m->GetFunctionByDecl("int unused_2()"), nullptr);
+        EXPECT_NE(m->GetFunctionByDecl("int exported()"), nullptr);
+        EXPECT_EQ(m->GetGlobalVarIndexByName("unused_var"), AS_NAMESPACE_QUALIFIER asNO_GLOBAL_VAR);
+        // Initializer is not constant
+        EXPECT_NE(m->GetGlobalVarIndexByName("side_effect_var"), AS_NAMESPACE_QUALIFIER asNO_GLOBAL_VAR);
+
+        asbind20::request_context ctx(engine);
+        auto result = asbind20::script_invoke<int>(ctx, m->GetFunctionByDecl("int f()"));
+        ASSERT_TRUE(asbind_test::result_has_value(result));
+        EXPECT_EQ(result.value(), 1013);
+    }
+}
+
+TEST(TestIO, SaveByteCodeStrippedImports)
+{
+    auto engine = asbind20::make_script_engine();
+    asbind_test::setup_message_callback(engine);
+
+    auto* lib = engine->GetModule("lib", AS_NAMESPACE_QUALIFIER asGM_ALWAYS_CREATE);
+    lib->AddScriptSection(
+        "lib.as",
+        "int lib_impl() { return 42; }\n"
+        "int lib_fn() { return lib_impl(); }\n"
+        "int unused() { return 1; }\n"
+        "int f() { return 0; }"
+    );
+    ASSERT_GE(lib->Build(), 0);
+
+    auto* user = engine->GetModule("user", AS_NAMESPACE_QUALIFIER asGM_ALWAYS_CREATE);
+    user->AddScriptSection(
+        "user.as",
+        "import int lib_fn() from \"lib\";\n"
+        "int g() { return lib_fn(); }"
+    );
+    ASSERT_GE(user->Build(), 0);
+
+    // The lib_fn() is kept without being listed in exports, because it is imported by another module
+    std::vector<std::byte> bc;
+    asbind20::io::strip_options opts;
+    opts.entry_points = {"int f()"};
+    auto result = asbind20::save_byte_code_stripped(bc, lib, opts);
+    ASSERT_TRUE(result);
+    EXPECT_FALSE(result.fallback);
+    EXPECT_EQ(result.removed_functions, 1);
+
+    user->Discard();
+    lib->Discard();
+
+    lib = engine->GetModule("lib", AS_NAMESPACE_QUALIFIER asGM_ALWAYS_CREATE);
+    ASSERT_GE(asbind20::load_byte_code(bc, lib).r, 0);
+    EXPECT_EQ(lib->GetFunctionByDecl("int unused()"), nullptr);
+    EXPECT_NE(lib->GetFunctionByDecl("int lib_fn()"), nullptr);
+    EXPECT_NE(lib->GetFunctionByDecl("int lib_impl()"), nullptr);
+}
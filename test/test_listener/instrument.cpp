@@ -0,0 +1,78 @@
+#include <asbind_test/framework.hpp>
+#include <asbind20/asbind.hpp>
+#include <asbind20/bind/instrument.hpp>
+#include "listener_suites.hpp"
+
+namespace test_listener
+{
+static int add_one(int val)
+{
+    return val + 1;
+}
+
+struct counter
+{
+    int val = 0;
+
+    int get() const
+    {
+        return val;
+    }
+};
+} // namespace test_listener
+
+using ListenerTest = test_listener::general_listener_suite;
+
+TEST_F(ListenerTest, InstrumentFunctions)
+{
+    using namespace asbind20;
+
+    EXPECT_EQ(call_stats_registry::get(engine), nullptr);
+
+    global<true, instrumenting_listener>(engine)
+        .function("int add_one(int val)", fp<&test_listener::add_one>);
+
+    value_class<test_listener::counter, true, instrumenting_listener>(engine, "counter")
+        .behaviours_by_traits()
+        .method("int get() const", fp<&test_listener::counter::get>);
+
+    auto* registry = call_stats_registry::get(engine);
+    ASSERT_NE(registry, nullptr);
+    EXPECT_EQ(registry->size(), 2);
+
+    auto* m = engine->GetModule("test", AS_NAMESPACE_QUALIFIER asGM_ALWAYS_CREATE);
+    m->AddScriptSection(
+        "test_instrument",
+        "int f()\n"
+        "{\n"
+        "    int sum = 0;\n"
+        "    for(int i = 0; i < 10; ++i)\n"
+        "        sum = add_one(sum);\n"
+        "    counter c;\n"
+        "    return sum + c.get();\n"
+        "}"
+    );
+    ASSERT_GE(m->Build(), 0);
+
+    {
+        request_context ctx(engine);
+        auto result = script_invoke<int>(ctx, m->GetFunctionByDecl("int f()"));
+        ASSERT_TRUE(asbind_test::result_has_value(result));
+        EXPECT_EQ(result.value(), 10);
+    }
+
+    auto add_one_stats = registry->find("int add_one(int)");
+    ASSERT_TRUE(add_one_stats.has_value());
+    EXPECT_EQ(add_one_stats->calls, 10);
+    EXPECT_GE(add_one_stats->total_ns, add_one_stats->max_ns);
+
+    auto get_stats = registry->find("int counter::get() const");
+    ASSERT_TRUE(get_stats.has_value());
+    EXPECT_EQ(get_stats->calls, 1);
+    EXPECT_EQ(registry->find(get_stats->func_id)->declaration, "int counter::get() const");
+
+    EXPECT_FALSE(registry->find("void not_exist()").has_value());
+
+    registry->reset();
+    EXPECT_EQ(registry->find("int add_one(int)")->calls, 0);
+}
@@ -0,0 +1,151 @@
+#include <asbind_test/framework.hpp>
+#include <asbind20/asbind.hpp>
+#include <asbind20/bind/manifest.hpp>
+#include "listener_suites.hpp"
+
+namespace test_listener
+{
+static int add_one(int val)
+{
+    return val + 1;
+}
+
+static int global_counter = 0;
+
+struct counter
+{
+    int val = 0;
+
+    int get() const
+    {
+        return val;
+    }
+
+    void increase()
+    {
+        ++val;
+    }
+};
+
+enum class color
+{
+    red,
+    green
+};
+
+template <bool UseGeneric>
+static void register_recorded(AS_NAMESPACE_QUALIFIER asIScriptEngine* engine)
+{
+    using namespace asbind20;
+    using asbind20::interface;
+
+    global<UseGeneric, recording_listener>(engine)
+        .function("int add_one(int val)", fp<&add_one>)
+        .property("int global_counter", global_counter)
+        .funcdef("int callback(int)");
+
+    value_class<counter, UseGeneric, recording_listener>(engine, "counter")
+        .behaviours_by_traits()
+        .method("int get() const", fp<&counter::get>)
+        .method("void increase()", fp<&counter::increase>)
+        .property("int val", &counter::val);
+
+    {
+        namespace_ ns(engine, "ns");
+        enum_<color, compat::script_enum_value_type, recording_listener>(engine, "color")
+            .value(color::red, "red")
+            .value(color::green, "green");
+    }
+
+    basic_interface<recording_listener>(engine, "intf")
+        .method("int f()");
+}
+
+static constexpr char manifest_test_script[] = R"AngelScript(
+class impl : intf
+{
+    int f() { return 1; }
+}
+
+int test()
+{
+    callback@ cb = @add_one;
+
+    counter c;
+    c.increase();
+    c.increase();
+    global_counter = c.get() + c.val;
+
+    impl i;
+    ns::color col = ns::color::green;
+    return cb(global_counter) + i.f() + int(col);
+}
+)AngelScript";
+
+template <bool UseGeneric>
+static void test_replay_manifest(AS_NAMESPACE_QUALIFIER asIScriptEngine* engine)
+{
+    using namespace asbind20;
+
+    EXPECT_EQ(interface_manifest::get(engine), nullptr);
+
+    register_recorded<UseGeneric>(engine);
+
+    auto* recorded = interface_manifest::get(engine);
+    ASSERT_NE(recorded, nullptr);
+    EXPECT_EQ(recorded->count(registration_kind::global_function), 1);
+    EXPECT_EQ(recorded->count(registration_kind::global_property), 1);
+    EXPECT_EQ(recorded->count(registration_kind::funcdef), 1);
+    EXPECT_EQ(recorded->count(registration_kind::object_type), 1);
+    EXPECT_GE(recorded->count(registration_kind::object_method), 2);
+    EXPECT_EQ(recorded->count(registration_kind::object_property), 1);
+    EXPECT_EQ(recorded->count(registration_kind::enum_), 1);
+    EXPECT_EQ(recorded->count(registration_kind::enum_value), 2);
+    EXPECT_EQ(recorded->count(registration_kind::interface_), 1);
+    EXPECT_EQ(recorded->count(registration_kind::interface_method), 1);
+
+    // The manifest can outlive the engine where it was recorded
+    interface_manifest manifest = *recorded;
+
+    for(int i = 0; i < 2; ++i)
+    {
+        SCOPED_TRACE("i = " + std::to_string(i));
+
+        auto sandbox = make_script_engine();
+        // Errors are expected when replaying twice
+        asbind_test::setup_message_callback(sandbox, false);
+
+        ASSERT_GE(manifest.replay(sandbox), 0);
+        EXPECT_STREQ(sandbox->GetDefaultNamespace(), "");
+        EXPECT_EQ(interface_manifest::get(sandbox), nullptr);
+
+        auto* m = sandbox->GetModule("test_manifest", AS_NAMESPACE_QUALIFIER asGM_ALWAYS_CREATE);
+        m->AddScriptSection("test_manifest", manifest_test_script);
+        ASSERT_GE(m->Build(), 0);
+
+        global_counter = 0;
+        request_context ctx(sandbox);
+        auto result = script_invoke<int>(ctx, m->GetFunctionByDecl("int test()"));
+        ASSERT_TRUE(asbind_test::result_has_value(result));
+        EXPECT_EQ(result.value(), 4 + 1 + 1 + 1);
+        EXPECT_EQ(global_counter, 4);
+
+        // Types have been registered
+        EXPECT_LT(manifest.replay(sandbox), 0);
+    }
+}
+} // namespace test_listener
+
+using ListenerTest = test_listener::general_listener_suite;
+
+TEST_F(ListenerTest, ReplayManifestGeneric)
+{
+    test_listener::test_replay_manifest<true>(engine);
+}
+
+TEST_F(ListenerTest, ReplayManifestNative)
+{
+    ASBIND_TEST_SKIP_IF_MAX_PORTABILITY();
+
+    test_listener::test_replay_manifest<false>(engine);
+}
@@ -0,0 +1,47 @@
+#include <gtest/gtest.h>
+#include <asbind_test/framework.hpp>
+#include <asbind20/operators.hpp>
+
+TEST(Detail, OperatorDeclarations)
+{
+    using namespace asbind20;
+    using namespace std::literals;
+
+    // Generated at compile time
+    EXPECT_EQ(
+        (detail::gen_binary_param_decl<detail::opAdd::name, true>(
+            detail::static_decl_t<util::fixed_string("int")>{}, param<const double&>
+        )),
+        "int opAdd(const double&in)const"sv
+    );
+    EXPECT_EQ(
+        (detail::gen_index_param_decl<false>(
+            detail::static_decl_t<util::fixed_string("float&")>{}, param<int>
+        )),
+        "float& opIndex(int)"sv
+    );
+    EXPECT_EQ(
+        (detail::gen_unary_decl<detail::opNeg::name, true>(
+            detail::static_decl_t<util::fixed_string("int")>{}
+        )),
+        "int opNeg()const"sv
+    );
+
+    // Fallback for declarations only known at runtime
+    EXPECT_EQ(
+        (detail::gen_binary_param_decl<detail::opSub::name + util::fixed_string("_r"), false>(
+            "my_type"sv, param<const double&>
+        )),
+        "my_type opSub_r(const double&in)"
+    );
+    EXPECT_EQ(
+        (detail::gen_binary_param_decl<detail::opSub::name, false>(
+            "my_type"sv, param<const double&>("const double&in")
+        )),
+        "my_type opSub(const double&in)"
+    );
+    EXPECT_EQ(
+        (detail::gen_unary_decl<detail::opNeg::name, true>("my_type"sv)),
+        "my_type opNeg()const"
+    );
+}
@@ -128,3 +128,30 @@ TEST_F(TestLoad, LoadFile)
     );
     check_result(f, 1013);
 }
+
+TEST_F(TestLoad, ReadFile)
+{
+    auto engine = get_engine();
+
+    using asbind20::io::read_file;
+    using asbind20::io::load_section;
+
+    asbind20::io::script_section section;
+    int r = read_file(section, "script/func.as");
+    EXPECT_GE(r, 0)
+        << "r = " << asbind20::to_string(AS_NAMESPACE_QUALIFIER asERetCodes(r));
+    EXPECT_EQ(section.name, "script/func.as");
+    EXPECT_FALSE(section.code.empty());
+
+    EXPECT_LT(read_file(section, "script/not_exist.as"), 0);
+
+    auto* m = engine->GetModule(
+        "TestLoad", AS_NAMESPACE_QUALIFIER asGM_ALWAYS_CREATE
+    );
+    r = load_section(m, section);
+    EXPECT_GE(r, 0)
+        << "r = " << asbind20::to_string(AS_NAMESPACE_QUALIFIER asERetCodes(r));
+    ASSERT_GE(m->Build(), 0);
+
+    check_result(get_func(m), 1013);
+}